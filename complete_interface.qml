@@ -4,6 +4,7 @@ import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Window 2.15
 import QtQuick.Shapes 1.15
+import "ui/components"
 
 ApplicationWindow {
     id: mainWindow
@@ -28,30 +29,34 @@ ApplicationWindow {
     property bool darkMode: true
     property real cpuUsage: 0.15
     
-    // Test data - will be empty initially
-    property var packets: []
+    // Packet rows come from the C++ PacketListModel; demoPackets is only used without a backend
+    property ListModel demoPackets: ListModel {}
+    readonly property var packetModel: typeof PacketListModel !== 'undefined' ? PacketListModel : demoPackets
     property var protocolLayers: []
-    property var hexDumpLines: []
+    // Hex/ASCII lines come from the C++ HexDumpModel; demoHexDump is only used without a backend
+    property ListModel demoHexDump: ListModel {}
+    readonly property var hexDumpModel: typeof HexDumpModel !== 'undefined' ? HexDumpModel : demoHexDump
     
     // Initialize with real backend connections
     Component.onCompleted: {
         console.log("🚀 PacketAnalyzer2026 initialized - connecting to real backend")
         
         // Connect to real backend signals if available
-        if (typeof PacketCaptureEngine !== 'undefined') {
-            console.log("✅ Real PacketCaptureEngine detected - connecting signals")
-            // Connect the C++ backend signals to QML handler functions
-            PacketCaptureEngine.packetCaptured.connect(onPacketCaptured)
-            PacketCaptureEngine.statisticsUpdated.connect(onStatisticsUpdated)
-            PacketCaptureEngine.captureStarted.connect(onCaptureStarted)
-            PacketCaptureEngine.captureStopped.connect(onCaptureStopped)
-            PacketCaptureEngine.captureError.connect(onCaptureError)
+        if (typeof PacketAnalyzerModel !== 'undefined') {
+            console.log("✅ Real PacketAnalyzerModel detected - connecting signals")
+            // Counters are notified at most once per frame; rows arrive through PacketListModel
+            PacketAnalyzerModel.packetCountChanged.connect(onAnalyzerCounters)
+            PacketAnalyzerModel.cpuUsageChanged.connect(onAnalyzerCounters)
+            PacketAnalyzerModel.bandwidthMbpsChanged.connect(onAnalyzerBandwidth)
+            PacketAnalyzerModel.captureStarted.connect(onCaptureStarted)
+            PacketAnalyzerModel.captureStopped.connect(onCaptureStopped)
+            PacketAnalyzerModel.captureError.connect(onCaptureError)
         } else {
             console.log("⚠️ No real backend - UI test mode with minimal data")
         }
         
         // Initialize with minimal test data for UI demonstration
-        packets = [
+        var demoRows = [
             {
                 number: "1",
                 time: "0.239396",
@@ -80,6 +85,9 @@ ApplicationWindow {
                 info: "Query AAAA cloudflare.com"
             }
         ]
+        for (var i = 0; i < demoRows.length; i++) {
+            demoPackets.append(demoRows[i])
+        }
         
         // Protocol tree data
         protocolLayers = [
@@ -105,27 +113,29 @@ ApplicationWindow {
         ]
         
         // Hex dump data
-        hexDumpLines = [
-            {
+        if (hexDumpModel === demoHexDump) {
+            demoHexDump.append({
                 offset: "0000",
-                hexBytes: ["ff", "ff", "ff", "ff", "ff", "ff", "00", "0c", "29", "68", "8c", "54", "08", "00", "45", "00"],
-                ascii: "......).h.T..E."
-            },
-            {
-                offset: "0010", 
-                hexBytes: ["00", "54", "00", "00", "40", "00", "40", "01", "c0", "a8", "01", "64", "08", "08", "08", "08"],
-                ascii: ".T..@.@.....d...."
-            }
-        ]
+                hex: "ff ff ff ff ff ff 00 0c  29 68 8c 54 08 00 45 00",
+                ascii: "........)h.T..E."
+            })
+            demoHexDump.append({
+                offset: "0010",
+                hex: "00 54 00 00 40 00 40 01  c0 a8 01 64 08 08 08 08",
+                ascii: ".T..@.@....d...."
+            })
+        }
     }
     
     // ✅ REAL BACKEND HANDLERS - Connect to C++ backend signals
     function onPacketCaptured(packetJson) {
-        console.log("📦 Real packet captured:", packetJson.protocol)
+        // With the C++ model present, rows arrive in batches through PacketListModel
+        if (packetModel !== demoPackets) {
+            return
+        }
         
-        // Add the real packet to our list
         var newPacket = {
-            number: (packets.length + 1).toString(),
+            number: (demoPackets.count + 1).toString(),
             time: packetJson.time || "0.000000",
             source: packetJson.source || "Unknown",
             dest: packetJson.dest || "Unknown", 
@@ -134,11 +144,10 @@ ApplicationWindow {
             info: packetJson.info || "No info"
         }
         
-        packets.push(newPacket)
-        if (packets.length > 1000) {
-            packets.shift() // Keep only last 1000 packets
+        demoPackets.append(newPacket)
+        if (demoPackets.count > 1000) {
+            demoPackets.remove(0) // Keep only last 1000 packets
         }
-        packetsChanged()
     }
     
     function onStatisticsUpdated(totalPackets, totalBytes, bandwidth, cpu) {
@@ -154,6 +163,18 @@ ApplicationWindow {
         console.log("📊 Real stats updated - Packets:", totalPackets, "Bandwidth:", bandwidth.toFixed(2), "MB/s")
     }
     
+    function onAnalyzerCounters() {
+        packetCount = PacketAnalyzerModel.packetCount
+        cpuUsage = PacketAnalyzerModel.cpuUsage
+    }
+    
+    function onAnalyzerBandwidth() {
+        bandwidthMbps = PacketAnalyzerModel.bandwidthMbps
+        if (bandwidthChart && bandwidthChart.addRealDataPoint) {
+            bandwidthChart.addRealDataPoint(bandwidthMbps)
+        }
+    }
+    
     function onCaptureStarted(interfaceName) {
         isCapturing = true
         console.log("🚀 Real capture started on interface:", interfaceName)
@@ -171,9 +192,9 @@ ApplicationWindow {
     
     // ✅ REAL CAPTURE CONTROL FOR BACKEND
     function startRealCapture() {
-        // This will call the C++ PacketCaptureEngine
-        if (typeof PacketCaptureEngine !== 'undefined') {
-            PacketCaptureEngine.startCapture("eth0", "")
+        // Starts the C++ capture on the model's current interface and filter
+        if (typeof PacketAnalyzerModel !== 'undefined') {
+            PacketAnalyzerModel.startCapture("", "")
         } else {
             console.log("🎯 Backend not available - UI test mode")
             isCapturing = true
@@ -181,8 +202,8 @@ ApplicationWindow {
     }
     
     function stopRealCapture() {
-        if (typeof PacketCaptureEngine !== 'undefined') {
-            PacketCaptureEngine.stopCapture()
+        if (typeof PacketAnalyzerModel !== 'undefined') {
+            PacketAnalyzerModel.stopCapture()
         } else {
             console.log("⏹ Backend not available - UI test mode")
             isCapturing = false
@@ -1172,7 +1193,7 @@ ApplicationWindow {
                 anchors.bottom: parent.bottom
                 clip: true
                 
-                model: packets
+                model: packetModel
                 currentIndex: selectedPacketIndex
                 
                 // Smooth scrollbar
@@ -1223,7 +1244,7 @@ ApplicationWindow {
                             
                             Text {
                                 anchors.centerIn: parent
-                                text: modelData.number
+                                text: model.number
                                 color: "#999999"
                                 font.pixelSize: 11
                                 font.family: "Consolas, Monaco, 'Courier New', monospace"
@@ -1238,7 +1259,7 @@ ApplicationWindow {
                             
                             Text {
                                 anchors.centerIn: parent
-                                text: modelData.time
+                                text: model.time
                                 color: "#00ff88"
                                 font.pixelSize: 11
                                 font.family: "Consolas"
@@ -1253,7 +1274,7 @@ ApplicationWindow {
                             
                             Text {
                                 anchors.centerIn: parent
-                                text: modelData.source
+                                text: model.source
                                 color: "#ffffff"
                                 font.pixelSize: 11
                                 font.family: "Consolas"
@@ -1268,7 +1289,7 @@ ApplicationWindow {
                             
                             Text {
                                 anchors.centerIn: parent
-                                text: modelData.dest
+                                text: model.dest
                                 color: "#ffffff"
                                 font.pixelSize: 11
                                 font.family: "Consolas"
@@ -1287,7 +1308,7 @@ ApplicationWindow {
                                 height: 22
                                 radius: 11
                                 color: {
-                                    switch(modelData.protocol) {
+                                    switch(model.protocol) {
                                         case "DNS": return "#ffc10730"
                                         case "HTTPS": return "#28a74530"
                                         case "QUIC": return "#66ff6630"
@@ -1299,9 +1320,9 @@ ApplicationWindow {
                                 
                                 Text {
                                     anchors.centerIn: parent
-                                    text: modelData.protocol
+                                    text: model.protocol
                                     color: {
-                                        switch(modelData.protocol) {
+                                        switch(model.protocol) {
                                             case "DNS": return "#ffc107"
                                             case "HTTPS": return "#28a745"
                                             case "QUIC": return "#66ff66"
@@ -1324,7 +1345,7 @@ ApplicationWindow {
                             
                             Text {
                                 anchors.centerIn: parent
-                                text: modelData.length
+                                text: model.length
                                 color: "#ff66b3"
                                 font.pixelSize: 11
                                 font.family: "Consolas"
@@ -1341,7 +1362,7 @@ ApplicationWindow {
                                 anchors.left: parent.left
                                 anchors.leftMargin: 10
                                 anchors.verticalCenter: parent.verticalCenter
-                                text: modelData.info
+                                text: model.info
                                 color: "#cccccc"
                                 font.pixelSize: 11
                                 elide: Text.ElideRight
@@ -1358,7 +1379,10 @@ ApplicationWindow {
                         onClicked: {
                             packetListView.currentIndex = index
                             selectedPacketIndex = index
-                            console.log("📦 Selected packet:", index, modelData.protocol)
+                            if (typeof PacketAnalyzerModel !== 'undefined') {
+                                PacketAnalyzerModel.selectPacket(index)
+                            }
+                            console.log("📦 Selected packet:", index, model.protocol)
                         }
                     }
                     
@@ -1413,11 +1437,19 @@ ApplicationWindow {
                         }
                     }
                     
-                    // Tree view with smooth animations
+                    // Field tree of the selected packet, dissected by the C++ backend
+                    ProtocolTreeView {
+                        width: parent.width
+                        height: parent.height - 35
+                        visible: typeof ProtocolTreeModel !== 'undefined'
+                    }
+                    
+                    // Demo tree with smooth animations, used without a backend
                     ScrollView {
                         width: parent.width
                         height: parent.height - 35
                         clip: true
+                        visible: typeof ProtocolTreeModel === 'undefined'
                         
                         Column {
                             width: parent.width
@@ -1541,49 +1573,36 @@ ApplicationWindow {
                         }
                     }
                     
-                    // Hex content with syntax highlighting
-                    ScrollView {
+                    // Hex content, only visible lines are formatted
+                    ListView {
+                        id: hexListView
                         width: parent.width
                         height: parent.height - 35
                         clip: true
+                        spacing: 1
+                        topMargin: 10
+                        leftMargin: 10
+                        model: hexDumpModel
+                        ScrollBar.vertical: ScrollBar {}
                         
-                        Column {
-                            width: parent.width
-                            spacing: 1
-                            padding: 10
+                        delegate: Row {
+                            spacing: 15
                             
-                            Repeater {
-                                model: hexDumpLines
-                                
-                                Row {
-                                    spacing: 15
-                                    
-                                    // Offset with different color
-                                    Text {
-                                        text: modelData.offset
-                                        color: "#999999"
-                                        font.pixelSize: 10
-                                        font.family: "Consolas"
-                                        width: 40
-                                    }
-                                    
-                                    // Hex bytes with color coding
-                                    Row {
-                                        spacing: 3
-                                        
-                                        Repeater {
-                                            model: modelData.hexBytes
-                                            
-                                            Text {
-                                                text: modelData
-                                                color: "#00ff88"
-                                                font.pixelSize: 10
-                                                font.family: "Consolas"
-                                                width: 20
-                                            }
-                                        }
-                                    }
-                                }
+                            // Offset with different color
+                            Text {
+                                text: model.offset
+                                color: "#999999"
+                                font.pixelSize: 10
+                                font.family: "Consolas"
+                                width: 40
+                            }
+                            
+                            // Hex bytes
+                            Text {
+                                text: model.hex
+                                color: "#00ff88"
+                                font.pixelSize: 10
+                                font.family: "Consolas"
                             }
                         }
                     }
@@ -1620,49 +1639,36 @@ ApplicationWindow {
                         }
                     }
                     
-                    // ASCII content with character highlighting
-                    ScrollView {
+                    // ASCII content, scrolled together with the hex pane
+                    ListView {
                         width: parent.width
                         height: parent.height - 35
                         clip: true
+                        spacing: 1
+                        topMargin: 10
+                        leftMargin: 10
+                        model: hexDumpModel
+                        contentY: hexListView.contentY
+                        interactive: false
                         
-                        Column {
-                            width: parent.width
-                            spacing: 1
-                            padding: 10
+                        delegate: Row {
+                            spacing: 8
                             
-                            Repeater {
-                                model: hexDumpLines
-                                
-                                Row {
-                                    spacing: 8
-                                    
-                                    // Line number
-                                    Text {
-                                        text: modelData.offset
-                                        color: "#666666"
-                                        font.pixelSize: 9
-                                        font.family: "Consolas"
-                                        width: 35
-                                    }
-                                    
-                                    // ASCII characters with individual coloring
-                                    Row {
-                                        spacing: 1
-                                        
-                                        Repeater {
-                                            model: modelData.ascii.length
-                                            
-                                            Text {
-                                                text: modelData.ascii.charAt(index) || "."
-                                                color: "#ffffff"
-                                                font.pixelSize: 10
-                                                font.family: "Consolas"
-                                                width: 8
-                                            }
-                                        }
-                                    }
-                                }
+                            // Line number
+                            Text {
+                                text: model.offset
+                                color: "#666666"
+                                font.pixelSize: 9
+                                font.family: "Consolas"
+                                width: 35
+                            }
+                            
+                            // One Text per line instead of one per character
+                            Text {
+                                text: model.ascii
+                                color: "#ffffff"
+                                font.pixelSize: 10
+                                font.family: "Consolas"
                             }
                         }
                     }
@@ -1822,7 +1828,7 @@ ApplicationWindow {
                             property int maxPoints: 12
                             property real maxBandwidth: 100
                             
-                            // Real bandwidth data comes from PacketCaptureEngine
+                            // Real bandwidth data comes from PacketAnalyzerModel
                             // No simulation needed - data updates via onStatisticsUpdated
                             
                             onPaint: {
@@ -2630,8 +2636,8 @@ ApplicationWindow {
                     Button {
                         text: "Apply Filter"
                         onClicked: {
-                            if (typeof PacketCaptureEngine !== 'undefined') {
-                                PacketCaptureEngine.setFilter(customFilterField.text)
+                            if (typeof PacketAnalyzerModel !== 'undefined') {
+                                PacketAnalyzerModel.setFilter(customFilterField.text)
                             }
                             console.log("🔍 Applied filter:", customFilterField.text)
                             filterDialog.close()
@@ -3035,8 +3041,8 @@ ApplicationWindow {
                         text: "Reset Stats"
                         onClicked: {
                             console.log("📊 Resetting statistics...")
-                            if (typeof PacketCaptureEngine !== 'undefined') {
-                                PacketCaptureEngine.clearPackets()
+                            if (typeof PacketListModel !== 'undefined') {
+                                PacketListModel.clear()
                             }
                         }
                         background: Rectangle {
@@ -3086,7 +3092,7 @@ ApplicationWindow {
     }  // ✅ CLOSES mainContent Rectangle
     
     // ✅ REAL BACKEND CONNECTION: No simulation needed
-    // The C++ PacketCaptureEngine will emit signals directly to QML handlers
+    // The C++ PacketAnalyzerModel will emit signals directly to QML handlers
     // Statistics and packet data will come from real network capture
     
     // Optional: Timer for UI updates only (not packet generation)
@@ -3097,7 +3103,7 @@ ApplicationWindow {
         onTriggered: {
             // Real backend provides all data through signals
             // This timer is only for UI refresh if needed
-            if (typeof PacketCaptureEngine !== 'undefined') {
+            if (typeof PacketAnalyzerModel !== 'undefined') {
                 // Real backend is active - all data comes from C++ signals
                 console.log("📊 Real backend active - packets:", packetCount, "bandwidth:", bandwidthMbps.toFixed(2), "Mbps")
             } else {
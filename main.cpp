@@ -10,6 +10,7 @@
 // Backend includes
 #include "src/database/DatabaseManager.h"
 #include "src/core/PacketCaptureEngine.h"
+#include "src/models/PacketAnalyzerModel.h"
 
 int main(int argc, char *argv[])
 {
@@ -37,9 +38,10 @@ int main(int argc, char *argv[])
         qDebug() << "✅ Database initialized successfully";
     }
     
-    // Create backend instances
-    PacketCaptureEngine captureEngine;
-    qDebug() << "✅ PacketCaptureEngine created";
+    // Create backend instances. The analyzer owns capture, the packet pipeline and every
+    // model QML shows (packet table, hex dump, protocol tree, stored sessions).
+    PacketAnalyzerModel analyzer;
+    qDebug() << "✅ PacketAnalyzerModel created";
     
     // Register QML types
     qmlRegisterSingletonType<DatabaseManager>("PacketAnalyzer", 1, 0, "DatabaseManager", 
@@ -65,8 +67,12 @@ int main(int argc, char *argv[])
     engine.addImportPath(":/");
     
     // ✅ EXPOSE REAL BACKEND INSTANCES TO QML
-    engine.rootContext()->setContextProperty("PacketCaptureEngine", &captureEngine);
+    engine.rootContext()->setContextProperty("PacketAnalyzerModel", &analyzer);
     engine.rootContext()->setContextProperty("DatabaseManager", &DatabaseManager::instance());
+    engine.rootContext()->setContextProperty("PacketListModel", analyzer.packets());
+    engine.rootContext()->setContextProperty("HexDumpModel", analyzer.hexDump());
+    engine.rootContext()->setContextProperty("ProtocolTreeModel", analyzer.protocolTree());
+    engine.rootContext()->setContextProperty("SessionPacketModel", analyzer.sessionPackets());
     engine.rootContext()->setContextProperty("applicationVersion", app.applicationVersion());
     engine.rootContext()->setContextProperty("applicationName", app.applicationName());
     
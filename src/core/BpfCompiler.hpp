@@ -0,0 +1,579 @@
+// BpfCompiler.hpp - Compile tcpdump-style filter expressions to classic BPF for SO_ATTACH_FILTER
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+namespace PacketAnalyzer2026::Core {
+
+// Same layout as struct sock_filter so a program can be handed to the kernel as-is
+struct BpfInstruction {
+    uint16_t code;
+    uint8_t jt;
+    uint8_t jf;
+    uint32_t k;
+};
+
+struct BpfProgram {
+    std::string expression;
+    std::vector<BpfInstruction> instructions;
+
+    bool acceptsEverything() const {
+        return instructions.size() == 1;
+    }
+};
+
+namespace Bpf {
+    // Classic BPF opcodes (linux/bpf_common.h), kept here so the compiler builds on every platform
+    constexpr uint16_t LD = 0x00, LDX = 0x01, ALU = 0x04, JMP = 0x05, RET = 0x06;
+    constexpr uint16_t W = 0x00, H = 0x08, B = 0x10;
+    constexpr uint16_t IMM = 0x00, ABS = 0x20, IND = 0x40, LEN = 0x80, MSH = 0xa0;
+    constexpr uint16_t AND = 0x50;
+    constexpr uint16_t JA = 0x00, JEQ = 0x10, JGT = 0x20, JGE = 0x30, JSET = 0x40;
+    constexpr uint16_t K = 0x00;
+
+    constexpr uint32_t ETHERTYPE_OFFSET = 12;
+    constexpr uint32_t L3_OFFSET = 14;
+    constexpr uint32_t ETHERTYPE_IPV4 = 0x0800;
+    constexpr uint32_t ETHERTYPE_IPV6 = 0x86dd;
+    constexpr uint32_t ETHERTYPE_ARP = 0x0806;
+}
+
+class BpfCompiler {
+private:
+    // A single load-and-compare; every filter primitive is a boolean tree of these
+    struct Test {
+        uint8_t size;           // Load width in bytes (1, 2, 4), or 0 for the packet length
+        bool indirect;          // Offset is relative to the IPv4 payload (X = header length)
+        uint32_t offset;
+        uint32_t mask;          // Applied before the comparison when non-zero
+        uint16_t op;            // Bpf::JEQ / JGT / JGE / JSET
+        uint32_t value;
+    };
+
+    struct Node {
+        enum class Kind { Test, And, Or, Not } kind;
+        Test test{};
+        std::unique_ptr<Node> left;
+        std::unique_ptr<Node> right;
+    };
+    using NodePtr = std::unique_ptr<Node>;
+
+    enum class Direction { Any, Src, Dst };
+    enum class Proto { Any, Ip, Ip6, Tcp, Udp, Icmp, Icmp6, Arp };
+
+    // Qualifiers of the previous primitive, reused for "port 80 or 443"
+    struct Qualifiers {
+        Proto proto = Proto::Any;
+        Direction dir = Direction::Any;
+        std::string type;
+    };
+
+    struct Label {
+        int position = -1;
+    };
+
+    struct PendingJump {
+        size_t instruction;
+        int trueLabel;
+        int falseLabel;         // -1 for an unconditional JA, whose target is trueLabel
+    };
+
+    std::vector<std::string> tokens_;
+    size_t pos_ = 0;
+    Qualifiers last_;
+    std::vector<BpfInstruction> code_;
+    std::vector<Label> labels_;
+    std::vector<PendingJump> jumps_;
+
+    // ---------- AST helpers ----------
+
+    static NodePtr test(uint8_t size, uint32_t offset, uint16_t op, uint32_t value, uint32_t mask = 0, bool indirect = false) {
+        auto node = std::make_unique<Node>();
+        node->kind = Node::Kind::Test;
+        node->test = Test{size, indirect, offset, mask, op, value};
+        return node;
+    }
+
+    static NodePtr binary(Node::Kind kind, NodePtr left, NodePtr right) {
+        if (!left) return right;
+        if (!right) return left;
+        auto node = std::make_unique<Node>();
+        node->kind = kind;
+        node->left = std::move(left);
+        node->right = std::move(right);
+        return node;
+    }
+
+    static NodePtr both(NodePtr a, NodePtr b) { return binary(Node::Kind::And, std::move(a), std::move(b)); }
+    static NodePtr either(NodePtr a, NodePtr b) { return binary(Node::Kind::Or, std::move(a), std::move(b)); }
+
+    static NodePtr negate(NodePtr a) {
+        auto node = std::make_unique<Node>();
+        node->kind = Node::Kind::Not;
+        node->left = std::move(a);
+        return node;
+    }
+
+    static NodePtr etherType(uint32_t type) {
+        return test(2, Bpf::ETHERTYPE_OFFSET, Bpf::JEQ, type);
+    }
+
+    static NodePtr ipv4Proto(uint32_t proto) {
+        return both(etherType(Bpf::ETHERTYPE_IPV4), test(1, Bpf::L3_OFFSET + 9, Bpf::JEQ, proto));
+    }
+
+    static NodePtr ipv6NextHeader(uint32_t proto) {
+        return both(etherType(Bpf::ETHERTYPE_IPV6), test(1, Bpf::L3_OFFSET + 6, Bpf::JEQ, proto));
+    }
+
+    static NodePtr protoNode(Proto proto) {
+        switch (proto) {
+            case Proto::Ip:    return etherType(Bpf::ETHERTYPE_IPV4);
+            case Proto::Ip6:   return etherType(Bpf::ETHERTYPE_IPV6);
+            case Proto::Arp:   return etherType(Bpf::ETHERTYPE_ARP);
+            case Proto::Tcp:   return either(ipv4Proto(6), ipv6NextHeader(6));
+            case Proto::Udp:   return either(ipv4Proto(17), ipv6NextHeader(17));
+            case Proto::Icmp:  return ipv4Proto(1);
+            case Proto::Icmp6: return ipv6NextHeader(58);
+            case Proto::Any:   break;
+        }
+        return nullptr;
+    }
+
+    // Port match for TCP/UDP; the IPv6 form assumes no extension headers, as libpcap does
+    static NodePtr portNode(Proto proto, Direction dir, uint32_t low, uint32_t high) {
+        auto portTest = [&](bool indirect, uint32_t offset) -> NodePtr {
+            if (low == high) {
+                return test(2, offset, Bpf::JEQ, low, 0, indirect);
+            }
+            return both(test(2, offset, Bpf::JGE, low, 0, indirect),
+                        negate(test(2, offset, Bpf::JGT, high, 0, indirect)));
+        };
+        auto ports = [&](bool indirect, uint32_t base) -> NodePtr {
+            if (dir == Direction::Src) return portTest(indirect, base);
+            if (dir == Direction::Dst) return portTest(indirect, base + 2);
+            return either(portTest(indirect, base), portTest(indirect, base + 2));
+        };
+
+        NodePtr v4Proto;
+        NodePtr v6Proto;
+        if (proto == Proto::Tcp || proto == Proto::Udp) {
+            uint32_t number = proto == Proto::Tcp ? 6 : 17;
+            v4Proto = test(1, Bpf::L3_OFFSET + 9, Bpf::JEQ, number);
+            v6Proto = test(1, Bpf::L3_OFFSET + 6, Bpf::JEQ, number);
+        } else {
+            v4Proto = either(test(1, Bpf::L3_OFFSET + 9, Bpf::JEQ, 6), test(1, Bpf::L3_OFFSET + 9, Bpf::JEQ, 17));
+            v6Proto = either(test(1, Bpf::L3_OFFSET + 6, Bpf::JEQ, 6), test(1, Bpf::L3_OFFSET + 6, Bpf::JEQ, 17));
+        }
+
+        NodePtr notFragment = negate(test(2, Bpf::L3_OFFSET + 6, Bpf::JSET, 0x1fff));
+        NodePtr v4 = both(both(both(etherType(Bpf::ETHERTYPE_IPV4), std::move(v4Proto)), std::move(notFragment)),
+                          ports(true, Bpf::L3_OFFSET));
+        NodePtr v6 = both(both(etherType(Bpf::ETHERTYPE_IPV6), std::move(v6Proto)), ports(false, Bpf::L3_OFFSET + 40));
+
+        if (proto == Proto::Ip) return v4;
+        if (proto == Proto::Ip6) return v6;
+        return either(std::move(v4), std::move(v6));
+    }
+
+    static NodePtr ipv4AddressNode(Direction dir, uint32_t address, uint32_t mask) {
+        if (mask == 0) {
+            return etherType(Bpf::ETHERTYPE_IPV4);
+        }
+        auto addrTest = [&](uint32_t offset) {
+            return test(4, offset, Bpf::JEQ, address & mask, mask == 0xffffffffu ? 0 : mask);
+        };
+        NodePtr match;
+        if (dir == Direction::Src) {
+            match = addrTest(Bpf::L3_OFFSET + 12);
+        } else if (dir == Direction::Dst) {
+            match = addrTest(Bpf::L3_OFFSET + 16);
+        } else {
+            match = either(addrTest(Bpf::L3_OFFSET + 12), addrTest(Bpf::L3_OFFSET + 16));
+        }
+        return both(etherType(Bpf::ETHERTYPE_IPV4), std::move(match));
+    }
+
+    static NodePtr ipv6AddressNode(Direction dir, const uint8_t* address, int prefix) {
+        auto addrTest = [&](uint32_t base) -> NodePtr {
+            NodePtr all;
+            for (int word = 0; word < 4 && prefix > word * 32; ++word) {
+                int bits = std::min(32, prefix - word * 32);
+                uint32_t mask = bits == 32 ? 0xffffffffu : ~((1u << (32 - bits)) - 1);
+                uint32_t value = (uint32_t(address[word * 4]) << 24) | (uint32_t(address[word * 4 + 1]) << 16) |
+                                 (uint32_t(address[word * 4 + 2]) << 8) | address[word * 4 + 3];
+                all = both(std::move(all), test(4, base + word * 4, Bpf::JEQ, value & mask, bits == 32 ? 0 : mask));
+            }
+            return all;
+        };
+        NodePtr match;
+        if (dir == Direction::Src) {
+            match = addrTest(Bpf::L3_OFFSET + 8);
+        } else if (dir == Direction::Dst) {
+            match = addrTest(Bpf::L3_OFFSET + 24);
+        } else {
+            match = either(addrTest(Bpf::L3_OFFSET + 8), addrTest(Bpf::L3_OFFSET + 24));
+        }
+        return both(etherType(Bpf::ETHERTYPE_IPV6), std::move(match));
+    }
+
+    // ---------- Parser ----------
+
+    [[noreturn]] void fail(const std::string& message) const {
+        std::string near = pos_ < tokens_.size() ? "'" + tokens_[pos_] + "'" : "end of expression";
+        throw std::invalid_argument("BPF filter: " + message + " near " + near);
+    }
+
+    void tokenize(const std::string& expression) {
+        tokens_.clear();
+        size_t i = 0;
+        while (i < expression.size()) {
+            char c = expression[i];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                ++i;
+            } else if (c == '(' || c == ')' || c == '!') {
+                tokens_.emplace_back(1, c);
+                ++i;
+            } else if ((c == '&' || c == '|') && i + 1 < expression.size() && expression[i + 1] == c) {
+                tokens_.emplace_back(c == '&' ? "and" : "or");
+                i += 2;
+            } else {
+                size_t start = i;
+                while (i < expression.size() && !std::isspace(static_cast<unsigned char>(expression[i])) &&
+                       expression[i] != '(' && expression[i] != ')' && expression[i] != '!' &&
+                       expression[i] != '&' && expression[i] != '|') {
+                    ++i;
+                }
+                std::string token = expression.substr(start, i - start);
+                for (auto& ch : token) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+                tokens_.push_back(token);
+            }
+        }
+    }
+
+    bool peek(const char* token) const {
+        return pos_ < tokens_.size() && tokens_[pos_] == token;
+    }
+
+    bool accept(const char* token) {
+        if (peek(token)) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    std::string next(const char* what) {
+        if (pos_ >= tokens_.size()) fail(std::string("expected ") + what);
+        return tokens_[pos_++];
+    }
+
+    NodePtr parseOr() {
+        NodePtr node = parseAnd();
+        while (accept("or")) {
+            node = either(std::move(node), parseAnd());
+        }
+        return node;
+    }
+
+    NodePtr parseAnd() {
+        NodePtr node = parseUnary();
+        while (accept("and")) {
+            node = both(std::move(node), parseUnary());
+        }
+        return node;
+    }
+
+    NodePtr parseUnary() {
+        if (accept("not") || accept("!")) {
+            return negate(parseUnary());
+        }
+        if (accept("(")) {
+            NodePtr node = parseOr();
+            if (!accept(")")) fail("expected ')'");
+            return node;
+        }
+        return parsePrimitive();
+    }
+
+    static bool isValueToken(const std::string& token) {
+        return !token.empty() && (std::isdigit(static_cast<unsigned char>(token[0])) || token.find(':') != std::string::npos);
+    }
+
+    NodePtr parsePrimitive() {
+        if (pos_ >= tokens_.size()) fail("expected a filter primitive");
+
+        // A bare value continues the previous primitive: "port 80 or 443"
+        if (isValueToken(tokens_[pos_]) && !last_.type.empty()) {
+            return buildTyped(last_, next("value"));
+        }
+
+        Qualifiers q;
+        static const struct { const char* name; Proto proto; } protos[] = {
+            {"ip", Proto::Ip}, {"ip6", Proto::Ip6}, {"tcp", Proto::Tcp}, {"udp", Proto::Udp},
+            {"icmp", Proto::Icmp}, {"icmp6", Proto::Icmp6}, {"arp", Proto::Arp}
+        };
+        for (const auto& p : protos) {
+            if (accept(p.name)) {
+                q.proto = p.proto;
+                break;
+            }
+        }
+
+        if (accept("src")) {
+            q.dir = Direction::Src;
+        } else if (accept("dst")) {
+            q.dir = Direction::Dst;
+        }
+
+        if (peek("port") || peek("portrange") || peek("host") || peek("net")) {
+            q.type = next("qualifier");
+            last_ = q;
+            return buildTyped(q, next("value"));
+        }
+
+        if (q.dir != Direction::Any) {
+            // "src 10.0.0.1" is shorthand for "src host 10.0.0.1"
+            q.type = "host";
+            last_ = q;
+            return buildTyped(q, next("address"));
+        }
+
+        if (accept("less")) {
+            return negate(test(0, 0, Bpf::JGT, parseNumber(next("length"), 0xffffffffu)));
+        }
+        if (accept("greater")) {
+            return test(0, 0, Bpf::JGE, parseNumber(next("length"), 0xffffffffu));
+        }
+
+        if (q.proto == Proto::Any) fail("unknown filter primitive");
+        last_ = Qualifiers{};
+        return protoNode(q.proto);
+    }
+
+    uint32_t parseNumber(const std::string& token, uint32_t max) const {
+        if (token.empty() || !std::all_of(token.begin(), token.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+            fail("expected a number");
+        }
+        unsigned long value = std::stoul(token);
+        if (value > max) fail("number out of range");
+        return static_cast<uint32_t>(value);
+    }
+
+    NodePtr buildTyped(const Qualifiers& q, const std::string& value) {
+        if (q.type == "port" || q.type == "portrange") {
+            if (q.proto != Proto::Any && q.proto != Proto::Tcp && q.proto != Proto::Udp &&
+                q.proto != Proto::Ip && q.proto != Proto::Ip6) {
+                fail("port qualifier needs tcp, udp, ip or ip6");
+            }
+            uint32_t low = 0, high = 0;
+            if (q.type == "portrange") {
+                size_t dash = value.find('-');
+                if (dash == std::string::npos) fail("portrange expects low-high");
+                low = parseNumber(value.substr(0, dash), 65535);
+                high = parseNumber(value.substr(dash + 1), 65535);
+                if (low > high) std::swap(low, high);
+            } else {
+                low = high = parseNumber(value, 65535);
+            }
+            return portNode(q.proto, q.dir, low, high);
+        }
+
+        // host / net
+        std::string address = value;
+        int prefix = -1;
+        size_t slash = value.find('/');
+        if (slash != std::string::npos) {
+            address = value.substr(0, slash);
+            prefix = static_cast<int>(parseNumber(value.substr(slash + 1), 128));
+        }
+
+        // "net 10" / "net 192.168.1" mean an octet-aligned IPv4 prefix, as in tcpdump
+        if (q.type == "net" && address.find(':') == std::string::npos) {
+            int octets = 1 + static_cast<int>(std::count(address.begin(), address.end(), '.'));
+            if (prefix < 0) prefix = 8 * std::min(octets, 4);
+            for (; octets < 4; ++octets) address += ".0";
+        }
+
+        uint8_t bytes[16];
+        if (inet_pton(AF_INET, address.c_str(), bytes) == 1) {
+            if (prefix > 32) fail("IPv4 prefix longer than 32 bits");
+            if (prefix < 0) prefix = 32;
+            uint32_t addr = (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | bytes[3];
+            uint32_t mask = prefix == 0 ? 0 : ~((1ull << (32 - prefix)) - 1);
+            return ipv4AddressNode(q.dir, addr, mask);
+        }
+        if (inet_pton(AF_INET6, address.c_str(), bytes) == 1) {
+            return ipv6AddressNode(q.dir, bytes, prefix < 0 ? 128 : prefix);
+        }
+        fail("expected an IPv4 or IPv6 address (host names are not resolved)");
+    }
+
+    // ---------- Code generation ----------
+
+    int newLabel() {
+        labels_.push_back(Label{});
+        return static_cast<int>(labels_.size() - 1);
+    }
+
+    void place(int label) {
+        labels_[label].position = static_cast<int>(code_.size());
+    }
+
+    void emitOp(uint16_t code, uint32_t k) {
+        code_.push_back(BpfInstruction{code, 0, 0, k});
+    }
+
+    void emitJump(uint16_t op, uint32_t k, int trueLabel, int falseLabel) {
+        jumps_.push_back(PendingJump{code_.size(), trueLabel, falseLabel});
+        code_.push_back(BpfInstruction{static_cast<uint16_t>(Bpf::JMP | op | Bpf::K), 0, 0, k});
+    }
+
+    void generate(const Node* node, int trueLabel, int falseLabel) {
+        switch (node->kind) {
+            case Node::Kind::Not:
+                generate(node->left.get(), falseLabel, trueLabel);
+                break;
+            case Node::Kind::And: {
+                int mid = newLabel();
+                generate(node->left.get(), mid, falseLabel);
+                place(mid);
+                generate(node->right.get(), trueLabel, falseLabel);
+                break;
+            }
+            case Node::Kind::Or: {
+                int mid = newLabel();
+                generate(node->left.get(), trueLabel, mid);
+                place(mid);
+                generate(node->right.get(), trueLabel, falseLabel);
+                break;
+            }
+            case Node::Kind::Test: {
+                const Test& t = node->test;
+                const uint16_t width = t.size == 1 ? Bpf::B : t.size == 2 ? Bpf::H : Bpf::W;
+                if (t.size == 0) {
+                    emitOp(Bpf::LD | Bpf::W | Bpf::LEN, 0);
+                } else if (t.indirect) {
+                    emitOp(Bpf::LDX | Bpf::B | Bpf::MSH, Bpf::L3_OFFSET);
+                    emitOp(Bpf::LD | width | Bpf::IND, t.offset);
+                } else {
+                    emitOp(Bpf::LD | width | Bpf::ABS, t.offset);
+                }
+                if (t.mask != 0) {
+                    emitOp(Bpf::ALU | Bpf::AND | Bpf::K, t.mask);
+                }
+                emitJump(t.op, t.value, trueLabel, falseLabel);
+                break;
+            }
+        }
+    }
+
+    // Inserts "ja target" right after instruction `after` and returns a label on it
+    int insertTrampoline(size_t after, int target) {
+        const size_t at = after + 1;
+        for (auto& label : labels_) {
+            if (label.position >= static_cast<int>(at)) ++label.position;
+        }
+        for (auto& jump : jumps_) {
+            if (jump.instruction >= at) ++jump.instruction;
+        }
+        code_.insert(code_.begin() + static_cast<std::ptrdiff_t>(at),
+                     BpfInstruction{static_cast<uint16_t>(Bpf::JMP | Bpf::JA | Bpf::K), 0, 0, 0});
+        jumps_.push_back(PendingJump{at, target, -1});
+        int label = newLabel();
+        labels_[label].position = static_cast<int>(at);
+        return label;
+    }
+
+    long distance(const PendingJump& jump, int label) const {
+        return static_cast<long>(labels_[label].position) - static_cast<long>(jump.instruction) - 1;
+    }
+
+    // Conditional offsets are 8 bits; a branch that lands further away is routed through a JA
+    // trampoline placed right after it, whose 32-bit offset reaches anywhere (as libpcap does).
+    // Every insertion can push other branches out of range, so repeat until none are.
+    void resolveJumps() {
+        bool inserted = true;
+        while (inserted) {
+            inserted = false;
+            for (size_t i = 0; i < jumps_.size() && !inserted; ++i) {
+                PendingJump& jump = jumps_[i];
+                if (jump.falseLabel < 0) continue;
+                if (distance(jump, jump.trueLabel) > 255) {
+                    int target = jump.trueLabel;
+                    jumps_[i].trueLabel = insertTrampoline(jump.instruction, target);
+                    inserted = true;
+                } else if (distance(jump, jump.falseLabel) > 255) {
+                    int target = jump.falseLabel;
+                    jumps_[i].falseLabel = insertTrampoline(jump.instruction, target);
+                    inserted = true;
+                }
+            }
+        }
+
+        for (const auto& jump : jumps_) {
+            BpfInstruction& insn = code_[jump.instruction];
+            if (jump.falseLabel < 0) {
+                insn.k = static_cast<uint32_t>(distance(jump, jump.trueLabel));
+            } else {
+                insn.jt = static_cast<uint8_t>(distance(jump, jump.trueLabel));
+                insn.jf = static_cast<uint8_t>(distance(jump, jump.falseLabel));
+            }
+        }
+    }
+
+    BpfProgram build(const std::string& expression, uint32_t snapLength) {
+        tokenize(expression);
+        pos_ = 0;
+        last_ = Qualifiers{};
+
+        BpfProgram program;
+        program.expression = expression;
+
+        if (tokens_.empty()) {
+            program.instructions.push_back(BpfInstruction{static_cast<uint16_t>(Bpf::RET | Bpf::K), 0, 0, snapLength});
+            return program;
+        }
+
+        NodePtr root = parseOr();
+        if (pos_ != tokens_.size()) fail("unexpected token");
+
+        int accept = newLabel();
+        int reject = newLabel();
+        generate(root.get(), accept, reject);
+        place(accept);
+        emitOp(Bpf::RET | Bpf::K, snapLength);
+        place(reject);
+        emitOp(Bpf::RET | Bpf::K, 0);
+        resolveJumps();
+
+        if (code_.size() > 4096) {
+            throw std::invalid_argument("BPF filter: program exceeds the 4096 instruction limit");
+        }
+
+        program.instructions = std::move(code_);
+        return program;
+    }
+
+public:
+    // Throws std::invalid_argument with the offending token on syntax errors
+    static BpfProgram compile(const std::string& expression, uint32_t snapLength = 262144) {
+        BpfCompiler compiler;
+        return compiler.build(expression, snapLength);
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,61 @@
+// ByteView.hpp - Non-owning view of a byte range inside a capture or reassembly buffer
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace PacketAnalyzer2026::Core {
+
+// C++17 stand-in for std::span<const uint8_t>. Views never own memory: they are only
+// valid while the buffer they point into (ring block, PacketBatch, stream buffer) is.
+struct ByteView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    constexpr ByteView() = default;
+    constexpr ByteView(const uint8_t* bytes, size_t length) : data(bytes), size(length) {}
+
+    constexpr bool empty() const { return size == 0; }
+    constexpr const uint8_t* begin() const { return data; }
+    constexpr const uint8_t* end() const { return data + size; }
+    constexpr uint8_t operator[](size_t index) const { return data[index]; }
+
+    // Clamped like std::string_view::substr, but never throws
+    constexpr ByteView subview(size_t offset, size_t length = SIZE_MAX) const {
+        if (offset >= size) return ByteView(data + size, 0);
+        return ByteView(data + offset, std::min(length, size - offset));
+    }
+
+    bool startsWith(std::string_view prefix) const {
+        return size >= prefix.size() && std::memcmp(data, prefix.data(), prefix.size()) == 0;
+    }
+
+    // Offset of the first occurrence of needle, or SIZE_MAX
+    size_t find(std::string_view needle) const {
+        if (needle.empty()) return 0;
+        if (needle.size() > size) return SIZE_MAX;
+        const uint8_t first = static_cast<uint8_t>(needle[0]);
+        const uint8_t* last = data + size - needle.size();
+        for (const uint8_t* p = data; p <= last; ++p) {
+            p = static_cast<const uint8_t*>(std::memchr(p, first, static_cast<size_t>(last - p) + 1));
+            if (!p) break;
+            if (std::memcmp(p, needle.data(), needle.size()) == 0) {
+                return static_cast<size_t>(p - data);
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    bool contains(std::string_view needle) const {
+        return find(needle) != SIZE_MAX;
+    }
+
+    std::string_view asText() const {
+        return std::string_view(reinterpret_cast<const char*>(data), size);
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,100 @@
+// ChecksumValidator.hpp - IPv4 header and TCP/UDP checksum checks that recognize capture-side offload
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ByteView.hpp"
+#include "../performance/InternetChecksum.hpp"
+
+namespace PacketAnalyzer2026::Core {
+
+enum class ChecksumStatus : uint8_t {
+    Unchecked,          // Not TCP/UDP/IPv4, truncated, or a fragment
+    Valid,
+    Offloaded,          // Left for the NIC to fill in; the bytes on the wire will differ
+    Bad
+};
+
+// What the capture socket reported about the packet's checksum (tpacket3_hdr::tp_status)
+enum CaptureChecksumState : uint8_t {
+    CAPTURE_CHECKSUM_UNKNOWN = 0,
+    CAPTURE_CHECKSUM_VERIFIED,      // TP_STATUS_CSUM_VALID: the NIC or stack already checked it
+    CAPTURE_CHECKSUM_NOT_READY      // TP_STATUS_CSUMNOTREADY: outgoing, checksum offloaded
+};
+
+// Checks the innermost IP packet of a frame. Outgoing packets captured on the sending host
+// often carry no final TCP/UDP checksum because the NIC computes it later. The kernel says
+// so when it can; otherwise such a packet is recognized by a checksum field that holds the
+// pseudo-header sum the stack leaves for the NIC (CHECKSUM_PARTIAL), and is reported as
+// Offloaded rather than Bad.
+class ChecksumValidator {
+private:
+    using Sum = Performance::InternetChecksum;
+
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+    static uint16_t pseudoHeader(const uint8_t* addresses, size_t addressBytes, uint8_t protocol, uint32_t length) {
+        uint16_t sum = Sum::sum(addresses, addressBytes);
+        sum = Sum::add(sum, protocol);
+        sum = Sum::add(sum, static_cast<uint16_t>(length >> 16));
+        return Sum::add(sum, static_cast<uint16_t>(length));
+    }
+
+    static ChecksumStatus transport(const uint8_t* l4, size_t length, uint8_t protocol, uint16_t pseudo,
+                                    bool ipv4, CaptureChecksumState state) {
+        const size_t checksumOffset = protocol == 6 ? 16 : 6;
+        if (length < checksumOffset + 2) return ChecksumStatus::Unchecked;
+
+        const uint16_t stored = read16(l4 + checksumOffset);
+        if (protocol == 17 && stored == 0) {
+            // IPv4 UDP may omit it; IPv6 requires it (RFC 8200 8.1)
+            return ipv4 ? ChecksumStatus::Valid : ChecksumStatus::Bad;
+        }
+        if (Sum::verify(l4, length, pseudo) == 0xFFFF) return ChecksumStatus::Valid;
+        if (state == CAPTURE_CHECKSUM_NOT_READY) return ChecksumStatus::Offloaded;
+
+        // CHECKSUM_PARTIAL leaves the folded pseudo-header sum (sometimes complemented) in place
+        if (stored == pseudo || stored == static_cast<uint16_t>(~pseudo)) return ChecksumStatus::Offloaded;
+        return ChecksumStatus::Bad;
+    }
+
+public:
+    // frame holds the whole captured packet with the innermost IP header at l3Offset
+    static ChecksumStatus validate(ByteView frame, size_t l3Offset, CaptureChecksumState state) {
+        if (state == CAPTURE_CHECKSUM_VERIFIED) return ChecksumStatus::Valid;
+        if (frame.size < l3Offset + 20) return ChecksumStatus::Unchecked;
+
+        const uint8_t* ip = frame.data + l3Offset;
+        const size_t available = frame.size - l3Offset;
+
+        if ((ip[0] >> 4) == 4) {
+            const size_t ihl = static_cast<size_t>(ip[0] & 0x0F) * 4;
+            const size_t totalLength = read16(ip + 2);
+            if (ihl < 20 || ihl > available) return ChecksumStatus::Unchecked;
+            if (Sum::verify(ip, ihl) != 0xFFFF) return ChecksumStatus::Bad;
+
+            // Segmentation offload can leave totalLength at 0 on captured super-packets
+            if (totalLength < ihl || totalLength > available) return ChecksumStatus::Unchecked;
+            if ((read16(ip + 6) & 0x3FFF) != 0) return ChecksumStatus::Valid;
+            if (ip[9] != 6 && ip[9] != 17) return ChecksumStatus::Valid;
+
+            const uint32_t l4Length = static_cast<uint32_t>(totalLength - ihl);
+            return transport(ip + ihl, l4Length, ip[9], pseudoHeader(ip + 12, 8, ip[9], l4Length), true, state);
+        }
+
+        if ((ip[0] >> 4) == 6 && available >= 40) {
+            const uint8_t nextHeader = ip[6];
+            const size_t payloadLength = read16(ip + 4);
+            if ((nextHeader != 6 && nextHeader != 17) || payloadLength == 0 || 40 + payloadLength > available) {
+                return ChecksumStatus::Unchecked;
+            }
+            const uint32_t l4Length = static_cast<uint32_t>(payloadLength);
+            return transport(ip + 40, l4Length, nextHeader, pseudoHeader(ip + 8, 32, nextHeader, l4Length), false, state);
+        }
+
+        return ChecksumStatus::Unchecked;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
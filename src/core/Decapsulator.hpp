@@ -0,0 +1,220 @@
+// Decapsulator.hpp - Peels VLAN, QinQ, MPLS, GRE, VXLAN, GENEVE and IP-in-IP layers down to the inner IP header
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ByteView.hpp"
+
+namespace PacketAnalyzer2026::Core {
+
+enum EncapsulationLayer : uint8_t {
+    ENCAP_NONE = 0,
+    ENCAP_VLAN,             // 802.1Q C-tag
+    ENCAP_QINQ,             // 802.1ad S-tag (or the legacy 0x9100)
+    ENCAP_MPLS,             // One entry for the whole label stack
+    ENCAP_GRE,
+    ENCAP_VXLAN,
+    ENCAP_GENEVE,
+    ENCAP_IP_IN_IP          // IPv4 or IPv6 carried directly in IPv4 or IPv6
+};
+
+// Encapsulation layers packed 4 bits each, outermost first in the low bits. Fits the
+// 32-bit PacketRecord column; deeper stacks keep their first eight layers.
+struct EncapsulationStack {
+    static constexpr uint8_t MAX_LAYERS = 8;
+
+    uint32_t packed = 0;
+    uint8_t depth = 0;
+
+    void push(EncapsulationLayer layer) {
+        if (depth < MAX_LAYERS) packed |= static_cast<uint32_t>(layer) << (4 * depth);
+        depth++;
+    }
+
+    static EncapsulationLayer layer(uint32_t packed, uint8_t index) {
+        return static_cast<EncapsulationLayer>((packed >> (4 * index)) & 0x0F);
+    }
+
+    static const char* name(EncapsulationLayer layer) {
+        switch (layer) {
+            case ENCAP_VLAN:     return "VLAN";
+            case ENCAP_QINQ:     return "QinQ";
+            case ENCAP_MPLS:     return "MPLS";
+            case ENCAP_GRE:      return "GRE";
+            case ENCAP_VXLAN:    return "VXLAN";
+            case ENCAP_GENEVE:   return "GENEVE";
+            case ENCAP_IP_IN_IP: return "IP-in-IP";
+            default:             return "";
+        }
+    }
+};
+
+// Innermost network layer of a frame. l3Offset points at the IP header (or whatever
+// etherType names) of the innermost packet, so everything downstream parses overlay
+// traffic exactly like native traffic.
+struct Decapsulated {
+    uint16_t etherType = 0;
+    uint16_t l3Offset = 0;
+    EncapsulationStack stack;
+};
+
+// One forward pass over the header bytes with no allocation and no copies. Plain
+// Ethernet + IP costs one etherType switch and one protocol check on the IP header.
+// Tunnels inside IP fragments are not peeled; the fragment is reported as the outer IP.
+class Decapsulator {
+private:
+    static constexpr uint16_t VXLAN_PORT = 4789;
+    static constexpr uint16_t GENEVE_PORT = 6081;
+    static constexpr uint16_t TRANSPARENT_ETHERNET = 0x6558;
+    static constexpr uint8_t MAX_DEPTH = 16;
+
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+    // Inner Ethernet header at offset (VXLAN, GENEVE, GRE bridging, MPLS pseudowires)
+    static bool ethernet(ByteView frame, size_t& offset, uint16_t& etherType) {
+        if (frame.size < offset + 14) return false;
+        etherType = read16(frame.data + offset + 12);
+        offset += 14;
+        return true;
+    }
+
+    // Tunnel payload after an IP header whose protocol is ipProtocol and whose payload starts
+    // at offset; false when the IP packet is the innermost layer
+    static bool tunnel(ByteView frame, uint8_t ipProtocol, size_t& offset, uint16_t& etherType,
+                       EncapsulationStack& stack) {
+        const uint8_t* p = frame.data + offset;
+        const size_t available = frame.size - offset;
+
+        switch (ipProtocol) {
+            case 4:
+            case 41:
+                stack.push(ENCAP_IP_IN_IP);
+                etherType = ipProtocol == 4 ? 0x0800 : 0x86DD;
+                return true;
+
+            case 47: {
+                if (available < 4 || (p[1] & 0x07) != 0) return false;      // GRE version 0 only
+                const size_t length = 4 + ((p[0] & 0x80) ? 4 : 0) + ((p[0] & 0x20) ? 4 : 0) + ((p[0] & 0x10) ? 4 : 0);
+                if (available < length) return false;
+                const uint16_t protocol = read16(p + 2);
+                offset += length;
+                stack.push(ENCAP_GRE);
+                if (protocol == TRANSPARENT_ETHERNET) return ethernet(frame, offset, etherType);
+                etherType = protocol;
+                return true;
+            }
+
+            case 17: {
+                if (available < 16) return false;
+                const uint16_t destPort = read16(p + 2);
+                if (destPort == VXLAN_PORT) {
+                    if ((p[8] & 0x08) == 0) return false;       // VNI not valid
+                    offset += 16;
+                    stack.push(ENCAP_VXLAN);
+                    return ethernet(frame, offset, etherType);
+                }
+                if (destPort == GENEVE_PORT) {
+                    if ((p[8] >> 6) != 0) return false;
+                    const size_t length = 8 + 8 + static_cast<size_t>(p[8] & 0x3F) * 4;
+                    if (available < length) return false;
+                    const uint16_t protocol = read16(p + 10);
+                    offset += length;
+                    stack.push(ENCAP_GENEVE);
+                    if (protocol == TRANSPARENT_ETHERNET) return ethernet(frame, offset, etherType);
+                    etherType = protocol;
+                    return true;
+                }
+                return false;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+public:
+    // frame starts with an Ethernet header. A layer whose header is cut short ends the
+    // walk: the result then describes the last layer that was complete.
+    static Decapsulated peel(ByteView frame) {
+        Decapsulated result;
+        if (frame.size < 14) return result;
+
+        size_t offset = 14;
+        uint16_t etherType = read16(frame.data + 12);
+
+        for (uint8_t depth = 0; depth < MAX_DEPTH; ++depth) {
+            const size_t layerStart = offset;
+            const uint16_t layerType = etherType;
+            const EncapsulationStack outer = result.stack;
+            bool next = false;
+
+            switch (etherType) {
+                case 0x8100:
+                case 0x88A8:
+                case 0x9100:
+                    if (frame.size < offset + 4) break;
+                    result.stack.push(etherType == 0x8100 ? ENCAP_VLAN : ENCAP_QINQ);
+                    etherType = read16(frame.data + offset + 2);
+                    offset += 4;
+                    next = true;
+                    break;
+
+                case 0x8847:
+                case 0x8848: {
+                    // Label entries until the bottom-of-stack bit, then guess the payload from
+                    // its first nibble the way every analyzer has to (RFC 4385)
+                    while (frame.size >= offset + 4 && !(frame.data[offset + 2] & 0x01)) offset += 4;
+                    if (frame.size < offset + 5) break;
+                    offset += 4;
+                    result.stack.push(ENCAP_MPLS);
+                    const uint8_t nibble = frame.data[offset] >> 4;
+                    if (nibble == 4) {
+                        etherType = 0x0800;
+                        next = true;
+                    } else if (nibble == 6) {
+                        etherType = 0x86DD;
+                        next = true;
+                    } else if (nibble == 0) {
+                        offset += 4;            // Pseudowire control word, then Ethernet
+                        next = ethernet(frame, offset, etherType);
+                    }
+                    break;
+                }
+
+                case 0x0800: {
+                    if (frame.size < offset + 20) break;
+                    const uint8_t* ip = frame.data + offset;
+                    const size_t ihl = static_cast<size_t>(ip[0] & 0x0F) * 4;
+                    if (ihl < 20 || frame.size < offset + ihl || (read16(ip + 6) & 0x3FFF) != 0) break;
+                    offset += ihl;
+                    next = tunnel(frame, ip[9], offset, etherType, result.stack);
+                    break;
+                }
+
+                case 0x86DD:
+                    if (frame.size < offset + 40) break;
+                    offset += 40;
+                    next = tunnel(frame, frame.data[layerStart + 6], offset, etherType, result.stack);
+                    break;
+
+                default:
+                    break;
+            }
+
+            if (!next) {
+                // Nothing (more) to peel: this layer is the innermost
+                result.stack = outer;
+                result.etherType = layerType;
+                result.l3Offset = static_cast<uint16_t>(layerStart);
+                return result;
+            }
+        }
+
+        result.etherType = etherType;
+        result.l3Offset = static_cast<uint16_t>(offset);
+        return result;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
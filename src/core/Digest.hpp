@@ -0,0 +1,210 @@
+// Digest.hpp - Streaming MD5 and SHA-256 for fingerprint hashes (not for security)
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace PacketAnalyzer2026::Core {
+
+namespace DigestDetail {
+
+inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+inline void toHex(const uint8_t* bytes, size_t length, char* out) {
+    static constexpr char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < length; ++i) {
+        out[2 * i] = digits[bytes[i] >> 4];
+        out[2 * i + 1] = digits[bytes[i] & 0x0F];
+    }
+    out[2 * length] = '\0';
+}
+
+// Shared 64-byte block buffering; Derived provides compress(const uint8_t*) and the length encoding
+template<typename Derived>
+class BlockHash {
+protected:
+    uint8_t block_[64];
+    size_t used_ = 0;
+    uint64_t totalBytes_ = 0;
+
+    void pad(bool bigEndianLength) {
+        const uint64_t bits = totalBytes_ * 8;
+        const uint8_t marker = 0x80;
+        update(&marker, 1);
+        const uint8_t zero = 0;
+        while (used_ != 56) update(&zero, 1);
+        uint8_t length[8];
+        for (int i = 0; i < 8; ++i) {
+            length[i] = static_cast<uint8_t>(bigEndianLength ? bits >> (56 - 8 * i) : bits >> (8 * i));
+        }
+        update(length, 8);
+    }
+
+public:
+    void update(const uint8_t* data, size_t length) {
+        totalBytes_ += length;
+        while (length > 0) {
+            if (used_ == 0 && length >= 64) {
+                static_cast<Derived*>(this)->compress(data);
+                data += 64;
+                length -= 64;
+                continue;
+            }
+            const size_t take = length < 64 - used_ ? length : 64 - used_;
+            std::memcpy(block_ + used_, data, take);
+            used_ += take;
+            data += take;
+            length -= take;
+            if (used_ == 64) {
+                static_cast<Derived*>(this)->compress(block_);
+                used_ = 0;
+            }
+        }
+    }
+
+    void update(const char* text, size_t length) {
+        update(reinterpret_cast<const uint8_t*>(text), length);
+    }
+};
+
+} // namespace DigestDetail
+
+// RFC 1321. JA3 fingerprints are MD5 by definition.
+class Md5 : public DigestDetail::BlockHash<Md5> {
+private:
+    friend class DigestDetail::BlockHash<Md5>;
+    uint32_t state_[4] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476 };
+
+    void compress(const uint8_t* block) {
+        static constexpr uint32_t K[64] = {
+            0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+            0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+            0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+            0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+            0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+            0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+            0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+            0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+        };
+        static constexpr int S[16] = { 7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21 };
+
+        uint32_t m[16];
+        for (int i = 0; i < 16; ++i) {
+            m[i] = static_cast<uint32_t>(block[4 * i]) | (static_cast<uint32_t>(block[4 * i + 1]) << 8) |
+                   (static_cast<uint32_t>(block[4 * i + 2]) << 16) | (static_cast<uint32_t>(block[4 * i + 3]) << 24);
+        }
+
+        uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t f;
+            int g;
+            if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+            else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) & 15; }
+            else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) & 15; }
+            else             { f = c ^ (b | ~d);       g = (7 * i) & 15; }
+            const uint32_t rotated = DigestDetail::rotl(a + f + K[i] + m[g], S[(i >> 4) * 4 + (i & 3)]);
+            a = d;
+            d = c;
+            c = b;
+            b = b + rotated;
+        }
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+    }
+
+public:
+    static constexpr size_t DIGEST_SIZE = 16;
+
+    void finish(uint8_t out[DIGEST_SIZE]) {
+        pad(false);
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) out[4 * i + j] = static_cast<uint8_t>(state_[i] >> (8 * j));
+        }
+    }
+
+    // 32 lowercase hex digits plus the terminator
+    static void hex(const char* text, size_t length, char out[2 * DIGEST_SIZE + 1]) {
+        Md5 md5;
+        md5.update(text, length);
+        uint8_t digest[DIGEST_SIZE];
+        md5.finish(digest);
+        DigestDetail::toHex(digest, DIGEST_SIZE, out);
+    }
+};
+
+// FIPS 180-4. JA4 uses truncated SHA-256 hashes.
+class Sha256 : public DigestDetail::BlockHash<Sha256> {
+private:
+    friend class DigestDetail::BlockHash<Sha256>;
+    uint32_t state_[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+    void compress(const uint8_t* block) {
+        static constexpr uint32_t K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        using DigestDetail::rotr;
+
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) | (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+                   (static_cast<uint32_t>(block[4 * i + 2]) << 8) | block[4 * i + 3];
+        }
+        for (int i = 16; i < 64; ++i) {
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+        for (int i = 0; i < 64; ++i) {
+            const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+        state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+    }
+
+public:
+    static constexpr size_t DIGEST_SIZE = 32;
+
+    void finish(uint8_t out[DIGEST_SIZE]) {
+        pad(true);
+        for (int i = 0; i < 8; ++i) {
+            for (int j = 0; j < 4; ++j) out[4 * i + j] = static_cast<uint8_t>(state_[i] >> (24 - 8 * j));
+        }
+    }
+
+    // First hexDigits lowercase hex digits of the digest plus the terminator
+    static void hexPrefix(const char* text, size_t length, size_t hexDigits, char* out) {
+        Sha256 sha;
+        sha.update(text, length);
+        uint8_t digest[DIGEST_SIZE];
+        sha.finish(digest);
+        char full[2 * DIGEST_SIZE + 1];
+        DigestDetail::toHex(digest, DIGEST_SIZE, full);
+        std::memcpy(out, full, hexDigits);
+        out[hexDigits] = '\0';
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,225 @@
+// FanoutCapture.hpp - PACKET_FANOUT multi-worker capture with one TPACKET_V3 ring per worker
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <iostream>
+
+#include "TPacketV3Capture.hpp"
+#include "../performance/ThreadPool.hpp"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace PacketAnalyzer2026::Core {
+
+struct FanoutConfig {
+    size_t workers = 2;
+    FanoutMode mode = FanoutMode::Hash;
+    uint16_t groupId = 0;             // 0 picks a per-process id
+    RingConfig ring;                  // Applied to every worker's ring
+};
+
+struct FanoutWorkerStatistics {
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t drops;
+    uint64_t queueFreezes;      // tp_freeze_q_cnt: times the kernel froze the ring queue
+    bool failed;
+};
+
+struct FanoutStatistics {
+    uint64_t totalPackets = 0;
+    uint64_t totalBytes = 0;
+    uint64_t totalDrops = 0;
+    uint64_t totalQueueFreezes = 0;
+    std::vector<FanoutWorkerStatistics> workers;
+};
+
+class FanoutCapture {
+private:
+    // Counters are written by one capture thread and read by the statistics timer
+    struct alignas(64) WorkerState {
+        TPacketV3Capture ring;
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> drops{0};
+        std::atomic<uint64_t> queueFreezes{0};
+        std::atomic<bool> failed{false};
+        std::string error;
+    };
+
+    std::vector<std::unique_ptr<WorkerState>> workers_;
+    std::vector<std::future<void>> running_;
+    std::atomic<bool> stopRequested_{false};
+    FanoutConfig config_;
+    std::string filter_;
+    FanoutStatistics final_;          // Taken by stop() just before the sockets close
+
+    static uint16_t defaultGroupId() {
+#ifdef __linux__
+        return static_cast<uint16_t>(getpid() & 0xFFFF);
+#else
+        return 1;
+#endif
+    }
+
+public:
+    FanoutCapture() = default;
+    FanoutCapture(const FanoutCapture&) = delete;
+    FanoutCapture& operator=(const FanoutCapture&) = delete;
+
+    ~FanoutCapture() {
+        stop();
+    }
+
+    // Opens one ring per worker and joins them all into the same fanout group
+    void open(const std::string& interfaceName, const FanoutConfig& config) {
+        stop();
+        final_ = FanoutStatistics{};
+
+        if (config.workers == 0) {
+            throw std::invalid_argument("Fanout capture needs at least one worker");
+        }
+
+        config_ = config;
+        if (config_.groupId == 0) {
+            config_.groupId = defaultGroupId();
+        }
+
+        BpfProgram program = BpfCompiler::compile(filter_);
+        for (size_t i = 0; i < config_.workers; ++i) {
+            auto worker = std::make_unique<WorkerState>();
+            worker->ring.open(interfaceName, config_.ring, &program);
+            worker->ring.joinFanout(config_.groupId, config_.mode);
+            workers_.push_back(std::move(worker));
+        }
+
+        std::cout << "🔀 Fanout group " << config_.groupId << " on '" << interfaceName << "' with "
+                  << workers_.size() << " workers" << std::endl;
+    }
+
+    // Runs each worker's ring loop on its own capture pool thread. onFrame(workerIndex, frame)
+    // is called on that worker's thread only, so per-worker state in the handler needs no locking.
+    template<typename FrameHandler>
+    void start(Performance::ThreadPool& capturePool, FrameHandler onFrame) {
+        start(capturePool, std::move(onFrame), [](size_t) {});
+    }
+
+    // As above; onPoll(workerIndex) also runs on the worker's thread after every ring wait,
+    // at least every RingConfig::pollTimeoutMs, e.g. to flush work held back for batching
+    template<typename FrameHandler, typename PollHandler>
+    void start(Performance::ThreadPool& capturePool, FrameHandler onFrame, PollHandler onPoll) {
+        if (workers_.empty()) {
+            throw std::logic_error("FanoutCapture::start() called before open()");
+        }
+        if (capturePool.threadCount() < workers_.size()) {
+            throw std::invalid_argument("Capture pool has fewer threads than fanout workers");
+        }
+
+        stopRequested_ = false;
+        running_.clear();
+
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            WorkerState* worker = workers_[i].get();
+            running_.push_back(capturePool.enqueue([this, worker, i, onFrame, onPoll]() mutable {
+                try {
+                    worker->ring.run(stopRequested_, [&](const CapturedFrame& frame) {
+                        worker->packets.fetch_add(1, std::memory_order_relaxed);
+                        worker->bytes.fetch_add(frame.wireLength, std::memory_order_relaxed);
+                        onFrame(i, frame);
+                    }, [&] { onPoll(i); });
+                } catch (const std::exception& e) {
+                    worker->error = e.what();
+                    worker->failed = true;
+                    std::cout << "❌ Fanout worker " << i << " stopped: " << e.what() << std::endl;
+                }
+            }));
+        }
+    }
+
+    // Compiles once and swaps the filter on every worker socket without stopping the rings.
+    // Each socket switches atomically; throws std::invalid_argument before touching any socket.
+    // When stopped, only the expression is kept for the next open().
+    void setFilter(const std::string& expression) {
+        BpfProgram program = BpfCompiler::compile(expression);
+        for (auto& worker : workers_) {
+            worker->ring.attachFilter(program);
+        }
+        filter_ = expression;
+    }
+
+    const std::string& filter() const {
+        return filter_;
+    }
+
+    // Joins the workers and closes every ring. The counters as of the close stay readable
+    // through statistics() until the next open().
+    void stop() {
+        stopRequested_ = true;
+        for (auto& task : running_) {
+            if (task.valid()) {
+                task.wait();
+            }
+        }
+        running_.clear();
+
+        if (!workers_.empty()) {
+            final_ = statistics();
+            workers_.clear();
+        }
+    }
+
+    bool isRunning() const {
+        return !running_.empty() && !stopRequested_.load();
+    }
+
+    size_t workerCount() const {
+        return workers_.size();
+    }
+
+    const FanoutConfig& config() const {
+        return config_;
+    }
+
+    // Per-worker counters plus their roll-up, in the shape statisticsUpdated reports
+    FanoutStatistics statistics() {
+        if (workers_.empty()) {
+            return final_;
+        }
+
+        FanoutStatistics stats;
+        stats.workers.reserve(workers_.size());
+
+        for (auto& worker : workers_) {
+            // Kernel counters reset on every read, so both deltas are folded in here
+            const KernelCounters kernel = worker->ring.readKernelCounters();
+            worker->drops.fetch_add(kernel.drops, std::memory_order_relaxed);
+            worker->queueFreezes.fetch_add(kernel.queueFreezes, std::memory_order_relaxed);
+
+            FanoutWorkerStatistics ws{
+                worker->packets.load(std::memory_order_relaxed),
+                worker->bytes.load(std::memory_order_relaxed),
+                worker->drops.load(std::memory_order_relaxed),
+                worker->queueFreezes.load(std::memory_order_relaxed),
+                worker->failed.load()
+            };
+            stats.totalPackets += ws.packets;
+            stats.totalBytes += ws.bytes;
+            stats.totalDrops += ws.drops;
+            stats.totalQueueFreezes += ws.queueFreezes;
+            stats.workers.push_back(ws);
+        }
+
+        return stats;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,58 @@
+// FlowKey.hpp - Canonical bidirectional 5-tuple shared by the per-flow tables
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace PacketAnalyzer2026::Core {
+
+// Bidirectional 5-tuple in canonical order: endpoint A is the lower (address, port) pair,
+// so both directions of a connection map to the same key
+struct FlowKey {
+    uint8_t addressA[16];           // IPv4 addresses use the first 4 bytes
+    uint8_t addressB[16];
+    uint16_t portA;
+    uint16_t portB;
+    uint8_t ipVersion;
+    uint8_t protocol;
+    uint16_t reserved;
+
+    bool operator==(const FlowKey& other) const {
+        return std::memcmp(this, &other, sizeof(FlowKey)) == 0;
+    }
+
+    // Fills the key from one packet's endpoints; returns the direction (0: A to B, 1: B to A)
+    static uint8_t make(FlowKey& key, uint8_t ipVersion, uint8_t protocol,
+                        const uint8_t* source, uint16_t sourcePort,
+                        const uint8_t* dest, uint16_t destPort) {
+        std::memset(&key, 0, sizeof(key));
+        const size_t addressLength = ipVersion == 6 ? 16 : 4;
+        int order = std::memcmp(source, dest, addressLength);
+        const bool swapped = order > 0 || (order == 0 && sourcePort > destPort);
+
+        std::memcpy(key.addressA, swapped ? dest : source, addressLength);
+        std::memcpy(key.addressB, swapped ? source : dest, addressLength);
+        key.portA = swapped ? destPort : sourcePort;
+        key.portB = swapped ? sourcePort : destPort;
+        key.ipVersion = ipVersion;
+        key.protocol = protocol;
+        return swapped ? 1 : 0;
+    }
+};
+
+static_assert(sizeof(FlowKey) == 40, "FlowKey is hashed and compared as raw bytes");
+
+struct FlowKeyHash {
+    size_t operator()(const FlowKey& key) const {
+        // FNV-1a over the raw key
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&key);
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t i = 0; i < sizeof(FlowKey); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,301 @@
+// FlowShardedDispatcher.hpp - Flow-affinity dispatch of packet batches to per-worker shards with merged aggregates
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "FlowKey.hpp"
+#include "FlowTable.hpp"
+#include "PacketRecord.hpp"
+#include "../performance/ThreadPool.hpp"
+
+namespace PacketAnalyzer2026::Core {
+
+struct FlowShardLoad {
+    uint64_t batches;
+    uint64_t packets;
+};
+
+struct FlowShardSummary {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t activeFlows = 0;
+    FlowTableStatistics table;
+
+    void merge(const FlowShardSummary& other) {
+        packets += other.packets;
+        bytes += other.bytes;
+        activeFlows += other.activeFlows;
+        table.created += other.table.created;
+        table.expired += other.table.expired;
+        table.rejected += other.table.rejected;
+        table.rehashes += other.table.rehashes;
+    }
+};
+
+// Basic shard: one FlowTable per worker. Heavier per-flow state plugs into the dispatcher
+// the same way; see Protocols::FlowAnalysisShard for the TLS, DNS and HTTP trackers.
+class FlowTableShard {
+private:
+    FlowTable table_;
+    FlowShardSummary totals_;
+
+public:
+    using Aggregate = FlowShardSummary;
+
+    explicit FlowTableShard(const FlowTableConfig& config = FlowTableConfig{}) : table_(config) {}
+
+    void onPackets(const PacketBatch& batch, const std::vector<uint32_t>& records) {
+        uint64_t latest = 0;
+        for (uint32_t index : records) {
+            const PacketRecord& record = batch.records[index];
+            if (record.ipVersion == 0) continue;
+
+            FlowKey key;
+            const uint8_t direction = FlowKey::make(key, record.ipVersion, record.ipProtocol,
+                                                    record.sourceAddress, record.sourcePort,
+                                                    record.destAddress, record.destPort);
+            table_.update(key, direction, record.wireLength, record.timestampNs, record.tcpFlags, record.appProtocol);
+            totals_.packets++;
+            totals_.bytes += record.wireLength;
+            latest = std::max(latest, record.timestampNs);
+        }
+        table_.advance(latest);
+    }
+
+    Aggregate snapshot() const {
+        Aggregate summary = totals_;
+        summary.activeFlows = table_.size();
+        summary.table = table_.statistics();
+        return summary;
+    }
+
+    const FlowTable& table() const { return table_; }
+};
+
+// Splits each packet batch by FlowTable::shardOf over the canonical 5-tuple and runs every
+// part on the pool worker that owns that shard (ThreadPool::submitTo). Both directions of
+// a flow hash alike, so a flow's state lives on exactly one worker and shards need no
+// locks; with one producer per flow, a shard sees that flow's packets in capture order.
+// Batches are shared, not copied: each worker gets the batch pointer and its record indices.
+//
+// Shard requirements:
+//   using Aggregate = ...;                      // default-constructible, void merge(const Aggregate&)
+//   void onPackets(const PacketBatch&, const std::vector<uint32_t>& recordIndices);
+//   Aggregate snapshot() const;
+//
+// Each worker publishes its shard's snapshot at most once per publish interval, after a
+// batch; merged() folds the latest snapshots together, so readers never touch live shard
+// state and totals lag by at most one interval (publishNow() forces a fresh round).
+template<typename Shard>
+class FlowShardedDispatcher {
+public:
+    using Aggregate = typename Shard::Aggregate;
+
+private:
+    struct alignas(64) Slot {
+        std::unique_ptr<Shard> shard;
+        std::chrono::steady_clock::duration publishInterval;
+        std::chrono::steady_clock::time_point lastPublish;     // Owning worker only
+        std::atomic<size_t> pending{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> packets{0};
+
+        mutable std::mutex publishedMutex;
+        Aggregate published{};
+
+        struct PendingGuard {
+            std::atomic<size_t>& pending;
+            ~PendingGuard() { pending.fetch_sub(1, std::memory_order_release); }
+        };
+
+        void publish() {
+            Aggregate snapshot = shard->snapshot();
+            std::lock_guard<std::mutex> lock(publishedMutex);
+            published = std::move(snapshot);
+        }
+
+        void process(const PacketBatch& batch, const std::vector<uint32_t>& records) {
+            PendingGuard guard{ pending };
+            shard->onPackets(batch, records);
+            batches.fetch_add(1, std::memory_order_relaxed);
+            packets.fetch_add(records.size(), std::memory_order_relaxed);
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastPublish >= publishInterval) {
+                publish();
+                lastPublish = now;
+            }
+        }
+    };
+
+    Performance::ThreadPool& pool_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+
+    template<typename F>
+    void post(size_t index, F&& work) {
+        Slot& slot = *slots_[index];
+        slot.pending.fetch_add(1, std::memory_order_relaxed);
+        try {
+            pool_.submitTo(index, std::forward<F>(work));
+        } catch (...) {
+            slot.pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void requireExternalThread(const char* operation) const {
+        if (pool_.currentWorkerIndex() != SIZE_MAX) {
+            throw std::logic_error(std::string(operation) + " would wait on its own pool from a worker thread");
+        }
+    }
+
+    void waitIdle() const {
+        for (const auto& slot : slots_) {
+            while (slot->pending.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    // One shard per pool thread. makeShard(index) returns std::unique_ptr<Shard> and is called on
+    // the worker that will own the shard, possibly concurrently, so its memory is first touched
+    // (and on NUMA hosts placed) by that worker.
+    template<typename Factory>
+    FlowShardedDispatcher(Performance::ThreadPool& pool, Factory makeShard,
+                          std::chrono::milliseconds publishInterval = std::chrono::milliseconds(500))
+        : pool_(pool) {
+        requireExternalThread("FlowShardedDispatcher construction");
+        for (size_t i = 0; i < pool_.threadCount(); ++i) {
+            auto slot = std::make_unique<Slot>();
+            slot->publishInterval = publishInterval;
+            slots_.push_back(std::move(slot));
+        }
+        try {
+            for (size_t i = 0; i < slots_.size(); ++i) {
+                Slot* slot = slots_[i].get();
+                post(i, [slot, &makeShard, i] {
+                    typename Slot::PendingGuard guard{ slot->pending };
+                    slot->shard = makeShard(i);
+                    slot->lastPublish = std::chrono::steady_clock::now();
+                });
+            }
+        } catch (...) {
+            waitIdle();                 // Posted tasks still reference makeShard and the slots
+            throw;
+        }
+        waitIdle();
+        for (const auto& slot : slots_) {
+            if (!slot->shard) {
+                throw std::runtime_error("Failed to create flow shard on pool '" + pool_.getName() + "'");
+            }
+        }
+    }
+
+    FlowShardedDispatcher(const FlowShardedDispatcher&) = delete;
+    FlowShardedDispatcher& operator=(const FlowShardedDispatcher&) = delete;
+
+    // Tasks hold raw slot pointers; they must finish before the shards go away
+    ~FlowShardedDispatcher() {
+        waitIdle();
+    }
+
+    static size_t shardOf(const PacketRecord& record, size_t shards) {
+        if (record.ipVersion == 0) return 0;        // Non-IP frames have no flow; shard 0 takes them all
+        FlowKey key;
+        FlowKey::make(key, record.ipVersion, record.ipProtocol, record.sourceAddress, record.sourcePort,
+                      record.destAddress, record.destPort);
+        return FlowTable::shardOf(key, shards);
+    }
+
+    // Safe from any thread, including pool workers. One task per shard that has packets.
+    void dispatch(const PacketBatchPtr& batch) {
+        if (!batch || batch->empty()) return;
+
+        const size_t shards = slots_.size();
+        std::vector<std::vector<uint32_t>> parts(shards);
+        for (auto& part : parts) {
+            part.reserve(batch->size() / shards + 16);
+        }
+        for (uint32_t i = 0; i < batch->records.size(); ++i) {
+            parts[shardOf(batch->records[i], shards)].push_back(i);
+        }
+
+        for (size_t s = 0; s < shards; ++s) {
+            if (parts[s].empty()) continue;
+            Slot* slot = slots_[s].get();
+            // Slot pointer, batch pointer and index vector fit a Task without allocating
+            post(s, [slot, batch, records = std::move(parts[s])] {
+                slot->process(*batch, records);
+            });
+        }
+    }
+
+    // Asks every worker to publish now, behind the batches already queued to it
+    void publishNow() {
+        for (size_t s = 0; s < slots_.size(); ++s) {
+            Slot* slot = slots_[s].get();
+            post(s, [slot] {
+                typename Slot::PendingGuard guard{ slot->pending };
+                slot->publish();
+            });
+        }
+    }
+
+    // Runs work on a pool worker once every batch dispatched before this call has been
+    // processed, without blocking the caller: each shard counts down behind its queue and the
+    // last one runs work. Safe from pool workers, so a feeding stage can pace itself with it.
+    template<typename F>
+    void afterQueued(F work) {
+        auto remaining = std::make_shared<std::atomic<size_t>>(slots_.size());
+        auto then = std::make_shared<F>(std::move(work));
+        for (size_t s = 0; s < slots_.size(); ++s) {
+            Slot* slot = slots_[s].get();
+            post(s, [slot, remaining, then] {
+                typename Slot::PendingGuard guard{ slot->pending };
+                if (remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) (*then)();
+            });
+        }
+    }
+
+    // Blocks until every queued batch has been processed; not from one of the pool's workers
+    void drain() {
+        requireExternalThread("FlowShardedDispatcher::drain()");
+        waitIdle();
+    }
+
+    // Latest published snapshots of all shards, merged
+    Aggregate merged() const {
+        Aggregate total{};
+        for (const auto& slot : slots_) {
+            std::lock_guard<std::mutex> lock(slot->publishedMutex);
+            total.merge(slot->published);
+        }
+        return total;
+    }
+
+    // Per-shard work counts, to check that the hash spreads flows evenly
+    std::vector<FlowShardLoad> load() const {
+        std::vector<FlowShardLoad> shards;
+        shards.reserve(slots_.size());
+        for (const auto& slot : slots_) {
+            shards.push_back({ slot->batches.load(std::memory_order_relaxed),
+                               slot->packets.load(std::memory_order_relaxed) });
+        }
+        return shards;
+    }
+
+    size_t shardCount() const { return slots_.size(); }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,439 @@
+// FlowTable.hpp - Open-addressing 5-tuple flow table with cache-line entries and timer-wheel expiry
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "FlowKey.hpp"
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define PA2026_FLOW_CRC32C_SSE42 1
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define PA2026_FLOW_CRC32C_ARM 1
+#endif
+
+namespace PacketAnalyzer2026::Core {
+
+enum FlowEntryFlags : uint8_t {
+    FLOW_TCP_SYN = 1 << 0,          // Handshake seen, so endpoint A/B roles are known
+    FLOW_TCP_CLOSED = 1 << 1,       // FIN or RST seen; expires after the short close timeout
+    FLOW_INSPECTED = 1 << 2         // Payload inspection (e.g. the TLS handshake) finished; skip per-packet parsing
+};
+
+// One cache line per flow: a probe touches exactly one line per slot it inspects
+struct alignas(64) FlowEntry {
+    FlowKey key;
+    uint64_t bytes;
+    uint32_t packets;
+    uint32_t lastSeenTick;
+    uint32_t timerNext;             // Next entry in the same timer wheel slot
+    uint8_t state;                  // Slot state, FlowTable internal
+    uint8_t flags;                  // FlowEntryFlags
+    uint8_t appProtocol;            // First non-zero Protocols::ProtocolId seen on the flow
+    uint8_t initiator;              // Direction of the first packet (0: A to B)
+};
+
+static_assert(sizeof(FlowEntry) == 64, "FlowEntry must stay one cache line");
+
+struct FlowTableConfig {
+    size_t initialCapacity = 1u << 16;
+    size_t maxCapacity = 1u << 22;      // 256 MiB of entries; new flows are rejected beyond
+    uint64_t tickNs = 1000000000ull;    // Expiry resolution
+    uint32_t tcpTimeoutTicks = 120;
+    uint32_t udpTimeoutTicks = 30;
+    uint32_t otherTimeoutTicks = 60;
+    uint32_t closedTimeoutTicks = 5;
+};
+
+struct FlowTableStatistics {
+    uint64_t created = 0;
+    uint64_t expired = 0;
+    uint64_t rejected = 0;
+    uint64_t rehashes = 0;
+};
+
+// Per-flow state keyed by the canonical 5-tuple. Open addressing with linear probing over
+// 64-byte entries, hashed with CRC32C (SSE4.2 or ARMv8 CRC instructions, with a multiply-mix
+// fallback). Entries never move except when the table is rebuilt, so the timer wheel can
+// link them by index.
+//
+// Expiry uses a three-level hierarchical timer wheel (256 x 64 x 64 ticks) with lazy
+// rescheduling: a packet only updates lastSeenTick, and an entry is looked at once per
+// timeout when its slot comes up, either expiring or moving to its new deadline. Idle
+// flows cost nothing per tick and busy flows nothing per packet.
+//
+// Not thread-safe. Shard by shardOf() so each worker owns one table; the fanout hash
+// already sends both directions of a flow to the same worker, so lookups need no locks.
+class FlowTable {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+private:
+    enum SlotState : uint8_t {
+        SLOT_EMPTY = 0,
+        SLOT_OCCUPIED,
+        SLOT_TOMBSTONE,
+        SLOT_DRAINING               // Expired early but still linked in the wheel; not reusable yet
+    };
+
+    struct ClosingFlow {
+        uint32_t index;
+        uint32_t closedTick;
+    };
+
+    static constexpr uint32_t LEVEL0_BITS = 8;
+    static constexpr uint32_t LEVEL1_BITS = 6;
+    static constexpr uint32_t LEVEL2_BITS = 6;
+    static constexpr uint32_t LEVEL0_SLOTS = 1u << LEVEL0_BITS;
+    static constexpr uint32_t LEVEL1_SLOTS = 1u << LEVEL1_BITS;
+    static constexpr uint32_t LEVEL2_SLOTS = 1u << LEVEL2_BITS;
+    static constexpr uint32_t LEVEL1_SPAN = LEVEL0_SLOTS * LEVEL1_SLOTS;
+    static constexpr uint32_t WHEEL_SPAN = LEVEL1_SPAN * LEVEL2_SLOTS;
+
+    struct EntryDeleter {
+        void operator()(FlowEntry* entries) const { ::operator delete[](entries, std::align_val_t(64)); }
+    };
+
+    FlowTableConfig config_;
+    std::unique_ptr<FlowEntry[], EntryDeleter> entries_;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    size_t tombstones_ = 0;
+
+    uint32_t level0_[LEVEL0_SLOTS];
+    uint32_t level1_[LEVEL1_SLOTS];
+    uint32_t level2_[LEVEL2_SLOTS];
+    uint32_t currentTick_ = 0;
+    std::deque<ClosingFlow> closing_;   // Closed TCP flows in close order, for the short timeout
+    uint64_t baseNs_ = 0;
+    bool started_ = false;
+
+    FlowTableStatistics stats_;
+
+    static std::unique_ptr<FlowEntry[], EntryDeleter> allocate(size_t count) {
+        FlowEntry* entries = static_cast<FlowEntry*>(::operator new[](count * sizeof(FlowEntry), std::align_val_t(64)));
+        std::memset(static_cast<void*>(entries), 0, count * sizeof(FlowEntry));
+        return std::unique_ptr<FlowEntry[], EntryDeleter>(entries);
+    }
+
+    uint32_t timeoutOf(const FlowEntry& entry) const {
+        if (entry.flags & FLOW_TCP_CLOSED) return config_.closedTimeoutTicks;
+        switch (entry.key.protocol) {
+            case 6:  return config_.tcpTimeoutTicks;
+            case 17: return config_.udpTimeoutTicks;
+            default: return config_.otherTimeoutTicks;
+        }
+    }
+
+    uint32_t tickOf(uint64_t timestampNs) {
+        if (!started_) {
+            baseNs_ = timestampNs;
+            started_ = true;
+        }
+        // Packets from other workers' clocks may be slightly older than the first one seen
+        return timestampNs > baseNs_ ? static_cast<uint32_t>((timestampNs - baseNs_) / config_.tickNs) : 0;
+    }
+
+    void schedule(uint32_t index, uint32_t deadline) {
+        uint32_t* slot;
+        const uint32_t delta = deadline > currentTick_ ? deadline - currentTick_ : 0;
+        if (delta == 0) {
+            // Already due: the slot being processed right now
+            slot = &level0_[currentTick_ & (LEVEL0_SLOTS - 1)];
+        } else if (delta < LEVEL0_SLOTS) {
+            slot = &level0_[deadline & (LEVEL0_SLOTS - 1)];
+        } else if (delta < LEVEL1_SPAN) {
+            slot = &level1_[(deadline >> LEVEL0_BITS) & (LEVEL1_SLOTS - 1)];
+        } else {
+            const uint32_t capped = delta < WHEEL_SPAN ? deadline : currentTick_ + WHEEL_SPAN - 1;
+            slot = &level2_[(capped >> (LEVEL0_BITS + LEVEL1_BITS)) & (LEVEL2_SLOTS - 1)];
+        }
+        entries_[index].timerNext = *slot;
+        *slot = index;
+    }
+
+    void cascade(uint32_t& head) {
+        uint32_t index = head;
+        head = NONE;
+        while (index != NONE) {
+            const uint32_t next = entries_[index].timerNext;
+            schedule(index, entries_[index].lastSeenTick + timeoutOf(entries_[index]));
+            index = next;
+        }
+    }
+
+    template<typename ExpireHandler>
+    size_t processDue(ExpireHandler& onExpire) {
+        uint32_t& head = level0_[currentTick_ & (LEVEL0_SLOTS - 1)];
+        uint32_t index = head;
+        head = NONE;
+
+        size_t expired = 0;
+        while (index != NONE) {
+            FlowEntry& entry = entries_[index];
+            const uint32_t next = entry.timerNext;
+            if (entry.state == SLOT_DRAINING) {
+                entry.state = SLOT_TOMBSTONE;
+                index = next;
+                continue;
+            }
+            const uint32_t deadline = entry.lastSeenTick + timeoutOf(entry);
+            if (deadline > currentTick_) {
+                schedule(index, deadline);
+            } else {
+                onExpire(static_cast<const FlowEntry&>(entry));
+                entry.state = SLOT_TOMBSTONE;
+                size_--;
+                tombstones_++;
+                expired++;
+            }
+            index = next;
+        }
+        return expired;
+    }
+
+    // A flow that closes is still scheduled at its idle deadline, and the wheel only ever
+    // moves entries later; the closing queue expires it after the short close timeout instead
+    template<typename ExpireHandler>
+    size_t processClosing(ExpireHandler& onExpire) {
+        size_t expired = 0;
+        while (!closing_.empty() && closing_.front().closedTick + config_.closedTimeoutTicks <= currentTick_) {
+            FlowEntry& entry = entries_[closing_.front().index];
+            closing_.pop_front();
+            if (entry.state != SLOT_OCCUPIED || !(entry.flags & FLOW_TCP_CLOSED) ||
+                entry.lastSeenTick + config_.closedTimeoutTicks > currentTick_) {
+                continue;
+            }
+            onExpire(static_cast<const FlowEntry&>(entry));
+            entry.state = SLOT_DRAINING;
+            size_--;
+            tombstones_++;
+            expired++;
+        }
+        return expired;
+    }
+
+    void resetWheel() {
+        std::fill(std::begin(level0_), std::end(level0_), NONE);
+        std::fill(std::begin(level1_), std::end(level1_), NONE);
+        std::fill(std::begin(level2_), std::end(level2_), NONE);
+    }
+
+    // Rebuilds into newCapacity slots, dropping tombstones; timer chains are rebuilt from lastSeenTick
+    void rehash(size_t newCapacity) {
+        auto previous = std::move(entries_);
+        const size_t previousCapacity = capacity_;
+
+        entries_ = allocate(newCapacity);
+        capacity_ = newCapacity;
+        mask_ = newCapacity - 1;
+        tombstones_ = 0;
+        resetWheel();
+        closing_.clear();               // Rescheduling below already uses the close timeout
+
+        for (size_t i = 0; i < previousCapacity; ++i) {
+            if (previous[i].state != SLOT_OCCUPIED) continue;
+            size_t slot = hash(previous[i].key) & mask_;
+            while (entries_[slot].state != SLOT_EMPTY) slot = (slot + 1) & mask_;
+            entries_[slot] = previous[i];
+            schedule(static_cast<uint32_t>(slot), entries_[slot].lastSeenTick + timeoutOf(entries_[slot]));
+        }
+        stats_.rehashes++;
+    }
+
+    // Keeps occupied plus tombstone slots under 3/4 of the table so probes stay short
+    bool reserveOne() {
+        if ((size_ + tombstones_ + 1) * 4 <= capacity_ * 3) return true;
+        if ((size_ + 1) * 4 > capacity_ * 3 / 2 && capacity_ * 2 <= config_.maxCapacity) {
+            rehash(capacity_ * 2);
+            return true;
+        }
+        if (tombstones_ > 0) {
+            rehash(capacity_);
+            return (size_ + 1) * 4 <= capacity_ * 3;
+        }
+        return false;
+    }
+
+    size_t locate(const FlowKey& key, uint32_t keyHash, bool& found) const {
+        size_t slot = keyHash & mask_;
+        size_t firstFree = SIZE_MAX;
+        while (true) {
+            const FlowEntry& entry = entries_[slot];
+            if (entry.state == SLOT_EMPTY) {
+                found = false;
+                return firstFree != SIZE_MAX ? firstFree : slot;
+            }
+            if (entry.state == SLOT_OCCUPIED) {
+                if (entry.key == key) {
+                    found = true;
+                    return slot;
+                }
+            } else if (entry.state == SLOT_TOMBSTONE && firstFree == SIZE_MAX) {
+                firstFree = slot;
+            }
+            slot = (slot + 1) & mask_;
+        }
+    }
+
+public:
+    explicit FlowTable(const FlowTableConfig& config = FlowTableConfig{})
+        : config_(config)
+    {
+        if (config_.initialCapacity < 16 || (config_.initialCapacity & (config_.initialCapacity - 1)) != 0 ||
+            config_.maxCapacity < config_.initialCapacity || config_.maxCapacity > (1ull << 31)) {
+            throw std::invalid_argument("Flow table capacities must be powers of two, initial <= max <= 2^31");
+        }
+        if (config_.tickNs == 0) {
+            throw std::invalid_argument("Flow table tick must be non-zero");
+        }
+
+        entries_ = allocate(config_.initialCapacity);
+        capacity_ = config_.initialCapacity;
+        mask_ = capacity_ - 1;
+        resetWheel();
+    }
+
+    FlowTable(const FlowTable&) = delete;
+    FlowTable& operator=(const FlowTable&) = delete;
+
+    // Symmetric because FlowKey is canonical: both directions hash the same
+    static uint32_t hash(const FlowKey& key) {
+        uint64_t words[sizeof(FlowKey) / 8];
+        std::memcpy(words, &key, sizeof(words));
+#if defined(PA2026_FLOW_CRC32C_SSE42)
+        uint64_t crc = 0xFFFFFFFFu;
+        for (uint64_t word : words) crc = _mm_crc32_u64(crc, word);
+        return static_cast<uint32_t>(crc);
+#elif defined(PA2026_FLOW_CRC32C_ARM)
+        uint32_t crc = 0xFFFFFFFFu;
+        for (uint64_t word : words) crc = __crc32cd(crc, word);
+        return crc;
+#else
+        uint64_t mixed = 0x9E3779B97F4A7C15ull;
+        for (uint64_t word : words) {
+            mixed = (mixed ^ word) * 0xFF51AFD7ED558CCDull;
+            mixed ^= mixed >> 32;
+        }
+        return static_cast<uint32_t>(mixed);
+#endif
+    }
+
+    // Worker that owns a flow when tables are sharded; uses the high hash bits, which the
+    // table itself does not use for slot selection
+    static size_t shardOf(const FlowKey& key, size_t shards) {
+        return static_cast<size_t>((static_cast<uint64_t>(hash(key)) * shards) >> 32);
+    }
+
+    // Counts one packet on its flow, creating the flow on first sight. Returns nullptr when
+    // the table is at maxCapacity. The pointer is valid until the next update or advance.
+    FlowEntry* update(const FlowKey& key, uint8_t direction, uint32_t bytes, uint64_t timestampNs,
+                      uint8_t tcpFlags = 0, uint8_t appProtocol = 0) {
+        const uint32_t tick = tickOf(timestampNs);
+        const uint32_t keyHash = hash(key);
+
+        bool found = false;
+        size_t slot = locate(key, keyHash, found);
+        if (!found) {
+            const uint64_t rehashes = stats_.rehashes;
+            if (!reserveOne()) {
+                stats_.rejected++;
+                return nullptr;
+            }
+            if (stats_.rehashes != rehashes) slot = locate(key, keyHash, found);
+            FlowEntry& created = entries_[slot];
+            if (created.state == SLOT_TOMBSTONE) tombstones_--;
+            std::memset(static_cast<void*>(&created), 0, sizeof(FlowEntry));
+            created.key = key;
+            created.state = SLOT_OCCUPIED;
+            created.initiator = direction;
+            created.lastSeenTick = tick;
+            size_++;
+            stats_.created++;
+            schedule(static_cast<uint32_t>(slot), tick + timeoutOf(created));
+        }
+
+        FlowEntry& entry = entries_[slot];
+        entry.bytes += bytes;
+        entry.packets++;
+        if (tick > entry.lastSeenTick) entry.lastSeenTick = tick;
+        if (entry.appProtocol == 0) entry.appProtocol = appProtocol;
+        if (key.protocol == 6) {
+            if (tcpFlags & 0x02) entry.flags |= FLOW_TCP_SYN;
+            if ((tcpFlags & 0x05) && !(entry.flags & FLOW_TCP_CLOSED)) {
+                entry.flags |= FLOW_TCP_CLOSED;
+                closing_.push_back(ClosingFlow{ static_cast<uint32_t>(slot), tick });
+            }
+        }
+        return &entry;
+    }
+
+    const FlowEntry* find(const FlowKey& key) const {
+        bool found = false;
+        size_t slot = locate(key, hash(key), found);
+        return found ? &entries_[slot] : nullptr;
+    }
+
+    // Moves the wheel up to timestampNs, calling onExpire(const FlowEntry&) for each flow
+    // whose idle timeout has passed. Cheap to call per batch: one step per elapsed tick.
+    template<typename ExpireHandler>
+    size_t advance(uint64_t timestampNs, ExpireHandler&& onExpire) {
+        if (!started_) return 0;
+        const uint32_t target = tickOf(timestampNs);
+
+        size_t expired = 0;
+        while (currentTick_ < target) {
+            currentTick_++;
+            if ((currentTick_ & (LEVEL0_SLOTS - 1)) == 0) {
+                if ((currentTick_ & (LEVEL1_SPAN - 1)) == 0) {
+                    cascade(level2_[(currentTick_ >> (LEVEL0_BITS + LEVEL1_BITS)) & (LEVEL2_SLOTS - 1)]);
+                }
+                cascade(level1_[(currentTick_ >> LEVEL0_BITS) & (LEVEL1_SLOTS - 1)]);
+            }
+            expired += processDue(onExpire);
+        }
+        expired += processClosing(onExpire);
+        stats_.expired += expired;
+        return expired;
+    }
+
+    size_t advance(uint64_t timestampNs) {
+        return advance(timestampNs, [](const FlowEntry&) {});
+    }
+
+    // Visits every live flow; for reports, not for the packet path
+    template<typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (entries_[i].state == SLOT_OCCUPIED) visit(entries_[i]);
+        }
+    }
+
+    void clear() {
+        std::memset(static_cast<void*>(entries_.get()), 0, capacity_ * sizeof(FlowEntry));
+        size_ = 0;
+        tombstones_ = 0;
+        currentTick_ = 0;
+        started_ = false;
+        closing_.clear();
+        resetWheel();
+        stats_ = FlowTableStatistics{};
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    size_t memoryBytes() const { return capacity_ * sizeof(FlowEntry); }
+    const FlowTableStatistics& statistics() const { return stats_; }
+};
+
+} // namespace PacketAnalyzer2026::Core
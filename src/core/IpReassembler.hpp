@@ -0,0 +1,508 @@
+// IpReassembler.hpp - IPv4/IPv6 fragment reassembly into whole datagrams over a bounded slab pool
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "ByteView.hpp"
+#include "../performance/BufferPool.hpp"
+
+namespace PacketAnalyzer2026::Core {
+
+struct FragmentKey {
+    uint8_t source[16];
+    uint8_t dest[16];
+    uint32_t id;                    // IPv4 identification is 16 bits, IPv6 32 bits
+    uint8_t ipVersion;
+    uint8_t protocol;               // IPv4 only; IPv6 fragments of one datagram share the id
+    uint16_t reserved;
+
+    bool operator==(const FragmentKey& other) const {
+        return std::memcmp(this, &other, sizeof(FragmentKey)) == 0;
+    }
+};
+
+static_assert(sizeof(FragmentKey) == 40, "FragmentKey is hashed and compared as raw bytes");
+
+struct FragmentKeyHash {
+    size_t operator()(const FragmentKey& key) const {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&key);
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t i = 0; i < sizeof(FragmentKey); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct FragmentConfig {
+    size_t bufferBudget = 16u << 20;        // Pool bytes for all datagrams in flight
+    uint32_t blockSize = 2048;
+    size_t maxDatagrams = 4096;             // Datagrams in flight; the oldest is dropped to make room
+    uint64_t timeoutNs = 30ull * 1000000000ull;
+};
+
+struct FragmentStatistics {
+    uint64_t fragments = 0;
+    uint64_t reassembled = 0;
+    uint64_t duplicates = 0;
+    uint64_t overlaps = 0;                  // Partial overlaps; IPv6 datagrams are discarded (RFC 5722)
+    uint64_t timeouts = 0;
+    uint64_t evicted = 0;                   // Dropped for the datagram or pool limit
+    uint64_t malformed = 0;
+};
+
+enum class FragmentResult : uint8_t {
+    NotFragment,        // Pass the frame on unchanged
+    Buffered,           // Held until the rest of the datagram arrives
+    Reassembled,        // The handler received the whole datagram
+    Dropped
+};
+
+// Collects IP fragments into whole datagrams and hands them on as frames with the link
+// and IP headers of the first fragment, patched to describe the reassembled packet, so
+// the rest of the pipeline parses them like any other frame.
+//
+// Unfragmented packets cost one header check. Fragment data goes into fixed-size blocks from
+// a BufferPool, so memory is bounded by the pool budget and maxDatagrams no matter what is
+// received; a flood only recycles the oldest partial datagrams. Expiry is in arrival order,
+// checked at the front of a FIFO on every fragment. Overlapping IPv4 fragments keep the
+// bytes that arrived first; IPv6 datagrams with overlaps are dropped. Single-threaded.
+class IpReassembler {
+private:
+    static constexpr uint32_t NONE = Performance::BufferPool::NONE;
+    static constexpr uint32_t MAX_DATAGRAM = 65535;
+    static constexpr size_t MAX_RANGES = 16;
+    static constexpr size_t MAX_PREFIX = 192;           // Link header plus IP header and extensions
+
+    struct Range {
+        uint32_t start;
+        uint32_t end;
+    };
+
+    struct Datagram {
+        FragmentKey key;
+        uint64_t firstSeenNs;
+        uint32_t generation;
+        uint32_t totalLength;           // Payload bytes, known once the last fragment arrives
+        std::vector<uint32_t> blocks;   // Pool block per blockSize bytes of payload, NONE until written
+        Range ranges[MAX_RANGES];       // Received payload, sorted and merged
+        uint8_t rangeCount;
+        bool active;
+        bool havePrefix;
+        uint16_t prefixLength;
+        uint16_t l3Offset;
+        uint16_t nextHeaderOffset;      // IPv6: byte that named the fragment header
+        uint8_t nextHeader;             // IPv6: protocol after the fragment header
+        uint8_t prefix[MAX_PREFIX];
+    };
+
+    struct Pending {
+        uint32_t slot;
+        uint32_t generation;
+    };
+
+    struct Fragment {
+        FragmentKey key;
+        uint32_t offset;
+        bool more;
+        ByteView payload;
+        size_t headerEnd;               // Frame offset where the fragmentable part starts
+        uint16_t nextHeaderOffset;
+        uint8_t nextHeader;
+    };
+
+    FragmentConfig config_;
+    Performance::BufferPool pool_;
+    std::vector<Datagram> datagrams_;
+    std::vector<uint32_t> freeSlots_;
+    std::unordered_map<FragmentKey, uint32_t, FragmentKeyHash> index_;
+    std::deque<Pending> arrivalOrder_;
+    std::vector<uint8_t> output_;
+    uint32_t nextGeneration_ = 1;
+    FragmentStatistics stats_;
+
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+    static uint32_t read32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+    static void write16(uint8_t* p, uint32_t value) {
+        p[0] = static_cast<uint8_t>(value >> 8);
+        p[1] = static_cast<uint8_t>(value);
+    }
+
+    // Value of the length field the reassembled header will carry: IPv4 total length counts
+    // the header, IPv6 payload length does not count the fixed 40 bytes
+    static size_t reassembledLength(uint8_t ipVersion, size_t headerLength, uint32_t payloadEnd) {
+        return ipVersion == 4 ? headerLength + payloadEnd : headerLength - 40 + payloadEnd;
+    }
+
+    // Returns 0 for unfragmented packets, 1 for a fragment, -1 for a malformed fragment
+    static int parseIPv4(ByteView frame, size_t l3Offset, Fragment& out) {
+        const uint8_t* ip = frame.data + l3Offset;
+        const size_t available = frame.size - l3Offset;
+        const uint16_t flagsOffset = read16(ip + 6);
+        if ((flagsOffset & 0x3FFF) == 0) return 0;
+
+        const size_t ihl = static_cast<size_t>(ip[0] & 0x0F) * 4;
+        const size_t totalLength = read16(ip + 2);
+        if (ihl < 20 || totalLength < ihl || totalLength > available) return -1;
+
+        std::memset(&out.key, 0, sizeof(out.key));
+        std::memcpy(out.key.source, ip + 12, 4);
+        std::memcpy(out.key.dest, ip + 16, 4);
+        out.key.id = read16(ip + 4);
+        out.key.ipVersion = 4;
+        out.key.protocol = ip[9];
+        out.offset = static_cast<uint32_t>(flagsOffset & 0x1FFF) * 8;
+        out.more = (flagsOffset & 0x2000) != 0;
+        out.payload = ByteView(ip + ihl, totalLength - ihl);
+        out.headerEnd = l3Offset + ihl;
+        return 1;
+    }
+
+    static int parseIPv6(ByteView frame, size_t l3Offset, Fragment& out) {
+        const uint8_t* ip = frame.data + l3Offset;
+        const size_t available = frame.size - l3Offset;
+        const size_t end = std::min(available, 40 + static_cast<size_t>(read16(ip + 4)));
+
+        // Only hop-by-hop, routing and destination options may precede the fragment header
+        uint8_t nextHeader = ip[6];
+        size_t nextHeaderOffset = 6;
+        size_t offset = 40;
+        while (nextHeader == 0 || nextHeader == 43 || nextHeader == 60) {
+            if (offset + 8 > end) return 0;
+            const size_t length = (static_cast<size_t>(ip[offset + 1]) + 1) * 8;
+            nextHeader = ip[offset];
+            nextHeaderOffset = offset;
+            offset += length;
+        }
+        if (nextHeader != 44) return 0;
+        if (offset + 8 > end) return -1;
+
+        const uint8_t* fragment = ip + offset;
+        std::memset(&out.key, 0, sizeof(out.key));
+        std::memcpy(out.key.source, ip + 8, 16);
+        std::memcpy(out.key.dest, ip + 24, 16);
+        out.key.id = read32(fragment + 4);
+        out.key.ipVersion = 6;
+        out.offset = static_cast<uint32_t>(read16(fragment + 2) & 0xFFF8);
+        out.more = (fragment[3] & 0x01) != 0;
+        out.payload = ByteView(fragment + 8, end - offset - 8);
+        out.headerEnd = l3Offset + offset;
+        out.nextHeaderOffset = static_cast<uint16_t>(l3Offset + nextHeaderOffset);
+        out.nextHeader = fragment[0];
+        return 1;
+    }
+
+    void release(uint32_t slot) {
+        Datagram& datagram = datagrams_[slot];
+        for (uint32_t block : datagram.blocks) {
+            pool_.releaseChain(block);
+        }
+        datagram.blocks.clear();
+        datagram.active = false;
+        index_.erase(datagram.key);
+        freeSlots_.push_back(slot);
+    }
+
+    // Drops the oldest datagram in flight; false when there is none
+    bool evictOldest() {
+        while (!arrivalOrder_.empty()) {
+            const Pending pending = arrivalOrder_.front();
+            arrivalOrder_.pop_front();
+            const Datagram& datagram = datagrams_[pending.slot];
+            if (datagram.active && datagram.generation == pending.generation) {
+                release(pending.slot);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t open(const FragmentKey& key, uint64_t timestampNs) {
+        if (index_.size() >= config_.maxDatagrams && evictOldest()) {
+            stats_.evicted++;
+        }
+        // Completed datagrams leave stale entries behind a long-lived one; keep the FIFO bounded
+        if (arrivalOrder_.size() >= 4 * config_.maxDatagrams) {
+            arrivalOrder_.erase(std::remove_if(arrivalOrder_.begin(), arrivalOrder_.end(), [this](const Pending& pending) {
+                const Datagram& datagram = datagrams_[pending.slot];
+                return !datagram.active || datagram.generation != pending.generation;
+            }), arrivalOrder_.end());
+        }
+
+        uint32_t slot;
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(datagrams_.size());
+            datagrams_.emplace_back();
+        }
+
+        Datagram& datagram = datagrams_[slot];
+        datagram.key = key;
+        datagram.firstSeenNs = timestampNs;
+        datagram.generation = nextGeneration_++;
+        datagram.totalLength = 0;
+        datagram.blocks.assign((MAX_DATAGRAM + pool_.blockSize() - 1) / pool_.blockSize(), NONE);
+        datagram.rangeCount = 0;
+        datagram.active = true;
+        datagram.havePrefix = false;
+        index_.emplace(key, slot);
+        arrivalOrder_.push_back(Pending{ slot, datagram.generation });
+        return slot;
+    }
+
+    // Copies data to payload offset `offset`, allocating blocks as needed; false if the pool is exhausted
+    bool store(Datagram& datagram, ByteView data, uint32_t offset) {
+        const uint32_t blockSize = pool_.blockSize();
+        size_t written = 0;
+        while (written < data.size) {
+            const uint32_t position = offset + static_cast<uint32_t>(written);
+            uint32_t& block = datagram.blocks[position / blockSize];
+            if (block == NONE) {
+                block = pool_.allocate();
+                // Under pressure, older partial datagrams give way to this one
+                while (block == NONE && evictOldest()) {
+                    stats_.evicted++;
+                    if (!datagram.active) return false;
+                    block = pool_.allocate();
+                }
+                if (block == NONE) return false;
+            }
+            const size_t take = std::min<size_t>(data.size - written, blockSize - position % blockSize);
+            std::memcpy(pool_.data(block) + position % blockSize, data.data + written, take);
+            written += take;
+        }
+        return true;
+    }
+
+    // Writes the parts of [fragment.offset, end) not yet received; false if the datagram is gone
+    bool fillHoles(uint32_t slot, const Fragment& fragment, uint32_t end) {
+        Datagram& datagram = datagrams_[slot];
+        uint32_t cursor = fragment.offset;
+        for (uint8_t i = 0; i < datagram.rangeCount && cursor < end; ++i) {
+            const Range range = datagram.ranges[i];
+            if (range.end <= cursor) continue;
+            if (range.start >= end) break;
+            if (range.start > cursor) {
+                if (!store(datagram, fragment.payload.subview(cursor - fragment.offset, range.start - cursor), cursor)) return false;
+            }
+            cursor = std::max(cursor, range.end);
+        }
+        if (cursor < end) {
+            return store(datagram, fragment.payload.subview(cursor - fragment.offset, end - cursor), cursor);
+        }
+        return true;
+    }
+
+    bool addRange(Datagram& datagram, uint32_t start, uint32_t end) {
+        Range merged{ start, end };
+        Range kept[MAX_RANGES];
+        uint8_t count = 0;
+        bool placed = false;
+        for (uint8_t i = 0; i < datagram.rangeCount; ++i) {
+            const Range range = datagram.ranges[i];
+            if (range.end < merged.start) {
+                kept[count++] = range;
+            } else if (range.start > merged.end) {
+                if (!placed) {
+                    if (count == MAX_RANGES) return false;
+                    kept[count++] = merged;
+                    placed = true;
+                }
+                if (count == MAX_RANGES) return false;
+                kept[count++] = range;
+            } else {
+                merged.start = std::min(merged.start, range.start);
+                merged.end = std::max(merged.end, range.end);
+            }
+        }
+        if (!placed) {
+            if (count == MAX_RANGES) return false;
+            kept[count++] = merged;
+        }
+        std::memcpy(datagram.ranges, kept, sizeof(Range) * count);
+        datagram.rangeCount = count;
+        return true;
+    }
+
+    template<typename DatagramHandler>
+    void complete(uint32_t slot, DatagramHandler& onDatagram) {
+        Datagram& datagram = datagrams_[slot];
+        const uint32_t total = datagram.totalLength;
+        output_.resize(datagram.prefixLength + total);
+        std::memcpy(output_.data(), datagram.prefix, datagram.prefixLength);
+
+        const uint32_t blockSize = pool_.blockSize();
+        for (uint32_t position = 0; position < total; position += blockSize) {
+            std::memcpy(output_.data() + datagram.prefixLength + position, pool_.data(datagram.blocks[position / blockSize]),
+                        std::min(blockSize, total - position));
+        }
+
+        uint8_t* ip = output_.data() + datagram.l3Offset;
+        const uint32_t headerLength = datagram.prefixLength - datagram.l3Offset;
+        if (datagram.key.ipVersion == 4) {
+            write16(ip + 2, headerLength + total);
+            write16(ip + 6, read16(ip + 6) & 0x4000);           // Keep DF, clear MF and the offset
+            write16(ip + 10, 0);
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < headerLength; i += 2) sum += read16(ip + i);
+            while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+            write16(ip + 10, ~sum & 0xFFFF);
+        } else {
+            // The fragment header is left out; the header that named it now names the payload
+            output_[datagram.nextHeaderOffset] = datagram.nextHeader;
+            write16(ip + 4, headerLength - 40 + total);
+        }
+
+        release(slot);
+        stats_.reassembled++;
+        onDatagram(ByteView(output_.data(), output_.size()));
+    }
+
+public:
+    explicit IpReassembler(const FragmentConfig& config = FragmentConfig{})
+        : config_(config)
+        , pool_(config.bufferBudget, config.blockSize, "IP fragments")
+    {
+        index_.reserve(config_.maxDatagrams);
+    }
+
+    IpReassembler(const IpReassembler&) = delete;
+    IpReassembler& operator=(const IpReassembler&) = delete;
+
+    // frame holds a whole captured packet with the IP header at l3Offset. When the frame
+    // completes a datagram, onDatagram(ByteView) receives the reassembled packet, valid only
+    // during the call.
+    template<typename DatagramHandler>
+    FragmentResult process(ByteView frame, size_t l3Offset, uint64_t timestampNs, DatagramHandler&& onDatagram) {
+        if (frame.size < l3Offset + 20) return FragmentResult::NotFragment;
+
+        Fragment fragment{};
+        const uint8_t version = frame[l3Offset] >> 4;
+        int parsed = 0;
+        if (version == 4) {
+            parsed = parseIPv4(frame, l3Offset, fragment);
+        } else if (version == 6 && frame.size >= l3Offset + 40) {
+            parsed = parseIPv6(frame, l3Offset, fragment);
+        }
+        if (parsed == 0) return FragmentResult::NotFragment;
+
+        stats_.fragments++;
+        expire(timestampNs);
+
+        if (parsed < 0) {
+            stats_.malformed++;
+            return FragmentResult::Dropped;
+        }
+        const uint32_t end = fragment.offset + static_cast<uint32_t>(fragment.payload.size);
+        if (reassembledLength(fragment.key.ipVersion, fragment.headerEnd - l3Offset, end) > MAX_DATAGRAM || (fragment.more && (fragment.payload.size % 8) != 0) ||
+            fragment.payload.empty() || (fragment.offset == 0 && fragment.headerEnd > MAX_PREFIX)) {
+            stats_.malformed++;
+            return FragmentResult::Dropped;
+        }
+
+        auto it = index_.find(fragment.key);
+        const uint32_t slot = it != index_.end() ? it->second : open(fragment.key, timestampNs);
+        Datagram& datagram = datagrams_[slot];
+
+        if (!fragment.more) {
+            if ((datagram.totalLength != 0 && datagram.totalLength != end) ||
+                (datagram.rangeCount > 0 && datagram.ranges[datagram.rangeCount - 1].end > end)) {
+                stats_.malformed++;
+                release(slot);
+                return FragmentResult::Dropped;
+            }
+            datagram.totalLength = end;
+        } else if (datagram.totalLength != 0 && end > datagram.totalLength) {
+            stats_.malformed++;
+            release(slot);
+            return FragmentResult::Dropped;
+        }
+
+        // Classify against what is already here
+        uint32_t covered = 0;
+        for (uint8_t i = 0; i < datagram.rangeCount; ++i) {
+            const Range range = datagram.ranges[i];
+            if (range.start < end && range.end > fragment.offset) {
+                covered += std::min(range.end, end) - std::max(range.start, fragment.offset);
+            }
+        }
+        if (covered == end - fragment.offset) {
+            stats_.duplicates++;
+            return FragmentResult::Buffered;
+        }
+        if (covered > 0) {
+            stats_.overlaps++;
+            if (fragment.key.ipVersion == 6) {
+                release(slot);
+                return FragmentResult::Dropped;
+            }
+        }
+
+        if (!fillHoles(slot, fragment, end)) {
+            stats_.evicted++;
+            if (datagram.active) release(slot);
+            return FragmentResult::Dropped;
+        }
+        if (!addRange(datagram, fragment.offset, end)) {
+            stats_.malformed++;
+            release(slot);
+            return FragmentResult::Dropped;
+        }
+
+        if (fragment.offset == 0) {
+            std::memcpy(datagram.prefix, frame.data, fragment.headerEnd);
+            datagram.prefixLength = static_cast<uint16_t>(fragment.headerEnd);
+            datagram.l3Offset = static_cast<uint16_t>(l3Offset);
+            datagram.nextHeaderOffset = fragment.nextHeaderOffset;
+            datagram.nextHeader = fragment.nextHeader;
+            datagram.havePrefix = true;
+        }
+
+        if (datagram.havePrefix && datagram.totalLength != 0 && datagram.rangeCount == 1 &&
+            datagram.ranges[0].start == 0 && datagram.ranges[0].end == datagram.totalLength) {
+            // The first fragment's header is the one kept, and may be longer than the last one's
+            if (reassembledLength(datagram.key.ipVersion, datagram.prefixLength - datagram.l3Offset,
+                                  datagram.totalLength) > MAX_DATAGRAM) {
+                stats_.malformed++;
+                release(slot);
+                return FragmentResult::Dropped;
+            }
+            complete(slot, onDatagram);
+            return FragmentResult::Reassembled;
+        }
+        return FragmentResult::Buffered;
+    }
+
+    // Drops datagrams older than the timeout; also runs on every fragment
+    size_t expire(uint64_t nowNs) {
+        size_t expired = 0;
+        while (!arrivalOrder_.empty()) {
+            const Pending pending = arrivalOrder_.front();
+            const Datagram& datagram = datagrams_[pending.slot];
+            if (datagram.active && datagram.generation == pending.generation) {
+                if (nowNs <= datagram.firstSeenNs || nowNs - datagram.firstSeenNs <= config_.timeoutNs) break;
+                release(pending.slot);
+                expired++;
+            }
+            arrivalOrder_.pop_front();
+        }
+        stats_.timeouts += expired;
+        return expired;
+    }
+
+    size_t pendingDatagrams() const { return index_.size(); }
+    size_t poolBytesInUse() const { return pool_.bytesInUse(); }
+    const FragmentStatistics& statistics() const { return stats_; }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,63 @@
+// LatencyHistogram.hpp - Fixed log2 microsecond buckets for request/response latency rollups
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacketAnalyzer2026::Core {
+
+// Bucket i counts samples below 2^i microseconds and at least 2^(i-1); bucket 0 is below
+// 1 us and the last bucket is open-ended. Recording is at most 23 shifts and three adds,
+// cheap enough for every transaction on the packet path.
+struct LatencyHistogram {
+    static constexpr size_t BUCKETS = 24;           // Up to ~4.2 s, then everything slower
+
+    uint64_t buckets[BUCKETS] = {};
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+
+    static size_t bucketOf(uint64_t latencyNs) {
+        uint64_t micros = latencyNs / 1000;
+        size_t bucket = 0;
+        while (micros != 0 && bucket + 1 < BUCKETS) {
+            micros >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    // Exclusive upper bound of a bucket in microseconds; UINT64_MAX for the last one
+    static uint64_t bucketLimitUs(size_t bucket) {
+        return bucket + 1 < BUCKETS ? (1ull << bucket) : UINT64_MAX;
+    }
+
+    void record(uint64_t latencyNs) {
+        buckets[bucketOf(latencyNs)]++;
+        count++;
+        sumNs += latencyNs;
+    }
+
+    double meanUs() const {
+        return count == 0 ? 0.0 : static_cast<double>(sumNs) / static_cast<double>(count) / 1000.0;
+    }
+
+    // Upper bound of the bucket holding the given fraction of samples, in microseconds
+    uint64_t percentileUs(double fraction) const {
+        if (count == 0) return 0;
+        const uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) return bucketLimitUs(i);
+        }
+        return UINT64_MAX;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKETS; ++i) buckets[i] += other.buckets[i];
+        count += other.count;
+        sumNs += other.sumNs;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,496 @@
+// PacketDissector.hpp - Full field-level dissection of one packet's raw bytes, run on selection
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace PacketAnalyzer2026::Core {
+
+// One node of the protocol tree. Offsets are absolute within the captured frame,
+// so the hex view can highlight exactly the bytes a field was decoded from.
+struct DissectedField {
+    std::string label;
+    uint32_t offset;
+    uint32_t length;
+    int32_t parent;                 // Index into PacketDissection::fields, -1 for layers
+    int32_t row;                    // Position among the parent's children
+    std::vector<int32_t> children;
+};
+
+struct PacketDissection {
+    std::vector<DissectedField> fields;
+    std::vector<int32_t> layers;    // Top-level fields, one per protocol layer
+
+    int32_t add(int32_t parent, std::string label, size_t offset, size_t length) {
+        const int32_t index = static_cast<int32_t>(fields.size());
+        const size_t row = parent < 0 ? layers.size() : fields[parent].children.size();
+        fields.push_back(DissectedField{ std::move(label), static_cast<uint32_t>(offset),
+                                         static_cast<uint32_t>(length), parent,
+                                         static_cast<int32_t>(row), {} });
+        // Looked up after the push: growing fields moves every parent's children vector
+        (parent < 0 ? layers : fields[parent].children).push_back(index);
+        return index;
+    }
+
+    // Narrowest field whose byte range contains offset, or -1; later fields win ties
+    // because children are always added after their parent
+    int32_t fieldAt(uint32_t offset) const {
+        int32_t found = -1;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            const DissectedField& field = fields[i];
+            if (field.length > 0 && offset >= field.offset && offset - field.offset < field.length &&
+                (found < 0 || field.length <= fields[found].length)) {
+                found = static_cast<int32_t>(i);
+            }
+        }
+        return found;
+    }
+};
+
+// Builds the complete field tree for Ethernet, 802.1Q, ARP, IPv4, IPv6, TCP, UDP and ICMP.
+// The capture path only decodes PacketRecord summaries; this runs for the selected packet.
+class PacketDissector {
+private:
+    PacketDissection& out_;
+    const uint8_t* data_;
+    size_t length_;
+
+    PacketDissector(PacketDissection& out, const uint8_t* data, size_t length)
+        : out_(out), data_(data), length_(length) {}
+
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+    static uint32_t read32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    template<typename... Args>
+    static std::string format(const char* pattern, Args... args) {
+        char buffer[160];
+        std::snprintf(buffer, sizeof(buffer), pattern, args...);
+        return buffer;
+    }
+
+    static std::string mac(const uint8_t* p) {
+        return format("%02x:%02x:%02x:%02x:%02x:%02x", p[0], p[1], p[2], p[3], p[4], p[5]);
+    }
+
+    static std::string ipv4(const uint8_t* p) {
+        return format("%u.%u.%u.%u", p[0], p[1], p[2], p[3]);
+    }
+
+    // RFC 5952 text form: lowercase, longest run of two or more zero groups compressed
+    static std::string ipv6(const uint8_t* p) {
+        uint16_t groups[8];
+        for (int i = 0; i < 8; ++i) groups[i] = read16(p + 2 * i);
+
+        int bestStart = -1, bestLength = 0;
+        for (int i = 0; i < 8;) {
+            int j = i;
+            while (j < 8 && groups[j] == 0) ++j;
+            if (j - i > bestLength && j - i >= 2) {
+                bestStart = i;
+                bestLength = j - i;
+            }
+            i = j == i ? i + 1 : j;
+        }
+
+        std::string text;
+        for (int i = 0; i < 8; ++i) {
+            if (i == bestStart) {
+                text += "::";
+                i += bestLength - 1;
+                continue;
+            }
+            if (!text.empty() && text.back() != ':') text += ':';
+            text += format("%x", groups[i]);
+        }
+        return text;
+    }
+
+    static const char* etherTypeName(uint16_t type) {
+        switch (type) {
+            case 0x0800: return "IPv4";
+            case 0x0806: return "ARP";
+            case 0x86DD: return "IPv6";
+            case 0x8100: return "802.1Q Virtual LAN";
+            case 0x88A8: return "802.1ad Virtual LAN";
+            case 0x8847: return "MPLS";
+            default:     return "Unknown";
+        }
+    }
+
+    static const char* ipProtocolName(uint8_t protocol) {
+        switch (protocol) {
+            case 1:   return "ICMP";
+            case 2:   return "IGMP";
+            case 6:   return "TCP";
+            case 17:  return "UDP";
+            case 41:  return "IPv6";
+            case 47:  return "GRE";
+            case 50:  return "ESP";
+            case 58:  return "ICMPv6";
+            case 132: return "SCTP";
+            default:  return "Unknown";
+        }
+    }
+
+    bool available(size_t offset, size_t needed) const {
+        return offset <= length_ && length_ - offset >= needed;
+    }
+
+    void truncated(int32_t layer, size_t offset) {
+        out_.add(layer, format("[Packet truncated: %zu bytes captured]", length_ - std::min(offset, length_)),
+                 offset, length_ > offset ? length_ - offset : 0);
+    }
+
+    void payload(size_t offset) {
+        if (offset < length_) {
+            out_.add(-1, format("Data (%zu bytes)", length_ - offset), offset, length_ - offset);
+        }
+    }
+
+    void ethernet() {
+        if (!available(0, 14)) {
+            truncated(out_.add(-1, "Ethernet II", 0, length_), 0);
+            return;
+        }
+
+        int32_t layer = out_.add(-1, format("Ethernet II, Src: %s, Dst: %s", mac(data_ + 6).c_str(), mac(data_).c_str()), 0, 14);
+        out_.add(layer, "Destination: " + mac(data_), 0, 6);
+        out_.add(layer, "Source: " + mac(data_ + 6), 6, 6);
+
+        uint16_t type = read16(data_ + 12);
+        out_.add(layer, format("Type: %s (0x%04x)", etherTypeName(type), type), 12, 2);
+
+        size_t offset = 14;
+        while ((type == 0x8100 || type == 0x88A8) && available(offset, 4)) {
+            uint16_t tci = read16(data_ + offset);
+            uint16_t inner = read16(data_ + offset + 2);
+            int32_t vlan = out_.add(-1, format("%s, PRI: %u, ID: %u", etherTypeName(type), tci >> 13, tci & 0x0FFF), offset, 4);
+            out_.add(vlan, format("Priority: %u", tci >> 13), offset, 2);
+            out_.add(vlan, format("DEI: %u", (tci >> 12) & 1), offset, 2);
+            out_.add(vlan, format("ID: %u", tci & 0x0FFF), offset, 2);
+            out_.add(vlan, format("Type: %s (0x%04x)", etherTypeName(inner), inner), offset + 2, 2);
+            type = inner;
+            offset += 4;
+        }
+
+        switch (type) {
+            case 0x0800: ipv4Layer(offset); break;
+            case 0x86DD: ipv6Layer(offset); break;
+            case 0x0806: arpLayer(offset); break;
+            default:     payload(offset); break;
+        }
+    }
+
+    void arpLayer(size_t offset) {
+        if (!available(offset, 28)) {
+            truncated(out_.add(-1, "Address Resolution Protocol", offset, length_ - offset), offset);
+            return;
+        }
+
+        const uint8_t* p = data_ + offset;
+        uint16_t opcode = read16(p + 6);
+        int32_t layer = out_.add(-1, format("Address Resolution Protocol (%s)", opcode == 1 ? "request" : opcode == 2 ? "reply" : "other"), offset, 28);
+        out_.add(layer, format("Hardware type: %u", read16(p)), offset, 2);
+        out_.add(layer, format("Protocol type: 0x%04x", read16(p + 2)), offset + 2, 2);
+        out_.add(layer, format("Hardware size: %u", p[4]), offset + 4, 1);
+        out_.add(layer, format("Protocol size: %u", p[5]), offset + 5, 1);
+        out_.add(layer, format("Opcode: %u", opcode), offset + 6, 2);
+        out_.add(layer, "Sender MAC address: " + mac(p + 8), offset + 8, 6);
+        out_.add(layer, "Sender IP address: " + ipv4(p + 14), offset + 14, 4);
+        out_.add(layer, "Target MAC address: " + mac(p + 18), offset + 18, 6);
+        out_.add(layer, "Target IP address: " + ipv4(p + 24), offset + 24, 4);
+        payload(offset + 28);
+    }
+
+    void ipv4Layer(size_t offset) {
+        if (!available(offset, 20)) {
+            truncated(out_.add(-1, "Internet Protocol Version 4", offset, length_ - offset), offset);
+            return;
+        }
+
+        const uint8_t* p = data_ + offset;
+        const size_t headerLength = static_cast<size_t>(p[0] & 0x0F) * 4;
+        const uint8_t protocol = p[9];
+        const uint16_t totalLength = read16(p + 2);
+        const uint16_t fragment = read16(p + 6);
+
+        int32_t layer = out_.add(-1, format("Internet Protocol Version 4, Src: %s, Dst: %s", ipv4(p + 12).c_str(), ipv4(p + 16).c_str()),
+                                 offset, std::min(headerLength, length_ - offset));
+        out_.add(layer, format("Version: %u", p[0] >> 4), offset, 1);
+        out_.add(layer, format("Header Length: %zu bytes (%u)", headerLength, p[0] & 0x0F), offset, 1);
+        out_.add(layer, format("Differentiated Services: DSCP %u, ECN %u", p[1] >> 2, p[1] & 0x03), offset + 1, 1);
+        out_.add(layer, format("Total Length: %u", totalLength), offset + 2, 2);
+        out_.add(layer, format("Identification: 0x%04x (%u)", read16(p + 4), read16(p + 4)), offset + 4, 2);
+
+        int32_t flags = out_.add(layer, format("Flags: 0x%x%s%s", fragment >> 13,
+                                               (fragment & 0x4000) ? ", Don't fragment" : "",
+                                               (fragment & 0x2000) ? ", More fragments" : ""), offset + 6, 1);
+        out_.add(flags, format("Reserved bit: %s", (fragment & 0x8000) ? "Set" : "Not set"), offset + 6, 1);
+        out_.add(flags, format("Don't fragment: %s", (fragment & 0x4000) ? "Set" : "Not set"), offset + 6, 1);
+        out_.add(flags, format("More fragments: %s", (fragment & 0x2000) ? "Set" : "Not set"), offset + 6, 1);
+        out_.add(layer, format("Fragment Offset: %u", (fragment & 0x1FFF) * 8), offset + 6, 2);
+        out_.add(layer, format("Time to Live: %u", p[8]), offset + 8, 1);
+        out_.add(layer, format("Protocol: %s (%u)", ipProtocolName(protocol), protocol), offset + 9, 1);
+        out_.add(layer, format("Header Checksum: 0x%04x", read16(p + 10)), offset + 10, 2);
+        out_.add(layer, "Source Address: " + ipv4(p + 12), offset + 12, 4);
+        out_.add(layer, "Destination Address: " + ipv4(p + 16), offset + 16, 4);
+
+        if (headerLength < 20) {
+            out_.add(layer, "[Malformed: header length below 20 bytes]", offset, 1);
+            return;
+        }
+        if (!available(offset, headerLength)) {
+            truncated(layer, offset + 20);
+            return;
+        }
+        if (headerLength > 20) {
+            out_.add(layer, format("Options: (%zu bytes)", headerLength - 20), offset + 20, headerLength - 20);
+        }
+
+        // Trailing Ethernet padding is not part of the datagram
+        size_t end = length_;
+        if (totalLength >= headerLength && offset + totalLength < length_) {
+            end = offset + totalLength;
+        }
+
+        if ((fragment & 0x1FFF) != 0) {
+            out_.add(-1, format("Fragment data (%zu bytes)", end - offset - headerLength), offset + headerLength, end - offset - headerLength);
+            return;
+        }
+        transport(protocol, offset + headerLength, end);
+    }
+
+    void ipv6Layer(size_t offset) {
+        if (!available(offset, 40)) {
+            truncated(out_.add(-1, "Internet Protocol Version 6", offset, length_ - offset), offset);
+            return;
+        }
+
+        const uint8_t* p = data_ + offset;
+        const uint32_t first = read32(p);
+        const uint16_t payloadLength = read16(p + 4);
+        uint8_t next = p[6];
+
+        int32_t layer = out_.add(-1, "Internet Protocol Version 6, Src: " + ipv6(p + 8) + ", Dst: " + ipv6(p + 24), offset, 40);
+        out_.add(layer, format("Version: %u", first >> 28), offset, 1);
+        out_.add(layer, format("Traffic Class: 0x%02x", (first >> 20) & 0xFF), offset, 2);
+        out_.add(layer, format("Flow Label: 0x%05x", first & 0xFFFFF), offset + 1, 3);
+        out_.add(layer, format("Payload Length: %u", payloadLength), offset + 4, 2);
+        out_.add(layer, format("Next Header: %s (%u)", ipProtocolName(next), next), offset + 6, 1);
+        out_.add(layer, format("Hop Limit: %u", p[7]), offset + 7, 1);
+        out_.add(layer, "Source Address: " + ipv6(p + 8), offset + 8, 16);
+        out_.add(layer, "Destination Address: " + ipv6(p + 24), offset + 24, 16);
+
+        size_t end = offset + 40 + payloadLength < length_ ? offset + 40 + payloadLength : length_;
+        size_t position = offset + 40;
+
+        // Hop-by-hop, routing, fragment and destination options headers
+        while (next == 0 || next == 43 || next == 44 || next == 60) {
+            if (!available(position, 8)) {
+                truncated(layer, position);
+                return;
+            }
+            const uint8_t header = next;
+            const size_t headerLength = header == 44 ? 8 : (static_cast<size_t>(data_[position + 1]) + 1) * 8;
+            const char* name = header == 0 ? "Hop-by-Hop Options" : header == 43 ? "Routing Header" :
+                               header == 44 ? "Fragment Header" : "Destination Options";
+            next = data_[position];
+            int32_t extension = out_.add(layer, format("%s (%zu bytes)", name, headerLength), position,
+                                         std::min(headerLength, length_ - position));
+            out_.add(extension, format("Next Header: %s (%u)", ipProtocolName(next), next), position, 1);
+
+            if (header == 44) {
+                const uint16_t fragment = read16(data_ + position + 2);
+                out_.add(extension, format("Fragment Offset: %u", (fragment >> 3) * 8), position + 2, 2);
+                out_.add(extension, format("More Fragments: %s", (fragment & 1) ? "Yes" : "No"), position + 3, 1);
+                out_.add(extension, format("Identification: 0x%08x", read32(data_ + position + 4)), position + 4, 4);
+                if ((fragment >> 3) != 0) {
+                    payload(position + 8);
+                    return;
+                }
+            }
+            position += headerLength;
+        }
+
+        transport(next, position, end);
+    }
+
+    void transport(uint8_t protocol, size_t offset, size_t end) {
+        if (end < offset) {
+            end = length_;     // Length field shorter than the headers already walked
+        }
+        switch (protocol) {
+            case 6:  tcpLayer(offset, end); break;
+            case 17: udpLayer(offset, end); break;
+            case 1:
+            case 58: icmpLayer(protocol, offset, end); break;
+            default: payload(offset); break;
+        }
+    }
+
+    void tcpOptions(int32_t layer, size_t offset, size_t length) {
+        int32_t options = out_.add(layer, format("Options: (%zu bytes)", length), offset, length);
+        size_t position = offset;
+        const size_t end = offset + length;
+
+        while (position < end) {
+            const uint8_t kind = data_[position];
+            if (kind == 0) {
+                out_.add(options, "End of Option List", position, 1);
+                break;
+            }
+            if (kind == 1) {
+                out_.add(options, "No-Operation (NOP)", position, 1);
+                ++position;
+                continue;
+            }
+            if (position + 1 >= end || data_[position + 1] < 2 || position + data_[position + 1] > end) {
+                out_.add(options, "[Malformed option]", position, end - position);
+                break;
+            }
+
+            const uint8_t size = data_[position + 1];
+            const uint8_t* value = data_ + position + 2;
+            if (kind == 2 && size == 4) {
+                out_.add(options, format("Maximum segment size: %u bytes", read16(value)), position, size);
+            } else if (kind == 3 && size == 3) {
+                out_.add(options, format("Window scale: %u (multiply by %u)", value[0], 1u << (value[0] & 0x0F)), position, size);
+            } else if (kind == 4) {
+                out_.add(options, "SACK permitted", position, size);
+            } else if (kind == 5) {
+                out_.add(options, format("SACK: %u blocks", (size - 2) / 8), position, size);
+            } else if (kind == 8 && size == 10) {
+                out_.add(options, format("Timestamps: TSval %u, TSecr %u", read32(value), read32(value + 4)), position, size);
+            } else {
+                out_.add(options, format("Option kind %u (%u bytes)", kind, size), position, size);
+            }
+            position += size;
+        }
+    }
+
+    void tcpLayer(size_t offset, size_t end) {
+        if (!available(offset, 20)) {
+            truncated(out_.add(-1, "Transmission Control Protocol", offset, length_ - std::min(offset, length_)), offset);
+            return;
+        }
+
+        const uint8_t* p = data_ + offset;
+        const uint16_t sourcePort = read16(p);
+        const uint16_t destPort = read16(p + 2);
+        const size_t headerLength = static_cast<size_t>(p[12] >> 4) * 4;
+        const uint16_t flags = static_cast<uint16_t>(read16(p + 12) & 0x01FF);
+        const size_t segment = end > offset + headerLength ? end - offset - headerLength : 0;
+
+        int32_t layer = out_.add(-1, format("Transmission Control Protocol, Src Port: %u, Dst Port: %u, Seq: %u, Len: %zu",
+                                            sourcePort, destPort, read32(p + 4), segment),
+                                 offset, std::min(headerLength, length_ - offset));
+        out_.add(layer, format("Source Port: %u", sourcePort), offset, 2);
+        out_.add(layer, format("Destination Port: %u", destPort), offset + 2, 2);
+        out_.add(layer, format("Sequence Number: %u", read32(p + 4)), offset + 4, 4);
+        out_.add(layer, format("Acknowledgment Number: %u", read32(p + 8)), offset + 8, 4);
+        out_.add(layer, format("Header Length: %zu bytes (%u)", headerLength, p[12] >> 4), offset + 12, 1);
+
+        static const char* flagNames[] = { "FIN", "SYN", "RST", "PSH", "ACK", "URG", "ECE", "CWR", "AE" };
+        std::string set;
+        for (int bit = 8; bit >= 0; --bit) {
+            if (flags & (1u << bit)) {
+                set += set.empty() ? "" : ", ";
+                set += flagNames[bit];
+            }
+        }
+        int32_t flagField = out_.add(layer, format("Flags: 0x%03x (%s)", flags, set.c_str()), offset + 12, 2);
+        for (int bit = 8; bit >= 0; --bit) {
+            out_.add(flagField, format("%s: %s", flagNames[bit], (flags & (1u << bit)) ? "Set" : "Not set"),
+                     bit == 8 ? offset + 12 : offset + 13, 1);
+        }
+
+        out_.add(layer, format("Window: %u", read16(p + 14)), offset + 14, 2);
+        out_.add(layer, format("Checksum: 0x%04x", read16(p + 16)), offset + 16, 2);
+        out_.add(layer, format("Urgent Pointer: %u", read16(p + 18)), offset + 18, 2);
+
+        if (headerLength < 20) {
+            out_.add(layer, "[Malformed: header length below 20 bytes]", offset + 12, 1);
+            return;
+        }
+        if (!available(offset, headerLength)) {
+            truncated(layer, offset + 20);
+            return;
+        }
+        if (headerLength > 20) {
+            tcpOptions(layer, offset + 20, headerLength - 20);
+        }
+        if (segment > 0 && offset + headerLength < length_) {
+            out_.add(-1, format("TCP payload (%zu bytes)", std::min(end, length_) - offset - headerLength),
+                     offset + headerLength, std::min(end, length_) - offset - headerLength);
+        }
+    }
+
+    void udpLayer(size_t offset, size_t end) {
+        if (!available(offset, 8)) {
+            truncated(out_.add(-1, "User Datagram Protocol", offset, length_ - std::min(offset, length_)), offset);
+            return;
+        }
+
+        const uint8_t* p = data_ + offset;
+        int32_t layer = out_.add(-1, format("User Datagram Protocol, Src Port: %u, Dst Port: %u", read16(p), read16(p + 2)), offset, 8);
+        out_.add(layer, format("Source Port: %u", read16(p)), offset, 2);
+        out_.add(layer, format("Destination Port: %u", read16(p + 2)), offset + 2, 2);
+        out_.add(layer, format("Length: %u", read16(p + 4)), offset + 4, 2);
+        out_.add(layer, format("Checksum: 0x%04x", read16(p + 6)), offset + 6, 2);
+
+        const size_t stop = std::min(end, length_);
+        if (offset + 8 < stop) {
+            out_.add(-1, format("UDP payload (%zu bytes)", stop - offset - 8), offset + 8, stop - offset - 8);
+        }
+    }
+
+    void icmpLayer(uint8_t protocol, size_t offset, size_t end) {
+        const char* name = protocol == 58 ? "Internet Control Message Protocol v6" : "Internet Control Message Protocol";
+        if (!available(offset, 4)) {
+            truncated(out_.add(-1, name, offset, length_ - std::min(offset, length_)), offset);
+            return;
+        }
+
+        const uint8_t* p = data_ + offset;
+        const size_t stop = std::min(end, length_);
+        int32_t layer = out_.add(-1, name, offset, stop - offset);
+        out_.add(layer, format("Type: %u", p[0]), offset, 1);
+        out_.add(layer, format("Code: %u", p[1]), offset + 1, 1);
+        out_.add(layer, format("Checksum: 0x%04x", read16(p + 2)), offset + 2, 2);
+
+        // Echo request/reply for both ICMP versions carry an identifier and sequence number
+        const bool echo = protocol == 1 ? (p[0] == 0 || p[0] == 8) : (p[0] == 128 || p[0] == 129);
+        if (echo && available(offset, 8)) {
+            out_.add(layer, format("Identifier: 0x%04x", read16(p + 4)), offset + 4, 2);
+            out_.add(layer, format("Sequence Number: %u", read16(p + 6)), offset + 6, 2);
+            if (offset + 8 < stop) {
+                out_.add(layer, format("Data (%zu bytes)", stop - offset - 8), offset + 8, stop - offset - 8);
+            }
+        } else if (offset + 4 < stop) {
+            out_.add(layer, format("Message body (%zu bytes)", stop - offset - 4), offset + 4, stop - offset - 4);
+        }
+    }
+
+public:
+    static PacketDissection dissect(const uint8_t* data, size_t capturedLength, uint32_t wireLength) {
+        PacketDissection dissection;
+
+        int32_t frame = dissection.add(-1, format("Frame: %u bytes on wire, %zu bytes captured", wireLength, capturedLength), 0, capturedLength);
+        if (capturedLength < wireLength) {
+            dissection.add(frame, format("[Truncated by snap length: %u bytes missing]", static_cast<unsigned>(wireLength - capturedLength)), 0, 0);
+        }
+
+        if (data && capturedLength > 0) {
+            PacketDissector(dissection, data, capturedLength).ethernet();
+        }
+        return dissection;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,325 @@
+// PacketRecord.hpp - Fixed-layout binary packet summaries delivered to the model in batches
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "TPacketV3Capture.hpp"
+#include "ChecksumValidator.hpp"
+#include "Decapsulator.hpp"
+#include "FlowKey.hpp"
+#include "IpReassembler.hpp"
+#include "../protocols/DissectorRegistry.hpp"
+#include "../protocols/QuicConnectionTable.hpp"
+
+namespace PacketAnalyzer2026::Core {
+
+enum PacketFlags : uint16_t {
+    PACKET_TRUNCATED          = 1 << 0,    // Captured fewer bytes than were on the wire
+    PACKET_FRAGMENT           = 1 << 1,    // IP fragment, ports are not available
+    PACKET_MALFORMED          = 1 << 2,    // Headers shorter than their length fields claim
+    PACKET_REASSEMBLED        = 1 << 3,    // Last fragment of a datagram; columns and stored bytes are the whole datagram's
+    PACKET_BAD_CHECKSUM       = 1 << 4,    // IPv4 header or TCP/UDP checksum wrong (validation enabled only)
+    PACKET_CHECKSUM_OFFLOADED = 1 << 5     // Captured before the NIC filled in the TCP/UDP checksum
+};
+
+// Summary columns decoded on the capture path. Raw bytes live in the owning batch's arena.
+struct PacketRecord {
+    uint64_t number;
+    uint64_t timestampNs;
+    uint32_t wireLength;
+    uint32_t capturedLength;        // Bytes stored in the arena for this packet (the whole datagram if reassembled)
+    uint32_t dataOffset;            // Offset of those bytes in PacketBatch::bytes
+    uint16_t etherType;
+    uint16_t sourcePort;
+    uint16_t destPort;
+    uint8_t ipVersion;              // 4, 6 or 0 for non-IP frames
+    uint8_t ipProtocol;
+    uint8_t tcpFlags;
+    uint8_t appProtocol;            // Protocols::ProtocolId, 0 when unclassified
+    uint16_t flags;                 // PacketFlags
+    uint8_t sourceAddress[16];      // IPv4 addresses use the first 4 bytes
+    uint8_t destAddress[16];
+    uint32_t flowHash;              // Kernel rx hash when available
+    uint32_t encapsulation;         // EncapsulationStack::packed; addresses and ports are the innermost
+};
+
+static_assert(sizeof(PacketRecord) == 80, "PacketRecord layout must stay fixed");
+
+struct PacketBatch {
+    std::vector<PacketRecord> records;
+    std::vector<uint8_t> bytes;
+
+    const uint8_t* data(const PacketRecord& record) const {
+        return bytes.data() + record.dataOffset;
+    }
+
+    size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+};
+
+// Batches are immutable once published, so a queued signal only copies this pointer
+using PacketBatchPtr = std::shared_ptr<const PacketBatch>;
+
+class PacketRecordDecoder {
+private:
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+    static void decodeTransport(PacketRecord& record, const uint8_t* l4, size_t available) {
+        using Protocols::DissectorRegistry;
+        using Protocols::Transport;
+
+        if (record.ipProtocol == 6 && available >= 14) {
+            record.sourcePort = read16(l4);
+            record.destPort = read16(l4 + 2);
+            record.tcpFlags = l4[13];
+            const size_t dataOffset = static_cast<size_t>(l4[12] >> 4) * 4;
+            if (dataOffset >= 20 && dataOffset < available) {
+                record.appProtocol = static_cast<uint8_t>(DissectorRegistry::classify(
+                    Transport::TCP, record.sourcePort, record.destPort, ByteView(l4 + dataOffset, available - dataOffset)));
+            }
+        } else if (record.ipProtocol == 17 && available >= 4) {
+            record.sourcePort = read16(l4);
+            record.destPort = read16(l4 + 2);
+            if (available > 8) {
+                record.appProtocol = static_cast<uint8_t>(DissectorRegistry::classify(
+                    Transport::UDP, record.sourcePort, record.destPort, ByteView(l4 + 8, available - 8)));
+            }
+        } else if ((record.ipProtocol == 6 || record.ipProtocol == 17) && available < 4) {
+            record.flags |= PACKET_MALFORMED;
+        }
+    }
+
+public:
+    // Decodes only the summary columns of the innermost packet; deep dissection happens on
+    // selection. Returns the frame offset of the innermost network header.
+    static size_t decode(PacketRecord& record, const uint8_t* frame, size_t length) {
+        if (length < 14) {
+            record.flags |= PACKET_MALFORMED;
+            return 0;
+        }
+
+        const Decapsulated inner = Decapsulator::peel(ByteView(frame, length));
+        record.etherType = inner.etherType;
+        record.encapsulation = inner.stack.packed;
+        const uint8_t* l3 = frame + inner.l3Offset;
+        size_t available = length - inner.l3Offset;
+
+        if (record.etherType == 0x0800 && available >= 20) {
+            size_t ihl = static_cast<size_t>(l3[0] & 0x0F) * 4;
+            record.ipVersion = 4;
+            record.ipProtocol = l3[9];
+            std::memcpy(record.sourceAddress, l3 + 12, 4);
+            std::memcpy(record.destAddress, l3 + 16, 4);
+            if (ihl < 20 || ihl > available) {
+                record.flags |= PACKET_MALFORMED;
+                return inner.l3Offset;
+            }
+            if ((read16(l3 + 6) & 0x1FFF) != 0) {
+                record.flags |= PACKET_FRAGMENT;
+                return inner.l3Offset;
+            }
+            decodeTransport(record, l3 + ihl, available - ihl);
+        } else if (record.etherType == 0x86DD && available >= 40) {
+            record.ipVersion = 6;
+            record.ipProtocol = l3[6];
+            std::memcpy(record.sourceAddress, l3 + 8, 16);
+            std::memcpy(record.destAddress, l3 + 24, 16);
+            decodeTransport(record, l3 + 40, available - 40);
+        } else if (record.etherType == 0x0800 || record.etherType == 0x86DD) {
+            record.flags |= PACKET_MALFORMED;
+        }
+        return inner.l3Offset;
+    }
+};
+
+// Accumulates ring frames into a batch on one capture thread, then hands it off in one piece
+class PacketBatchBuilder {
+private:
+    std::shared_ptr<PacketBatch> batch_;
+    size_t maxPackets_;
+    uint32_t maxStoredBytes_;
+    std::chrono::steady_clock::duration maxLatency_;
+    std::chrono::steady_clock::time_point firstPacketTime_;
+    Protocols::QuicConnectionTable quicConnections_;
+    IpReassembler fragments_;
+    std::atomic<bool> validateChecksums_{false};     // Set from the control thread, read per packet
+    uint64_t lastQuicExpiryNs_ = 0;
+
+    static constexpr uint64_t QUIC_EXPIRY_INTERVAL_NS = 5ull * 1000000000ull;
+
+    void reset() {
+        batch_ = std::make_shared<PacketBatch>();
+        batch_->records.reserve(maxPackets_);
+        batch_->bytes.reserve(maxPackets_ * 256);
+    }
+
+public:
+    explicit PacketBatchBuilder(size_t maxPackets = 512,
+                                uint32_t maxStoredBytes = 65535,
+                                std::chrono::milliseconds maxLatency = std::chrono::milliseconds(20))
+        : maxPackets_(maxPackets)
+        , maxStoredBytes_(maxStoredBytes)
+        , maxLatency_(maxLatency)
+    {
+        reset();
+    }
+
+    // QUIC is grouped by connection ID, so a connection keeps one flowHash across migration
+    // and NAT rebinding, and short headers on unregistered ports are still recognized
+    void trackQuic(PacketRecord& record, const CapturedFrame& frame, size_t l3Offset) {
+        if (record.ipProtocol != 17 || (record.flags & (PACKET_FRAGMENT | PACKET_MALFORMED))) return;
+
+        const size_t udpOffset = l3Offset + (record.ipVersion == 4 ? static_cast<size_t>(frame.data[l3Offset] & 0x0F) * 4 : 40);
+        if (frame.capturedLength <= udpOffset + 8) return;
+
+        FlowKey path;
+        const uint8_t direction = FlowKey::make(path, record.ipVersion, 17, record.sourceAddress, record.sourcePort,
+                                                record.destAddress, record.destPort);
+        const bool classified = record.appProtocol == static_cast<uint8_t>(Protocols::ProtocolId::QUIC);
+        if (!classified && !quicConnections_.knowsPath(path)) return;
+
+        const ByteView datagram(frame.data + udpOffset + 8, frame.capturedLength - udpOffset - 8);
+        const uint32_t connection = quicConnections_.track(path, direction, datagram, frame.timestampNs);
+        if (connection != Protocols::QuicConnectionTable::NONE) {
+            record.flowHash = quicConnections_.connection(connection).flowHash;
+            record.appProtocol = static_cast<uint8_t>(Protocols::ProtocolId::QUIC);
+        }
+
+        if (frame.timestampNs - lastQuicExpiryNs_ > QUIC_EXPIRY_INTERVAL_NS) {
+            quicConnections_.expireIdle(frame.timestampNs);
+            lastQuicExpiryNs_ = frame.timestampNs;
+        }
+    }
+
+    void validateChecksum(PacketRecord& record, ByteView frame, size_t l3Offset, uint8_t captureState) {
+        switch (ChecksumValidator::validate(frame, l3Offset, static_cast<CaptureChecksumState>(captureState))) {
+            case ChecksumStatus::Bad:       record.flags |= PACKET_BAD_CHECKSUM; break;
+            case ChecksumStatus::Offloaded: record.flags |= PACKET_CHECKSUM_OFFLOADED; break;
+            default: break;
+        }
+    }
+
+    // The fragment that completes a datagram takes the transport and application columns of
+    // the whole datagram, and stores the reassembled frame in place of its own bytes so the
+    // parsing stage sees the full payload. wireLength stays the fragment's, so flow byte counts
+    // are not inflated. Returns true when the bytes were stored here.
+    bool reassemble(PacketRecord& record, const CapturedFrame& frame, size_t l3Offset) {
+        bool stored = false;
+        const FragmentResult result = fragments_.process(ByteView(frame.data, frame.capturedLength), l3Offset, frame.timestampNs,
+                                                         [&](ByteView datagram) {
+            PacketRecord whole{};
+            const size_t wholeL3Offset = PacketRecordDecoder::decode(whole, datagram.data, datagram.size);
+            if (whole.flags & PACKET_MALFORMED) return;
+
+            record.ipProtocol = whole.ipProtocol;
+            record.sourcePort = whole.sourcePort;
+            record.destPort = whole.destPort;
+            record.tcpFlags = whole.tcpFlags;
+            record.appProtocol = whole.appProtocol;
+            record.flags = static_cast<uint16_t>((record.flags & ~PACKET_FRAGMENT) | PACKET_REASSEMBLED);
+            if (validateChecksums_.load(std::memory_order_relaxed)) {
+                validateChecksum(record, datagram, wholeL3Offset, CAPTURE_CHECKSUM_UNKNOWN);
+            }
+
+            CapturedFrame reassembled = frame;
+            reassembled.data = datagram.data;
+            reassembled.capturedLength = static_cast<uint32_t>(datagram.size);
+            trackQuic(record, reassembled, wholeL3Offset);
+
+            record.capturedLength = std::min(reassembled.capturedLength, maxStoredBytes_);
+            batch_->bytes.insert(batch_->bytes.end(), datagram.data, datagram.data + record.capturedLength);
+            stored = true;
+        });
+
+        if (result == FragmentResult::NotFragment) {
+            trackQuic(record, frame, l3Offset);
+        } else if (result != FragmentResult::Reassembled) {
+            record.flags |= PACKET_FRAGMENT;
+        }
+        return stored;
+    }
+
+    void append(const CapturedFrame& frame) {
+        if (batch_->records.empty()) {
+            firstPacketTime_ = std::chrono::steady_clock::now();
+        }
+
+        PacketRecord record{};
+        record.timestampNs = frame.timestampNs;
+        record.wireLength = frame.wireLength;
+        record.capturedLength = std::min(frame.capturedLength, maxStoredBytes_);
+        record.dataOffset = static_cast<uint32_t>(batch_->bytes.size());
+        record.flowHash = frame.rxHash;
+        if (frame.capturedLength < frame.wireLength) {
+            record.flags |= PACKET_TRUNCATED;
+        }
+        const size_t l3Offset = PacketRecordDecoder::decode(record, frame.data, frame.capturedLength);
+        bool stored = false;
+        if (frame.vlanTci != 0 || frame.vlanTpid != 0) {
+            // The kernel strips the outermost tag into the frame header; it goes first in the stack
+            record.encapsulation = (record.encapsulation << 4) | (frame.vlanTpid == 0x88A8 ? ENCAP_QINQ : ENCAP_VLAN);
+        }
+        if (record.ipVersion != 0 && !(record.flags & (PACKET_TRUNCATED | PACKET_MALFORMED))) {
+            if (validateChecksums_.load(std::memory_order_relaxed)) {
+                validateChecksum(record, ByteView(frame.data, frame.capturedLength), l3Offset, frame.checksumState);
+            }
+            stored = reassemble(record, frame, l3Offset);
+        } else {
+            trackQuic(record, frame, l3Offset);
+        }
+
+        if (!stored) {
+            batch_->bytes.insert(batch_->bytes.end(), frame.data, frame.data + record.capturedLength);
+        }
+        batch_->records.push_back(record);
+    }
+
+    // Full batches go out immediately; partial ones once the oldest packet has waited maxLatency
+    bool shouldFlush() const {
+        if (batch_->records.empty()) return false;
+        return batch_->records.size() >= maxPackets_ ||
+               std::chrono::steady_clock::now() - firstPacketTime_ >= maxLatency_;
+    }
+
+    const Protocols::QuicConnectionTable& quicConnections() const {
+        return quicConnections_;
+    }
+
+    // Off by default: a full pass over every TCP/UDP payload is the one stage that touches
+    // all bytes. Flags packets with PACKET_BAD_CHECKSUM or PACKET_CHECKSUM_OFFLOADED. Safe to
+    // call while the capture thread is appending; applies from the next packet.
+    void setChecksumValidation(bool enabled) {
+        validateChecksums_.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool checksumValidation() const {
+        return validateChecksums_.load(std::memory_order_relaxed);
+    }
+
+    const IpReassembler& fragments() const {
+        return fragments_;
+    }
+
+    size_t pending() const {
+        return batch_->records.size();
+    }
+
+    // Numbers the packets from a sequence shared by all capture workers and publishes the batch
+    PacketBatchPtr take(std::atomic<uint64_t>& sequence) {
+        uint64_t first = sequence.fetch_add(batch_->records.size(), std::memory_order_relaxed) + 1;
+        for (auto& record : batch_->records) {
+            record.number = first++;
+        }
+        PacketBatchPtr published = std::move(batch_);
+        reset();
+        return published;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Core
@@ -0,0 +1,542 @@
+// TcpReassembler.hpp - Per-flow TCP stream reassembly over a fixed-budget buffer pool
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "ByteView.hpp"
+#include "Decapsulator.hpp"
+#include "FlowKey.hpp"
+#include "../performance/BufferPool.hpp"
+
+namespace PacketAnalyzer2026::Core {
+
+enum TcpFlags : uint8_t {
+    TCP_FIN = 0x01,
+    TCP_SYN = 0x02,
+    TCP_RST = 0x04,
+    TCP_PSH = 0x08,
+    TCP_ACK = 0x10
+};
+
+// One TCP segment located in a captured frame; payload points into the frame
+struct TcpSegment {
+    FlowKey key;
+    uint8_t direction;
+    uint8_t flags;
+    uint32_t sequence;
+    ByteView payload;
+    uint64_t timestampNs;
+
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+    static uint32_t read32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    // Ethernet, possibly tunneled (see Decapsulator); the innermost packet must be IPv4
+    // without fragmentation or IPv6 without extension headers
+    static bool fromFrame(ByteView frame, uint64_t timestampNs, TcpSegment& out) {
+        if (frame.size < 14) return false;
+        const Decapsulated inner = Decapsulator::peel(frame);
+        const uint16_t etherType = inner.etherType;
+
+        const uint8_t* l3 = frame.data + inner.l3Offset;
+        size_t available = frame.size - inner.l3Offset;
+        const uint8_t* source;
+        const uint8_t* dest;
+        uint8_t ipVersion;
+        size_t l4Offset;
+        size_t ipEnd = available;
+
+        if (etherType == 0x0800 && available >= 20) {
+            const size_t ihl = static_cast<size_t>(l3[0] & 0x0F) * 4;
+            if (l3[9] != 6 || ihl < 20 || ihl > available || (read16(l3 + 6) & 0x3FFF) != 0) return false;
+            const uint16_t totalLength = read16(l3 + 2);
+            if (totalLength >= ihl && totalLength < available) ipEnd = totalLength;   // Strip Ethernet padding
+            source = l3 + 12;
+            dest = l3 + 16;
+            ipVersion = 4;
+            l4Offset = ihl;
+        } else if (etherType == 0x86DD && available >= 40) {
+            if (l3[6] != 6) return false;
+            const size_t payloadLength = read16(l3 + 4);
+            if (40 + payloadLength < available) ipEnd = 40 + payloadLength;
+            source = l3 + 8;
+            dest = l3 + 24;
+            ipVersion = 6;
+            l4Offset = 40;
+        } else {
+            return false;
+        }
+
+        if (ipEnd < l4Offset + 20) return false;
+        const uint8_t* tcp = l3 + l4Offset;
+        const size_t dataOffset = static_cast<size_t>(tcp[12] >> 4) * 4;
+        if (dataOffset < 20 || l4Offset + dataOffset > ipEnd) return false;
+
+        const uint16_t sourcePort = read16(tcp);
+        const uint16_t destPort = read16(tcp + 2);
+        out.direction = FlowKey::make(out.key, ipVersion, 6, source, sourcePort, dest, destPort);
+        out.flags = tcp[13];
+        out.sequence = read32(tcp + 4);
+        out.payload = ByteView(tcp + dataOffset, ipEnd - l4Offset - dataOffset);
+        out.timestampNs = timestampNs;
+        return true;
+    }
+};
+
+struct ReassemblyConfig {
+    size_t bufferBudget = 256u << 20;       // Pool bytes for all flows of this reassembler
+    uint32_t blockSize = 2048;              // Pool block size; one MSS-sized segment per block
+    uint32_t maxStreamBuffer = 256u << 10;  // Per direction: unconsumed plus out-of-order bytes
+    size_t maxFlows = 1u << 21;             // New flows beyond this are not tracked
+    uint64_t idleTimeoutNs = 120ull * 1000000000ull;
+};
+
+struct ReassemblyStatistics {
+    uint64_t segments = 0;
+    uint64_t deliveredBytes = 0;
+    uint64_t zeroCopyBytes = 0;             // Delivered straight from the capture buffer
+    uint64_t outOfOrderSegments = 0;
+    uint64_t retransmittedSegments = 0;
+    uint64_t gaps = 0;
+    uint64_t gapBytes = 0;
+    uint64_t bufferDrops = 0;               // Segments or carries dropped for lack of pool space
+    uint64_t flowsRejected = 0;
+    uint64_t flowsExpired = 0;
+    size_t activeFlows = 0;
+    size_t poolBytesInUse = 0;
+};
+
+// Handed to the stream handler with every callback. protocol, handlerState and handlerBytes
+// belong to the handler and persist with the stream, so parsers keep no per-flow maps of
+// their own.
+struct StreamContext {
+    const FlowKey& key;
+    uint8_t direction;
+    uint8_t& protocol;
+    uint16_t& handlerState;
+    uint64_t& handlerBytes;         // E.g. body bytes left to skip
+    uint64_t timestampNs;
+};
+
+// Reassembles both directions of every TCP flow and hands ordered bytes to StreamHandler:
+//
+//   size_t onData(StreamContext&, ByteView)    returns bytes consumed; the rest is kept and
+//                                              offered again, extended, with the next data
+//   void onGap(StreamContext&, uint32_t)       bytes that will never arrive were skipped
+//   void onClose(const FlowKey&)               flow finished, reset or expired
+//
+// In-order segments with nothing held back are passed straight from the capture buffer.
+// Out-of-order segments and unconsumed tails are copied into pool blocks, bounded per stream
+// by maxStreamBuffer and globally by bufferBudget. Single-threaded: one instance per worker.
+template<typename StreamHandler>
+class TcpReassembler {
+private:
+    static constexpr uint32_t NONE = Performance::BufferPool::NONE;
+
+    enum StreamFlags : uint8_t {
+        STREAM_INITIALIZED = 1 << 0,
+        STREAM_FIN = 1 << 1,
+        STREAM_CLOSED = 1 << 2
+    };
+
+    // Header stored at the start of the first block of each out-of-order segment chain
+    struct SegmentHeader {
+        uint32_t sequence;
+        uint32_t length;
+        uint32_t nextSegment;
+    };
+
+    struct StreamState {
+        uint32_t nextSequence = 0;
+        uint32_t finSequence = 0;
+        uint32_t carryHead = NONE;          // Unconsumed in-order bytes, from offset 0 of the head block
+        uint32_t carryTail = NONE;
+        uint32_t carryBytes = 0;
+        uint32_t segmentsHead = NONE;       // Out-of-order segments sorted by sequence
+        uint32_t segmentBytes = 0;
+        uint64_t handlerBytes = 0;
+        uint16_t handlerState = 0;
+        uint8_t protocol = 0;
+        uint8_t flags = 0;
+    };
+
+    struct Flow {
+        StreamState streams[2];
+        uint64_t lastSeenNs = 0;
+    };
+
+    ReassemblyConfig config_;
+    Performance::BufferPool pool_;
+    StreamHandler& handler_;
+    std::unordered_map<FlowKey, Flow, FlowKeyHash> flows_;
+    std::vector<uint8_t> carryScratch_;
+    std::vector<uint8_t> segmentScratch_;
+    ReassemblyStatistics stats_;
+
+    static bool before(uint32_t a, uint32_t b) { return static_cast<int32_t>(a - b) < 0; }
+
+    size_t headerSize() const { return sizeof(SegmentHeader); }
+
+    // Copies data into a new chain, starting `skip` bytes into the first block. NONE on exhaustion.
+    uint32_t writeChain(ByteView data, size_t skip, uint32_t& tail) {
+        uint32_t head = pool_.allocate();
+        if (head == NONE) return NONE;
+
+        uint32_t block = head;
+        size_t position = skip;
+        size_t written = 0;
+        while (true) {
+            const size_t take = std::min(data.size - written, static_cast<size_t>(pool_.blockSize()) - position);
+            std::memcpy(pool_.data(block) + position, data.data + written, take);
+            written += take;
+            if (written == data.size) break;
+
+            uint32_t following = pool_.allocate();
+            if (following == NONE) {
+                pool_.releaseChain(head);
+                return NONE;
+            }
+            pool_.link(block, following);
+            block = following;
+            position = 0;
+        }
+        tail = block;
+        return head;
+    }
+
+    // Copies length bytes out of a chain, starting `skip` bytes into the first block
+    void readChain(uint32_t head, size_t skip, size_t length, uint8_t* out) const {
+        uint32_t block = head;
+        size_t position = skip;
+        while (length > 0 && block != NONE) {
+            if (position >= pool_.blockSize()) {
+                position -= pool_.blockSize();
+                block = pool_.next(block);
+                continue;
+            }
+            const size_t take = std::min(length, static_cast<size_t>(pool_.blockSize()) - position);
+            std::memcpy(out, pool_.data(block) + position, take);
+            out += take;
+            length -= take;
+            position = 0;
+            block = pool_.next(block);
+        }
+    }
+
+    void releaseCarry(StreamState& stream) {
+        pool_.releaseChain(stream.carryHead);
+        stream.carryHead = stream.carryTail = NONE;
+        stream.carryBytes = 0;
+    }
+
+    void releaseSegments(StreamState& stream) {
+        uint32_t segment = stream.segmentsHead;
+        while (segment != NONE) {
+            uint32_t following = reinterpret_cast<const SegmentHeader*>(pool_.data(segment))->nextSegment;
+            pool_.releaseChain(segment);
+            segment = following;
+        }
+        stream.segmentsHead = NONE;
+        stream.segmentBytes = 0;
+    }
+
+    StreamContext context(const FlowKey& key, uint8_t direction, StreamState& stream, uint64_t timestampNs) {
+        return StreamContext{ key, direction, stream.protocol, stream.handlerState, stream.handlerBytes, timestampNs };
+    }
+
+    // Keeps the bytes the handler did not consume; on overflow or exhaustion they are dropped as a gap
+    void keepTail(const FlowKey& key, uint8_t direction, StreamState& stream, ByteView tail, uint64_t timestampNs) {
+        if (tail.empty()) return;
+
+        uint32_t tailBlock = NONE;
+        uint32_t head = tail.size <= config_.maxStreamBuffer ? writeChain(tail, 0, tailBlock) : NONE;
+        if (head == NONE) {
+            stats_.bufferDrops++;
+            skipGap(key, direction, stream, static_cast<uint32_t>(tail.size), timestampNs);
+            return;
+        }
+        stream.carryHead = head;
+        stream.carryTail = tailBlock;
+        stream.carryBytes = static_cast<uint32_t>(tail.size);
+    }
+
+    void deliver(const FlowKey& key, uint8_t direction, StreamState& stream, ByteView data, bool fromCapture, uint64_t timestampNs) {
+        StreamContext ctx = context(key, direction, stream, timestampNs);
+        stats_.deliveredBytes += data.size;
+
+        if (stream.carryBytes == 0) {
+            // Fast path: the handler reads the bytes where they already are
+            if (fromCapture) stats_.zeroCopyBytes += data.size;
+            const size_t used = std::min(handler_.onData(ctx, data), data.size);
+            keepTail(key, direction, stream, data.subview(used), timestampNs);
+            return;
+        }
+
+        const size_t total = static_cast<size_t>(stream.carryBytes) + data.size;
+        if (total > config_.maxStreamBuffer) {
+            // The handler cannot make progress within the per-stream bound; resynchronize
+            stats_.bufferDrops++;
+            const uint32_t dropped = stream.carryBytes;
+            releaseCarry(stream);
+            skipGap(key, direction, stream, dropped, timestampNs);
+            deliver(key, direction, stream, data, fromCapture, timestampNs);
+            return;
+        }
+
+        // Slow path: one linear copy of held-back bytes plus the new data
+        carryScratch_.resize(total);
+        readChain(stream.carryHead, 0, stream.carryBytes, carryScratch_.data());
+        std::memcpy(carryScratch_.data() + stream.carryBytes, data.data, data.size);
+        releaseCarry(stream);
+
+        ByteView linear(carryScratch_.data(), total);
+        const size_t used = std::min(handler_.onData(ctx, linear), total);
+        keepTail(key, direction, stream, linear.subview(used), timestampNs);
+    }
+
+    void skipGap(const FlowKey& key, uint8_t direction, StreamState& stream, uint32_t missing, uint64_t timestampNs) {
+        stats_.gaps++;
+        stats_.gapBytes += missing;
+        StreamContext ctx = context(key, direction, stream, timestampNs);
+        handler_.onGap(ctx, missing);
+    }
+
+    // Delivers queued out-of-order segments that have become contiguous
+    void drainSegments(const FlowKey& key, uint8_t direction, StreamState& stream, uint64_t timestampNs) {
+        while (stream.segmentsHead != NONE) {
+            uint32_t segment = stream.segmentsHead;
+            const SegmentHeader header = *reinterpret_cast<const SegmentHeader*>(pool_.data(segment));
+            if (before(stream.nextSequence, header.sequence)) break;
+
+            stream.segmentsHead = header.nextSegment;
+            stream.segmentBytes -= header.length;
+
+            const uint32_t overlap = stream.nextSequence - header.sequence;
+            if (overlap < header.length) {
+                const uint32_t length = header.length - overlap;
+                segmentScratch_.resize(length);
+                readChain(segment, headerSize() + overlap, length, segmentScratch_.data());
+                pool_.releaseChain(segment);
+                stream.nextSequence += length;
+                deliver(key, direction, stream, ByteView(segmentScratch_.data(), length), false, timestampNs);
+            } else {
+                pool_.releaseChain(segment);
+            }
+        }
+    }
+
+    // Gives up on the hole before the first queued segment and continues from there. Segments
+    // that the stream has already caught up with are delivered or released first, so the
+    // hole is never measured backwards.
+    void skipToFirstSegment(const FlowKey& key, uint8_t direction, StreamState& stream, uint64_t timestampNs) {
+        drainSegments(key, direction, stream, timestampNs);
+        if (stream.segmentsHead == NONE) return;
+        const uint32_t first = reinterpret_cast<const SegmentHeader*>(pool_.data(stream.segmentsHead))->sequence;
+        const uint32_t carried = stream.carryBytes;
+        releaseCarry(stream);
+        skipGap(key, direction, stream, (first - stream.nextSequence) + carried, timestampNs);
+        stream.nextSequence = first;
+        drainSegments(key, direction, stream, timestampNs);
+    }
+
+    bool queueSegment(StreamState& stream, uint32_t sequence, ByteView payload) {
+        // Exact duplicates of a queued segment are retransmissions
+        uint32_t* link = &stream.segmentsHead;
+        while (*link != NONE) {
+            SegmentHeader* header = reinterpret_cast<SegmentHeader*>(pool_.data(*link));
+            if (header->sequence == sequence && header->length >= payload.size) {
+                stats_.retransmittedSegments++;
+                return true;
+            }
+            if (before(sequence, header->sequence)) break;
+            link = &header->nextSegment;
+        }
+
+        uint32_t tail = NONE;
+        uint32_t segment = writeChain(payload, headerSize(), tail);
+        if (segment == NONE) {
+            stats_.bufferDrops++;
+            return false;
+        }
+
+        SegmentHeader* header = reinterpret_cast<SegmentHeader*>(pool_.data(segment));
+        header->sequence = sequence;
+        header->length = static_cast<uint32_t>(payload.size);
+        header->nextSegment = *link;
+        *link = segment;
+        stream.segmentBytes += header->length;
+        stats_.outOfOrderSegments++;
+        return true;
+    }
+
+    void closeFlow(typename std::unordered_map<FlowKey, Flow, FlowKeyHash>::iterator it) {
+        // Whatever was queued behind a hole is still worth handing over before the flow goes
+        for (uint8_t direction = 0; direction < 2; ++direction) {
+            StreamState& stream = it->second.streams[direction];
+            while (stream.segmentsHead != NONE) {
+                skipToFirstSegment(it->first, direction, stream, it->second.lastSeenNs);
+            }
+        }
+        for (StreamState& stream : it->second.streams) {
+            releaseCarry(stream);
+            releaseSegments(stream);
+        }
+        handler_.onClose(it->first);
+        flows_.erase(it);
+    }
+
+public:
+    TcpReassembler(StreamHandler& handler, const ReassemblyConfig& config = ReassemblyConfig{})
+        : config_(config)
+        , pool_(config.bufferBudget, config.blockSize, "TCP reassembly")
+        , handler_(handler)
+    {
+        if (config_.blockSize <= sizeof(SegmentHeader)) {
+            throw std::invalid_argument("Reassembly block size must exceed the segment header");
+        }
+        flows_.reserve(std::min<size_t>(config_.maxFlows, 1u << 16));
+    }
+
+    TcpReassembler(const TcpReassembler&) = delete;
+    TcpReassembler& operator=(const TcpReassembler&) = delete;
+
+    ~TcpReassembler() {
+        clear();
+    }
+
+    void process(const TcpSegment& segment) {
+        stats_.segments++;
+
+        auto it = flows_.find(segment.key);
+        if (it == flows_.end()) {
+            if (segment.flags & TCP_RST) return;
+            if (flows_.size() >= config_.maxFlows) {
+                stats_.flowsRejected++;
+                return;
+            }
+            it = flows_.emplace(segment.key, Flow{}).first;
+        }
+
+        Flow& flow = it->second;
+        flow.lastSeenNs = segment.timestampNs;
+        StreamState& stream = flow.streams[segment.direction];
+        const FlowKey& key = it->first;
+
+        if (segment.flags & TCP_RST) {
+            closeFlow(it);
+            return;
+        }
+
+        uint32_t sequence = segment.sequence;
+        if (segment.flags & TCP_SYN) {
+            // A SYN consumes one sequence number; data starts after it
+            stream.nextSequence = sequence + 1;
+            stream.flags = STREAM_INITIALIZED;
+            sequence += 1;
+        } else if (!(stream.flags & STREAM_INITIALIZED)) {
+            // Picked up mid-connection: start at the first segment seen
+            stream.nextSequence = sequence;
+            stream.flags |= STREAM_INITIALIZED;
+        }
+
+        if (segment.flags & TCP_FIN) {
+            stream.finSequence = sequence + static_cast<uint32_t>(segment.payload.size);
+            stream.flags |= STREAM_FIN;
+        }
+
+        ByteView payload = segment.payload;
+        if (!payload.empty()) {
+            const int32_t offset = static_cast<int32_t>(sequence - stream.nextSequence);
+
+            if (offset <= 0) {
+                const uint32_t overlap = static_cast<uint32_t>(-offset);
+                if (overlap >= payload.size) {
+                    stats_.retransmittedSegments++;
+                } else {
+                    payload = payload.subview(overlap);
+                    stream.nextSequence += static_cast<uint32_t>(payload.size);
+                    deliver(key, segment.direction, stream, payload, true, segment.timestampNs);
+                    drainSegments(key, segment.direction, stream, segment.timestampNs);
+                }
+            } else if (static_cast<uint64_t>(offset) + payload.size + stream.segmentBytes > config_.maxStreamBuffer) {
+                // Hole too large to wait for: deliver what is queued, then jump past the hole
+                skipToFirstSegment(key, segment.direction, stream, segment.timestampNs);
+                const int32_t remaining = static_cast<int32_t>(sequence - stream.nextSequence);
+                if (remaining > 0) {
+                    const uint32_t carried = stream.carryBytes;
+                    releaseCarry(stream);
+                    skipGap(key, segment.direction, stream, static_cast<uint32_t>(remaining) + carried, segment.timestampNs);
+                    stream.nextSequence = sequence;
+                }
+                if (!before(sequence + static_cast<uint32_t>(payload.size), stream.nextSequence + 1)) {
+                    const uint32_t overlap = stream.nextSequence - sequence;
+                    payload = payload.subview(overlap);
+                    stream.nextSequence += static_cast<uint32_t>(payload.size);
+                    deliver(key, segment.direction, stream, payload, true, segment.timestampNs);
+                    drainSegments(key, segment.direction, stream, segment.timestampNs);
+                }
+            } else if (!queueSegment(stream, sequence, payload)) {
+                // Pool exhausted: this segment becomes part of the hole
+                skipToFirstSegment(key, segment.direction, stream, segment.timestampNs);
+            }
+        }
+
+        // A hole before the FIN may still be retransmitted; it is skipped when the flow closes or expires
+        if ((stream.flags & STREAM_FIN) && stream.nextSequence == stream.finSequence) {
+            stream.flags |= STREAM_CLOSED;
+        }
+
+        if ((flow.streams[0].flags & STREAM_CLOSED) && (flow.streams[1].flags & STREAM_CLOSED)) {
+            closeFlow(it);
+        }
+    }
+
+    bool process(ByteView frame, uint64_t timestampNs) {
+        TcpSegment segment;
+        if (!TcpSegment::fromFrame(frame, timestampNs, segment)) {
+            return false;
+        }
+        process(segment);
+        return true;
+    }
+
+    // Closes flows idle for longer than idleTimeoutNs; call periodically from the owning worker
+    size_t expireIdle(uint64_t nowNs) {
+        size_t expired = 0;
+        for (auto it = flows_.begin(); it != flows_.end();) {
+            auto current = it++;
+            if (nowNs - current->second.lastSeenNs > config_.idleTimeoutNs) {
+                closeFlow(current);
+                expired++;
+            }
+        }
+        stats_.flowsExpired += expired;
+        return expired;
+    }
+
+    // Closes every flow, as at the end of a capture
+    void clear() {
+        while (!flows_.empty()) {
+            closeFlow(flows_.begin());
+        }
+        stats_ = ReassemblyStatistics{};
+    }
+
+    size_t flowCount() const { return flows_.size(); }
+
+    ReassemblyStatistics statistics() const {
+        ReassemblyStatistics stats = stats_;
+        stats.activeFlows = flows_.size();
+        stats.poolBytesInUse = pool_.bytesInUse();
+        return stats;
+    }
+
+    const Performance::BufferPool& pool() const { return pool_; }
+};
+
+} // namespace PacketAnalyzer2026::Core
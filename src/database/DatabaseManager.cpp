@@ -89,6 +89,7 @@ bool DatabaseManager::createTables()
             R"(CREATE TABLE IF NOT EXISTS packet_metadata (
                 id INTEGER PRIMARY KEY AUTOINCREMENT,
                 session_id INTEGER NOT NULL,
+                row_ordinal INTEGER,
                 packet_number INTEGER NOT NULL,
                 timestamp_ns INTEGER NOT NULL,
                 size_bytes INTEGER NOT NULL,
@@ -148,6 +149,39 @@ bool DatabaseManager::createTables()
         }
     }
     
+    return createPacketOrdinals();
+}
+
+// row_ordinal numbers a session's packets 0, 1, 2, ... in insertion order, so a table row is
+// its own keyset key and any page is one indexed range read. Databases created before the
+// column existed get it added and filled in packet order once.
+bool DatabaseManager::createPacketOrdinals()
+{
+    QSqlQuery query(m_database);
+    bool hasOrdinal = false;
+    if (query.exec("PRAGMA table_info(packet_metadata)")) {
+        while (query.next()) {
+            hasOrdinal = hasOrdinal || query.value(1).toString() == "row_ordinal";
+        }
+    }
+
+    if (!hasOrdinal) {
+        if (!query.exec("ALTER TABLE packet_metadata ADD COLUMN row_ordinal INTEGER") ||
+            !query.exec(R"(UPDATE packet_metadata SET row_ordinal = numbered.ordinal
+                           FROM (SELECT id, ROW_NUMBER() OVER (PARTITION BY session_id
+                                                               ORDER BY packet_number, id) - 1 AS ordinal
+                                 FROM packet_metadata) AS numbered
+                           WHERE numbered.id = packet_metadata.id)")) {
+            qDebug() << "Failed to add packet ordinals:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    if (!query.exec(R"(CREATE UNIQUE INDEX IF NOT EXISTS idx_packet_metadata_session_ordinal
+                        ON packet_metadata (session_id, row_ordinal))")) {
+        qDebug() << "Failed to create packet ordinal index:" << query.lastError().text();
+        return false;
+    }
     return true;
 }
 
@@ -220,10 +254,12 @@ int DatabaseManager::createCaptureSession(int userId, const QString& sessionName
 bool DatabaseManager::insertPacketMetadata(int sessionId, const QJsonObject& packetData)
 {
     QSqlQuery query(m_database);
+    // The next ordinal is one index seek on (session_id, row_ordinal)
     query.prepare(R"(INSERT INTO packet_metadata 
-        (session_id, packet_number, timestamp_ns, size_bytes, protocol, source_ip, dest_ip, source_port, dest_port, application) 
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?))");
+        (session_id, row_ordinal, packet_number, timestamp_ns, size_bytes, protocol, source_ip, dest_ip, source_port, dest_port, application) 
+        VALUES (?, (SELECT COALESCE(MAX(row_ordinal) + 1, 0) FROM packet_metadata WHERE session_id = ?), ?, ?, ?, ?, ?, ?, ?, ?, ?))");
     
+    query.addBindValue(sessionId);
     query.addBindValue(sessionId);
     query.addBindValue(packetData["number"].toInt());
     query.addBindValue(QDateTime::currentMSecsSinceEpoch() * 1000000); // Convert to nanoseconds
@@ -238,6 +274,66 @@ bool DatabaseManager::insertPacketMetadata(int sessionId, const QJsonObject& pac
     return query.exec();
 }
 
+QJsonArray DatabaseManager::getPacketMetadataAt(int sessionId, qint64 firstRow, int limit)
+{
+    QJsonArray packets;
+    
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare(R"(SELECT packet_number, timestamp_ns, size_bytes, protocol, source_ip, dest_ip,
+                            source_port, dest_port, application
+                     FROM packet_metadata
+                     WHERE session_id = ? AND row_ordinal >= ? AND row_ordinal < ?
+                     ORDER BY row_ordinal)");
+    query.addBindValue(sessionId);
+    query.addBindValue(firstRow);
+    query.addBindValue(firstRow + limit);
+    
+    if (!query.exec()) {
+        qDebug() << "Failed to read packet page:" << query.lastError().text();
+        return packets;
+    }
+    
+    while (query.next()) {
+        QJsonObject packet;
+        packet["number"] = query.value(0).toLongLong();
+        packet["timestamp_ns"] = query.value(1).toLongLong();
+        packet["length"] = query.value(2).toString();
+        packet["size"] = query.value(2).toInt();
+        packet["protocol"] = query.value(3).toString();
+        packet["source"] = query.value(4).toString();
+        packet["dest"] = query.value(5).toString();
+        packet["source_port"] = query.value(6).toInt();
+        packet["dest_port"] = query.value(7).toInt();
+        packet["info"] = query.value(8).toString();
+        packets.append(packet);
+    }
+    
+    return packets;
+}
+
+QJsonObject DatabaseManager::getPacketRowRange(int sessionId)
+{
+    QJsonObject range;
+    range["count"] = 0;
+    range["first"] = 0;
+    
+    // Ordinals are dense, so both ends of the index give the count without a scan
+    QSqlQuery query(m_database);
+    query.prepare(R"(SELECT (SELECT MIN(row_ordinal) FROM packet_metadata WHERE session_id = ?),
+                            (SELECT MAX(row_ordinal) FROM packet_metadata WHERE session_id = ?))");
+    query.addBindValue(sessionId);
+    query.addBindValue(sessionId);
+    
+    if (query.exec() && query.next() && !query.value(0).isNull()) {
+        const qint64 first = query.value(0).toLongLong();
+        range["first"] = first;
+        range["count"] = query.value(1).toLongLong() - first + 1;
+    }
+    
+    return range;
+}
+
 bool DatabaseManager::setUserPreference(int userId, const QString& key, const QVariant& value)
 {
     QSqlQuery query(m_database);
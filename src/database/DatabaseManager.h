@@ -7,6 +7,7 @@
 #include <QVariant>
 #include <QDateTime>
 #include <QJsonObject>
+#include <QJsonArray>
 #include <QJsonDocument>
 
 class DatabaseManager : public QObject
@@ -33,6 +34,8 @@ public:
     // Packet Metadata
     bool insertPacketMetadata(int sessionId, const QJsonObject& packetData);
     QJsonArray getPacketMetadata(int sessionId, int limit = 1000, int offset = 0);
+    QJsonArray getPacketMetadataAt(int sessionId, qint64 firstRow, int limit);
+    QJsonObject getPacketRowRange(int sessionId);
     
     // Statistics
     QJsonObject getProtocolStatistics(int sessionId);
@@ -60,6 +63,7 @@ private:
     DatabaseManager& operator=(const DatabaseManager&) = delete;
     
     bool createTables();
+    bool createPacketOrdinals();
     bool executeSqlFile(const QString& filePath);
     QString hashPassword(const QString& password, const QString& salt);
     QString generateSalt();
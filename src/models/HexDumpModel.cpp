@@ -0,0 +1,212 @@
+#include "HexDumpModel.h"
+#include "PacketListModel.h"
+#include "../performance/HexFormatter.hpp"
+
+using PacketAnalyzer2026::Core::PacketBatchPtr;
+using PacketAnalyzer2026::Core::PacketRecord;
+using PacketAnalyzer2026::Performance::HexFormatter;
+
+HexDumpModel::HexDumpModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_source(nullptr)
+    , m_data(nullptr)
+    , m_length(0)
+    , m_highlightOffset(-1)
+    , m_highlightLength(0)
+{
+}
+
+int HexDumpModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : lineCount();
+}
+
+QVariant HexDumpModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= lineCount()) {
+        return QVariant();
+    }
+
+    switch (role) {
+        case OffsetRole:     return formatOffset(index.row());
+        case HexRole:        return formatHex(index.row());
+        case AsciiRole:      return formatAscii(index.row());
+        case HighlightStartRole:
+        case HighlightEndRole: {
+            const int lineStart = index.row() * 16;
+            const int start = qMax(m_highlightOffset, lineStart);
+            const int end = qMin(m_highlightOffset + m_highlightLength, lineStart + 16);
+            if (m_highlightOffset < 0 || start >= end) {
+                return -1;
+            }
+            return (role == HighlightStartRole ? start : end) - lineStart;
+        }
+        case Qt::DisplayRole: return line(index.row());
+        default:             return QVariant();
+    }
+}
+
+QHash<int, QByteArray> HexDumpModel::roleNames() const
+{
+    return {
+        { OffsetRole, "offset" },
+        { HexRole, "hex" },
+        { AsciiRole, "ascii" },
+        { HighlightStartRole, "highlightStart" },
+        { HighlightEndRole, "highlightEnd" }
+    };
+}
+
+void HexDumpModel::setPacket(const PacketBatchPtr& batch, const PacketRecord& record)
+{
+    if (!batch || record.dataOffset + static_cast<size_t>(record.capturedLength) > batch->bytes.size()) {
+        clear();
+        return;
+    }
+
+    beginResetModel();
+    m_batch = batch;
+    m_ownedBytes.clear();
+    m_data = batch->data(record);
+    m_highlightOffset = -1;
+    m_highlightLength = 0;
+    m_length = static_cast<int>(record.capturedLength);
+    endResetModel();
+    emit countChanged();
+    emit highlightChanged();
+}
+
+void HexDumpModel::showRow(int row)
+{
+    const PacketRecord* record = m_source ? m_source->recordAt(row) : nullptr;
+    if (!record) {
+        clear();
+        return;
+    }
+    setPacket(m_source->batchAt(row), *record);
+}
+
+void HexDumpModel::setBytes(const QByteArray& bytes)
+{
+    beginResetModel();
+    m_batch.reset();
+    m_ownedBytes = bytes;
+    m_data = reinterpret_cast<const uint8_t*>(m_ownedBytes.constData());
+    m_highlightOffset = -1;
+    m_highlightLength = 0;
+    m_length = static_cast<int>(m_ownedBytes.size());
+    endResetModel();
+    emit countChanged();
+    emit highlightChanged();
+}
+
+void HexDumpModel::clear()
+{
+    if (!m_data) {
+        return;
+    }
+
+    beginResetModel();
+    m_batch.reset();
+    m_ownedBytes.clear();
+    m_data = nullptr;
+    m_highlightOffset = -1;
+    m_highlightLength = 0;
+    m_length = 0;
+    endResetModel();
+    emit countChanged();
+    emit highlightChanged();
+}
+
+void HexDumpModel::setHighlight(int offset, int length)
+{
+    if (offset < 0 || length <= 0) {
+        offset = -1;
+        length = 0;
+    }
+    if (offset == m_highlightOffset && length == m_highlightLength) {
+        return;
+    }
+
+    refreshLines(m_highlightOffset, m_highlightLength);
+    m_highlightOffset = offset;
+    m_highlightLength = length;
+    refreshLines(m_highlightOffset, m_highlightLength);
+    emit highlightChanged();
+}
+
+void HexDumpModel::refreshLines(int offset, int length)
+{
+    if (offset < 0 || length <= 0 || offset >= m_length) {
+        return;
+    }
+    const int first = offset / 16;
+    const int last = qMin(offset + length - 1, m_length - 1) / 16;
+    emit dataChanged(index(first), index(last), { HighlightStartRole, HighlightEndRole });
+}
+
+QString HexDumpModel::formatOffset(int row) const
+{
+    // Four digits cover ordinary frames, reassembled streams widen to eight
+    return QString::number(row * 16, 16).rightJustified(m_length > 0x10000 ? 8 : 4, QLatin1Char('0'));
+}
+
+QString HexDumpModel::formatHex(int row) const
+{
+    const int offset = row * 16;
+    const size_t length = static_cast<size_t>(qMin(16, m_length - offset));
+
+    char digits[32];
+    HexFormatter::toHex(m_data + offset, length, digits);
+
+    // "xx xx xx xx xx xx xx xx  xx xx ..." with an extra gap after the eighth byte
+    char text[49];
+    int out = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (i > 0) {
+            text[out++] = ' ';
+            if (i == 8) text[out++] = ' ';
+        }
+        text[out++] = digits[2 * i];
+        text[out++] = digits[2 * i + 1];
+    }
+    return QString::fromLatin1(text, out);
+}
+
+QString HexDumpModel::formatAscii(int row) const
+{
+    const int offset = row * 16;
+    const size_t length = static_cast<size_t>(qMin(16, m_length - offset));
+
+    char text[16];
+    HexFormatter::toPrintable(m_data + offset, length, text);
+    return QString::fromLatin1(text, static_cast<int>(length));
+}
+
+QString HexDumpModel::line(int row) const
+{
+    if (row < 0 || row >= lineCount()) {
+        return QString();
+    }
+    return formatOffset(row) + QLatin1String("  ") + formatHex(row).leftJustified(48) +
+           QLatin1String("  ") + formatAscii(row);
+}
+
+QString HexDumpModel::readableText(int minimumRun, int maximumLength) const
+{
+    QString text;
+    const size_t length = static_cast<size_t>(m_length);
+    size_t position = 0;
+
+    while (position < length && text.size() < maximumLength) {
+        size_t run = HexFormatter::printableRun(m_data + position, length - position);
+        if (run >= static_cast<size_t>(qMax(1, minimumRun))) {
+            const int take = static_cast<int>(qMin<size_t>(run, static_cast<size_t>(maximumLength - text.size())));
+            text += QString::fromLatin1(reinterpret_cast<const char*>(m_data + position), take);
+            text += QLatin1Char('\n');
+        }
+        position += run + 1;
+    }
+
+    return text;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QString>
+#include "PacketRecordFormat.h"
+
+class PacketListModel;
+
+// Row model for the hex and ASCII panes: one row per 16-byte line of the selected packet.
+// Selecting a packet only records where its bytes are, so the cost does not depend on the
+// packet's size; lines are formatted with the SIMD kernels when a delegate asks for them.
+class HexDumpModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int byteCount READ byteCount NOTIFY countChanged)
+    Q_PROPERTY(int highlightOffset READ highlightOffset NOTIFY highlightChanged)
+    Q_PROPERTY(int highlightLength READ highlightLength NOTIFY highlightChanged)
+
+public:
+    enum Roles {
+        OffsetRole = Qt::UserRole + 1,
+        HexRole,
+        AsciiRole,
+        HighlightStartRole,     // First highlighted byte within the line, -1 if none
+        HighlightEndRole        // One past the last highlighted byte within the line
+    };
+
+    explicit HexDumpModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return lineCount(); }
+    int byteCount() const { return m_length; }
+    int highlightOffset() const { return m_highlightOffset; }
+    int highlightLength() const { return m_highlightLength; }
+
+    // Packet table showRow() reads from; the batch is shared, not copied
+    void setSource(PacketListModel* packets) { m_source = packets; }
+    void setPacket(const PacketAnalyzer2026::Core::PacketBatchPtr& batch,
+                   const PacketAnalyzer2026::Core::PacketRecord& record);
+
+    Q_INVOKABLE void showRow(int row);
+    Q_INVOKABLE void setBytes(const QByteArray& bytes);
+    Q_INVOKABLE void clear();
+
+    // Marks the bytes of a protocol tree field; only the affected lines are refreshed
+    Q_INVOKABLE void setHighlight(int offset, int length);
+
+    // "0000  45 00 ...  E..." for one line, used by copy actions
+    Q_INVOKABLE QString line(int row) const;
+    // Printable runs of at least minimumRun characters, one per line, like strings(1)
+    Q_INVOKABLE QString readableText(int minimumRun = 4, int maximumLength = 4096) const;
+
+signals:
+    void countChanged();
+    void highlightChanged();
+
+private:
+    int lineCount() const { return (m_length + 15) / 16; }
+    void refreshLines(int offset, int length);
+    QString formatOffset(int row) const;
+    QString formatHex(int row) const;
+    QString formatAscii(int row) const;
+
+    PacketListModel* m_source;
+    PacketAnalyzer2026::Core::PacketBatchPtr m_batch;   // Keeps m_data alive for batch-backed packets
+    QByteArray m_ownedBytes;                            // Keeps m_data alive for setBytes()
+    const uint8_t* m_data;
+    int m_length;
+    int m_highlightOffset;
+    int m_highlightLength;
+};
@@ -8,6 +8,10 @@
 #include <QDir>
 #include <QProcess>
 #include <QThread>
+#include <algorithm>
+#include <thread>
+#include "../core/BpfCompiler.hpp"
+#include "PacketRecordFormat.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -29,11 +33,39 @@ PacketAnalyzerModel::PacketAnalyzerModel(QObject* parent)
     , m_isAuthenticated(false)
     , m_currentUserId(-1)
     , m_currentSessionId(-1)
-{
+    , m_packetModel(new PacketListModel(this))
+    , m_sessionModel(nullptr)
+    , m_hexDumpModel(new HexDumpModel(this))
+    , m_protocolTreeModel(new ProtocolTreeModel(this))
+    , m_uiCoalescer(new UiUpdateCoalescer(60, this))
+{
+    // One capture thread per fanout ring; per-flow analysis runs on the parsing pool, one flow
+    // shard per thread
+    const size_t cores = std::max(2u, std::thread::hardware_concurrency());
+    const size_t captureThreads = std::clamp<size_t>(cores / 4, 1, 4);
+    m_pipeline = std::make_unique<PacketAnalyzer2026::Performance::PacketProcessingThreadPool>(
+        captureThreads, std::max<size_t>(cores - captureThreads - 1, 2));
+    // Capture workers must never wait on analysis: when the shards fall behind, new batches are
+    // dropped here and counted in the channel statistics. 256 batches is ~130k packets.
+    PacketAnalyzer2026::Performance::ChannelConfig parsingInput;
+    parsingInput.capacity = 256;
+    parsingInput.overflow = PacketAnalyzer2026::Performance::OverflowPolicy::DropNewest;
+    m_parsingInput = m_pipeline->createChannel<BatchChannel>("capture->parsing", parsingInput);
+    // Enough batches to refill the packet table once; the table shows the newest rows
+    PacketAnalyzer2026::Performance::ChannelConfig uiInput;
+    uiInput.capacity = 256;
+    uiInput.overflow = PacketAnalyzer2026::Performance::OverflowPolicy::DropOldest;
+    m_uiInput = m_pipeline->createChannel<BatchChannel>("capture->ui", uiInput);
+    resetFlowShards();
+
     // Initialize database
     initializeDatabase();
+    m_sessionModel = new SessionPacketModel(m_database, this);
+    m_hexDumpModel->setSource(m_packetModel);
+    m_protocolTreeModel->setSource(m_packetModel);
 
     // Initialize capture engine
+    PacketRecordFormat::registerMetaTypes();
     m_captureEngine = new PacketCaptureEngine(this);
     
     // Connect capture engine signals
@@ -48,6 +80,11 @@ PacketAnalyzerModel::PacketAnalyzerModel(QObject* parent)
     connect(m_captureEngine, &PacketCaptureEngine::captureError,
             this, &PacketAnalyzerModel::onCaptureError);
 
+    // Property signals and table rows reach QML at most once per display frame
+    m_uiCoalescer->setRowBudget(static_cast<size_t>(m_packetModel->capacity()));
+    connect(m_uiCoalescer, &UiUpdateCoalescer::frameReady,
+            this, &PacketAnalyzerModel::onUiFrame);
+
     // Initialize timers
     m_cpuTimer = new QTimer(this);
     connect(m_cpuTimer, &QTimer::timeout, this, &PacketAnalyzerModel::updateCpuUsage);
@@ -57,6 +94,9 @@ PacketAnalyzerModel::PacketAnalyzerModel(QObject* parent)
     connect(m_interfaceRefreshTimer, &QTimer::timeout, this, &PacketAnalyzerModel::refreshInterfaces);
     m_interfaceRefreshTimer->start(10000); // Refresh interfaces every 10 seconds
 
+    m_captureStatsTimer = new QTimer(this);
+    connect(m_captureStatsTimer, &QTimer::timeout, this, &PacketAnalyzerModel::pollCaptureStatistics);
+
     // Load available interfaces
     refreshInterfaces();
 
@@ -68,6 +108,78 @@ PacketAnalyzerModel::~PacketAnalyzerModel()
     if (m_isCapturing) {
         stopCapture();
     }
+    stopFlowPump();
+}
+
+void PacketAnalyzerModel::resetFlowShards()
+{
+    using PacketAnalyzer2026::Protocols::FlowAnalysisShard;
+
+    // The old dispatcher waits for its queued batches before the new shards are built;
+    // batches still in the channel belong to the previous capture
+    stopFlowPump();
+    m_flowShards.reset();
+    PacketAnalyzer2026::Core::PacketBatchPtr stale;
+    while (m_parsingInput->tryPop(stale)) {
+    }
+
+    const size_t shards = m_pipeline->getParsingPool().threadCount();
+    m_flowShards = std::make_unique<FlowShardDispatcher>(m_pipeline->getParsingPool(), [shards](size_t) {
+        return std::make_unique<FlowAnalysisShard>(shards);
+    });
+    m_flowPublishPending.store(false);
+    m_flowPumpPaused.store(false);
+}
+
+void PacketAnalyzerModel::scheduleFlowPump()
+{
+    if (!m_flowPumpScheduled.exchange(true)) {
+        m_pipeline->getParsingPool().submit([this] { pumpFlowChannel(); });
+    }
+}
+
+// Capture->parsing consumer, on a parsing worker. Each round dispatches up to
+// FLOW_BATCHES_IN_FLIGHT batches and resumes once the shards have processed them, so a slow
+// analysis stage backs up into the bounded channel rather than the workers' queues.
+void PacketAnalyzerModel::pumpFlowChannel()
+{
+    PacketAnalyzer2026::Core::PacketBatchPtr batches[FLOW_BATCHES_IN_FLIGHT];
+    while (true) {
+        const size_t count = m_flowPumpPaused.load() ? 0 : m_parsingInput->popBatch(batches, FLOW_BATCHES_IN_FLIGHT);
+        if (count != 0) {
+            for (size_t i = 0; i < count; ++i) {
+                m_flowShards->dispatch(batches[i]);
+                batches[i].reset();
+            }
+            m_flowShards->afterQueued([this] { pumpFlowChannel(); });
+            return;
+        }
+
+        if (m_flowPublishPending.exchange(false)) {
+            m_flowShards->publishNow();
+        }
+        m_flowPumpScheduled.store(false);
+
+        // A push that raced with the empty pop saw the pump still scheduled, so take its batch.
+        // Once released, stopFlowPump() may already have returned: re-check the pause before
+        // touching the dispatcher again.
+        if (m_parsingInput->occupancy() == 0 || m_flowPumpScheduled.exchange(true)) {
+            return;
+        }
+        if (m_flowPumpPaused.load()) {
+            m_flowPumpScheduled.store(false);
+            return;
+        }
+    }
+}
+
+void PacketAnalyzerModel::stopFlowPump()
+{
+    // A running pump stops after its current round
+    m_flowPumpPaused.store(true);
+    while (m_flowPumpScheduled.load()) {
+        std::this_thread::yield();
+    }
 }
 
 void PacketAnalyzerModel::initializeDatabase()
@@ -114,13 +226,10 @@ void PacketAnalyzerModel::logout()
     emit userLoggedOut();
 }
 
+// Open to anonymous use: the main window has no login step. Signing in only adds the user
+// to the action log; logging out still stops a running capture.
 bool PacketAnalyzerModel::startCapture(const QString& sessionName, const QString& filter)
 {
-    if (!m_isAuthenticated) {
-        emit captureError("Authentication required");
-        return false;
-    }
-    
     if (m_isCapturing) {
         emit captureError("Capture already in progress");
         return false;
@@ -131,13 +240,24 @@ bool PacketAnalyzerModel::startCapture(const QString& sessionName, const QString
         m_currentFilter = filter;
         emit currentFilterChanged();
     }
-    
-    // Start capture engine
-    bool success = m_captureEngine->startCapture(m_currentInterface, m_currentFilter);
+
+    // Capture workers feed the shards directly, so they must be rebuilt before the rings start
+    resetFlowShards();
+    PacketAnalyzer2026::Core::PacketBatchPtr stale;
+    while (m_uiInput->tryPop(stale)) {
+    }
+
+    // Fanout rings where TPACKET_V3 exists, the engine elsewhere
+    bool success = PacketAnalyzer2026::Core::TPacketV3Capture::isSupported()
+        ? startRingCapture()
+        : m_captureEngine->startCapture(m_currentInterface, m_currentFilter);
     if (success) {
         m_isCapturing = true;
         m_packetCount = 0;
-        m_recentPackets.clear();
+        m_captureStats = {};
+        m_uiCoalescer->takePendingBatches();
+        m_engineBatch.reset();
+        m_packetModel->clear();
         
         // Create new session in database
         QString actualSessionName = sessionName.isEmpty() ? 
@@ -149,7 +269,6 @@ bool PacketAnalyzerModel::startCapture(const QString& sessionName, const QString
         
         emit isCapturingChanged();
         emit packetCountChanged();
-        emit packetsChanged();
         emit currentSessionIdChanged();
         
         logUserAction("START_CAPTURE", QString("Started capture session: %1").arg(actualSessionName));
@@ -164,8 +283,16 @@ void PacketAnalyzerModel::stopCapture()
         return;
     }
     
-    m_captureEngine->stopCapture();
+    if (m_ringCapture) {
+        stopRingCapture();
+        emit captureStopped();
+    } else {
+        m_captureEngine->stopCapture();
+    }
     m_isCapturing = false;
+    // Reports show the final totals once the pump has emptied the channel
+    m_flowPublishPending.store(true);
+    scheduleFlowPump();
     
     emit isCapturingChanged();
     logUserAction("STOP_CAPTURE", QString("Stopped capture session: %1").arg(m_currentSessionId));
@@ -186,30 +313,147 @@ bool PacketAnalyzerModel::setInterface(const QString& interfaceName)
 
 bool PacketAnalyzerModel::setFilter(const QString& filter)
 {
-    m_currentFilter = filter;
-    if (m_captureEngine) {
+    // Reject bad syntax up front; the engine swaps the compiled program into the running capture
+    try {
+        PacketAnalyzer2026::Core::BpfCompiler::compile(filter.toStdString());
+    } catch (const std::invalid_argument& e) {
+        emit captureError(QString::fromStdString(e.what()));
+        return false;
+    }
+
+    if (m_ringCapture) {
+        try {
+            m_fanout.setFilter(filter.toStdString());
+        } catch (const std::exception& e) {
+            emit captureError(QString::fromStdString(e.what()));
+            return false;
+        }
+    } else if (m_captureEngine) {
         m_captureEngine->setFilter(filter);
     }
+
+    m_currentFilter = filter;
     emit currentFilterChanged();
     logUserAction("SET_FILTER", QString("Changed filter to: %1").arg(filter));
     return true;
 }
 
+bool PacketAnalyzerModel::startRingCapture()
+{
+    using namespace PacketAnalyzer2026::Core;
+
+    FanoutConfig config;
+    config.workers = m_pipeline->getCapturePool().threadCount();
+    config.ring.blockCount = 16;   // 64 MiB per worker
+    try {
+        m_fanout.setFilter(m_currentFilter.toStdString());
+        m_fanout.open(m_currentInterface.toStdString(), config);
+    } catch (const std::exception& e) {
+        emit captureError(QString::fromStdString(e.what()));
+        return false;
+    }
+
+    m_batchBuilders.clear();
+    for (size_t i = 0; i < config.workers; ++i) {
+        auto builder = std::make_unique<PacketBatchBuilder>();
+        builder->setChecksumValidation(m_checksumValidation);
+        m_batchBuilders.push_back(std::move(builder));
+    }
+    m_packetSequence.store(0);
+
+    // Full batches leave on append; partial ones on the poll after their latency budget
+    m_fanout.start(m_pipeline->getCapturePool(),
+        [this](size_t worker, const CapturedFrame& frame) {
+            PacketBatchBuilder& builder = *m_batchBuilders[worker];
+            builder.append(frame);
+            if (builder.shouldFlush()) {
+                publishBatch(builder.take(m_packetSequence));
+            }
+        },
+        [this](size_t worker) {
+            PacketBatchBuilder& builder = *m_batchBuilders[worker];
+            if (builder.shouldFlush()) {
+                publishBatch(builder.take(m_packetSequence));
+            }
+        });
+
+    m_ringCapture = true;
+    m_captureStatsClock.start();
+    m_captureStatsTimer->start(1000);
+    onCaptureStarted(m_currentInterface);
+    return true;
+}
+
+void PacketAnalyzerModel::stopRingCapture()
+{
+    // Closes the rings; the final counters are still read from the fanout below
+    m_fanout.stop();
+    m_ringCapture = false;
+    m_captureStatsTimer->stop();
+    pollCaptureStatistics();
+
+    // Publish the partial batches the workers held back; they have returned, so their
+    // builders can be taken from here
+    for (auto& builder : m_batchBuilders) {
+        if (builder->pending() != 0) {
+            publishBatch(builder->take(m_packetSequence));
+        }
+    }
+    m_packetCount = static_cast<int>(m_packetSequence.load());
+    m_uiCoalescer->markDirty(DirtyPacketCount);
+}
+
+// Runs on a capture thread. The batch goes straight to the bounded parsing and table channels;
+// the GUI thread only gets a wakeup, at most one per UI frame, to drain the table's share.
+void PacketAnalyzerModel::publishBatch(PacketAnalyzer2026::Core::PacketBatchPtr batch)
+{
+    if (!batch || batch->empty()) {
+        return;
+    }
+
+    PacketAnalyzer2026::Core::PacketBatchPtr forParsing = batch;
+    if (m_parsingInput->push(std::move(forParsing))) {
+        scheduleFlowPump();
+    }
+    m_uiInput->push(std::move(batch));
+
+    if (!m_uiWakePending.exchange(true)) {
+        QMetaObject::invokeMethod(this, [this] {
+            m_packetCount = static_cast<int>(m_packetSequence.load());
+            m_uiCoalescer->markDirty(DirtyPacketCount);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void PacketAnalyzerModel::setChecksumValidation(bool enabled)
+{
+    if (enabled == m_checksumValidation) {
+        return;
+    }
+
+    // Every capture worker's batch builder reads it per packet, so this applies mid-capture.
+    // The engine's per-packet path does not validate.
+    m_checksumValidation = enabled;
+    for (auto& builder : m_batchBuilders) {
+        builder->setChecksumValidation(enabled);
+    }
+    emit checksumValidationChanged();
+    logUserAction("SET_CHECKSUM_VALIDATION", enabled ? "enabled" : "disabled");
+}
+
 void PacketAnalyzerModel::onPacketCaptured(const QJsonObject& packet)
 {
+    if (!m_engineBatch) {
+        m_engineBatch = std::make_shared<PacketAnalyzer2026::Core::PacketBatch>();
+        m_engineBatch->records.reserve(ENGINE_BATCH_PACKETS);
+    }
+    m_engineBatch->records.push_back(PacketRecordFormat::fromJson(packet));
     m_packetCount++;
-    
-    // Add to recent packets list
-    m_recentPackets.prepend(packet);
-    if (m_recentPackets.size() > MAX_DISPLAYED_PACKETS) {
-        m_recentPackets.removeLast();
+
+    if (m_engineBatch->size() >= ENGINE_BATCH_PACKETS) {
+        m_uiCoalescer->enqueueBatch(PacketAnalyzer2026::Core::PacketBatchPtr(std::move(m_engineBatch)));
     }
-    
-    // Update packets array for QML
-    updatePacketsList();
-    
-    emit packetCountChanged();
-    emit packetsChanged();
+    m_uiCoalescer->markDirty(DirtyPacketCount);
 }
 
 void PacketAnalyzerModel::onStatisticsUpdated(int totalPackets, qint64 totalBytes, double bandwidth, double cpuUsage)
@@ -217,10 +461,91 @@ void PacketAnalyzerModel::onStatisticsUpdated(int totalPackets, qint64 totalByte
     m_packetCount = totalPackets;
     m_bandwidthMbps = bandwidth;
     m_cpuUsage = cpuUsage;
-    
-    emit packetCountChanged();
-    emit bandwidthMbpsChanged();
-    emit cpuUsageChanged();
+
+    m_uiCoalescer->markDirty(DirtyPacketCount | DirtyBandwidth | DirtyCpuUsage);
+}
+
+// Ring drops and queue freezes per fanout socket, plus bandwidth over the interval since the
+// previous poll. The engine reports the same totals through statisticsUpdated on other platforms.
+void PacketAnalyzerModel::pollCaptureStatistics()
+{
+    PacketAnalyzer2026::Core::FanoutStatistics capture = m_fanout.statistics();
+    quint32 dirty = 0;
+    if (capture.totalDrops != m_captureStats.totalDrops ||
+        capture.totalQueueFreezes != m_captureStats.totalQueueFreezes ||
+        capture.totalPackets != m_captureStats.totalPackets ||
+        capture.workers.size() != m_captureStats.workers.size()) {
+        dirty |= DirtyCaptureStatistics;
+    }
+
+    const qint64 elapsedMs = m_captureStatsClock.restart();
+    if (elapsedMs > 0 && capture.totalBytes >= m_captureStats.totalBytes) {
+        const double bits = static_cast<double>(capture.totalBytes - m_captureStats.totalBytes) * 8.0;
+        const double bandwidth = bits / (static_cast<double>(elapsedMs) * 1000.0);
+        if (bandwidth != m_bandwidthMbps) {
+            m_bandwidthMbps = bandwidth;
+            dirty |= DirtyBandwidth;
+        }
+    }
+    m_captureStats = std::move(capture);
+
+    if (dirty != 0) {
+        m_uiCoalescer->markDirty(dirty);
+    }
+}
+
+QJsonArray PacketAnalyzerModel::captureWorkers() const
+{
+    QJsonArray workers;
+    for (const auto& stats : m_captureStats.workers) {
+        QJsonObject worker;
+        worker["packets"] = static_cast<qint64>(stats.packets);
+        worker["bytes"] = static_cast<qint64>(stats.bytes);
+        worker["drops"] = static_cast<qint64>(stats.drops);
+        worker["queueFreezes"] = static_cast<qint64>(stats.queueFreezes);
+        worker["failed"] = stats.failed;
+        workers.append(worker);
+    }
+    return workers;
+}
+
+void PacketAnalyzerModel::onUiFrame(quint32 dirtyFlags)
+{
+    // Batches pushed after the flag is cleared post the next wakeup
+    m_uiWakePending.store(false);
+    std::vector<PacketAnalyzer2026::Core::PacketBatchPtr> batches = m_uiCoalescer->takePendingBatches();
+    if (m_engineBatch) {
+        batches.emplace_back(std::move(m_engineBatch));
+    }
+    PacketAnalyzer2026::Core::PacketBatchPtr batch;
+    while (m_uiInput->tryPop(batch)) {
+        batches.push_back(std::move(batch));
+    }
+    m_packetModel->appendBatches(batches);
+
+    if (dirtyFlags & DirtyPacketCount) {
+        emit packetCountChanged();
+    }
+    if (dirtyFlags & DirtyBandwidth) {
+        emit bandwidthMbpsChanged();
+    }
+    if (dirtyFlags & DirtyCpuUsage) {
+        emit cpuUsageChanged();
+    }
+    if (dirtyFlags & DirtyCaptureStatistics) {
+        emit captureStatisticsChanged();
+    }
+}
+
+void PacketAnalyzerModel::setUiRefreshRate(int frameRateHz)
+{
+    m_uiCoalescer->setFrameRate(frameRateHz);
+}
+
+void PacketAnalyzerModel::selectPacket(int row)
+{
+    m_hexDumpModel->showRow(row);
+    m_protocolTreeModel->showRow(row);
 }
 
 void PacketAnalyzerModel::onCaptureStarted(const QString& interface)
@@ -249,7 +574,7 @@ void PacketAnalyzerModel::updateCpuUsage()
     double usage = getCurrentCpuUsage();
     if (usage != m_cpuUsage) {
         m_cpuUsage = usage;
-        emit cpuUsageChanged();
+        m_uiCoalescer->markDirty(DirtyCpuUsage);
     }
 }
 
@@ -269,15 +594,6 @@ void PacketAnalyzerModel::refreshInterfaces()
     emit availableInterfacesChanged();
 }
 
-void PacketAnalyzerModel::updatePacketsList()
-{
-    QJsonArray jsonArray;
-    for (const QJsonObject& packet : m_recentPackets) {
-        jsonArray.append(packet);
-    }
-    m_packets = jsonArray;
-}
-
 double PacketAnalyzerModel::getCurrentCpuUsage()
 {
 #ifdef _WIN32
@@ -367,8 +683,18 @@ QJsonArray PacketAnalyzerModel::getCaptureHistory()
 
 bool PacketAnalyzerModel::loadSession(int sessionId)
 {
-    Q_UNUSED(sessionId)
-    return false; // TODO: Implement
+    if (!m_database || !m_isAuthenticated) {
+        return false;
+    }
+
+    // Only the row count is read here; packets are paged in as the table scrolls
+    if (!m_sessionModel->loadSession(sessionId)) {
+        qDebug() << "Session" << sessionId << "has no stored packets";
+        return false;
+    }
+
+    logUserAction("LOAD_SESSION", QString("Loaded session %1 (%2 packets)").arg(sessionId).arg(m_sessionModel->totalCount()));
+    return true;
 }
 
 bool PacketAnalyzerModel::saveFilterPreset(const QString& name, const QString& expression, const QString& description)
@@ -405,18 +731,280 @@ QVariant PacketAnalyzerModel::getPreference(const QString& key, const QVariant&
 
 QJsonObject PacketAnalyzerModel::getDetailedStatistics()
 {
-    return QJsonObject(); // TODO: Implement
+    const auto summary = m_flowShards->merged();
+
+    QJsonObject flows;
+    flows["active"] = static_cast<qint64>(summary.activeFlows);
+    flows["created"] = static_cast<qint64>(summary.flows.created);
+    flows["expired"] = static_cast<qint64>(summary.flows.expired);
+    flows["rejected"] = static_cast<qint64>(summary.flows.rejected);
+    flows["tableBytes"] = static_cast<qint64>(summary.flowTableBytes);
+
+    QJsonObject checksums;
+    checksums["bad"] = static_cast<qint64>(summary.badChecksums);
+    checksums["offloaded"] = static_cast<qint64>(summary.offloadedChecksums);
+    checksums["validation"] = m_checksumValidation;
+
+    QJsonArray shards;
+    for (const auto& load : m_flowShards->load()) {
+        QJsonObject shard;
+        shard["batches"] = static_cast<qint64>(load.batches);
+        shard["packets"] = static_cast<qint64>(load.packets);
+        shards.append(shard);
+    }
+
+    QJsonArray channels;
+    for (const auto& channel : m_pipeline->getSystemMetrics().channels) {
+        QJsonObject entry;
+        entry["name"] = QString::fromStdString(channel.name);
+        entry["overflow"] = QString::fromLatin1(PacketAnalyzer2026::Performance::overflowPolicyName(channel.overflow));
+        entry["capacity"] = static_cast<qint64>(channel.capacity);
+        entry["occupancy"] = static_cast<qint64>(channel.occupancy);
+        entry["highWatermark"] = static_cast<qint64>(channel.highWatermark);
+        entry["pushed"] = static_cast<qint64>(channel.pushed);
+        entry["dropped"] = static_cast<qint64>(channel.dropped());
+        channels.append(entry);
+    }
+
+    QJsonObject capture;
+    capture["packets"] = static_cast<qint64>(m_captureStats.totalPackets);
+    capture["drops"] = static_cast<qint64>(m_captureStats.totalDrops);
+    capture["queueFreezes"] = static_cast<qint64>(m_captureStats.totalQueueFreezes);
+    capture["workers"] = captureWorkers();
+
+    QJsonObject stats;
+    stats["packets"] = m_packetCount;
+    stats["capture"] = capture;
+    stats["flows"] = flows;
+    stats["checksums"] = checksums;
+    stats["flowShards"] = shards;
+    stats["channels"] = channels;
+    return stats;
 }
 
 QJsonObject PacketAnalyzerModel::getNetworkTopology()
 {
-    return QJsonObject(); // TODO: Implement
+    using PacketAnalyzer2026::Protocols::HostTraffic;
+
+    const auto summary = m_flowShards->merged();
+    const auto traffic = [](QJsonObject& object, const HostTraffic& totals) {
+        object["bytes"] = static_cast<qint64>(totals.bytes);
+        object["packets"] = static_cast<qint64>(totals.packets);
+        object["flows"] = static_cast<qint64>(totals.flows);
+    };
+
+    QJsonArray nodes;
+    for (const auto& host : summary.hosts) {
+        QJsonObject node;
+        node["id"] = PacketRecordFormat::address(host.first.ipVersion, host.first.address);
+        traffic(node, host.second);
+        nodes.append(node);
+    }
+
+    // One link per host pair, summed over all flows between them
+    QJsonArray edges;
+    for (const auto& link : summary.links) {
+        QJsonObject edge;
+        edge["source"] = PacketRecordFormat::address(link.first.a.ipVersion, link.first.a.address);
+        edge["target"] = PacketRecordFormat::address(link.first.b.ipVersion, link.first.b.address);
+        traffic(edge, link.second);
+        edges.append(edge);
+    }
+
+    QJsonObject topology;
+    topology["nodes"] = nodes;
+    topology["links"] = edges;
+    return topology;
 }
 
 QJsonArray PacketAnalyzerModel::getTopTalkers(int limit)
 {
-    Q_UNUSED(limit)
-    return QJsonArray(); // TODO: Implement
+    using PacketAnalyzer2026::Protocols::HostAddress;
+    using PacketAnalyzer2026::Protocols::HostTraffic;
+
+    const auto summary = m_flowShards->merged();
+    std::vector<std::pair<const HostAddress*, const HostTraffic*>> ranked;
+    ranked.reserve(summary.hosts.size());
+    for (const auto& host : summary.hosts) {
+        ranked.emplace_back(&host.first, &host.second);
+    }
+    const size_t count = std::min(ranked.size(), static_cast<size_t>(std::max(limit, 0)));
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+                      [](const auto& a, const auto& b) { return a.second->bytes > b.second->bytes; });
+
+    QJsonArray result;
+    for (size_t i = 0; i < count; ++i) {
+        QJsonObject talker;
+        talker["address"] = PacketRecordFormat::address(ranked[i].first->ipVersion, ranked[i].first->address);
+        talker["bytes"] = static_cast<qint64>(ranked[i].second->bytes);
+        talker["packets"] = static_cast<qint64>(ranked[i].second->packets);
+        talker["flows"] = static_cast<qint64>(ranked[i].second->flows);
+        result.append(talker);
+    }
+    return result;
+}
+
+QJsonArray PacketAnalyzerModel::getTlsSessions(int limit)
+{
+    const auto summary = m_flowShards->merged();
+    QJsonArray result;
+    for (const auto& [key, info] : summary.tlsSessions) {
+        if (result.size() >= limit) {
+            break;
+        }
+        const bool clientIsA = info.clientDirection == 0;
+        QJsonObject session;
+        session["client"] = PacketRecordFormat::address(key.ipVersion, clientIsA ? key.addressA : key.addressB);
+        session["server"] = PacketRecordFormat::address(key.ipVersion, clientIsA ? key.addressB : key.addressA);
+        session["serverPort"] = clientIsA ? key.portB : key.portA;
+        session["sni"] = QString::fromLatin1(info.serverName);
+        session["alpn"] = QString::fromLatin1(info.alpn);
+        session["ja3"] = QString::fromLatin1(info.ja3);
+        session["ja4"] = QString::fromLatin1(info.ja4);
+        if (info.haveServerHello) {
+            session["ja3s"] = QString::fromLatin1(info.ja3s);
+            session["version"] = QString("0x%1").arg(info.version, 4, 16, QChar('0'));
+            session["cipher"] = QString("0x%1").arg(info.cipher, 4, 16, QChar('0'));
+        }
+        result.append(session);
+    }
+    return result;
+}
+
+QJsonObject PacketAnalyzerModel::getDnsStatistics()
+{
+    using PacketAnalyzer2026::Core::LatencyHistogram;
+    using PacketAnalyzer2026::Protocols::DnsRcode;
+    using PacketAnalyzer2026::Protocols::DnsResolverStats;
+
+    const auto summary = m_flowShards->merged();
+    const auto& dnsStats = summary.dns;
+    QJsonObject totals;
+    totals["queries"] = static_cast<qint64>(dnsStats.queries);
+    totals["responses"] = static_cast<qint64>(dnsStats.responses);
+    totals["matched"] = static_cast<qint64>(dnsStats.matched);
+    totals["retransmits"] = static_cast<qint64>(dnsStats.retransmits);
+    totals["unmatched"] = static_cast<qint64>(dnsStats.unmatched);
+    totals["timeouts"] = static_cast<qint64>(dnsStats.timeouts);
+    totals["dropped"] = static_cast<qint64>(dnsStats.dropped);
+    totals["malformed"] = static_cast<qint64>(dnsStats.malformed);
+    totals["pending"] = static_cast<qint64>(summary.dnsPending);
+
+    // The open-ended last bucket has no upper bound to report
+    const auto micros = [](uint64_t value) {
+        return value == UINT64_MAX ? QJsonValue() : QJsonValue(static_cast<qint64>(value));
+    };
+
+    QJsonArray resolvers;
+    for (const DnsResolverStats& stats : summary.resolvers) {
+        const double answered = static_cast<double>(std::max<uint64_t>(stats.responses, 1));
+        QJsonArray histogram;
+        for (size_t i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+            QJsonObject bucket;
+            bucket["belowUs"] = micros(LatencyHistogram::bucketLimitUs(i));
+            bucket["count"] = static_cast<qint64>(stats.latency.buckets[i]);
+            histogram.append(bucket);
+        }
+
+        QJsonObject resolver;
+        resolver["address"] = PacketRecordFormat::address(stats.ipVersion, stats.address);
+        resolver["queries"] = static_cast<qint64>(stats.queries);
+        resolver["responses"] = static_cast<qint64>(stats.responses);
+        resolver["timeouts"] = static_cast<qint64>(stats.timeouts);
+        resolver["nxdomain"] = static_cast<qint64>(stats.rcodes[static_cast<int>(DnsRcode::NXDomain)]);
+        resolver["servfail"] = static_cast<qint64>(stats.rcodes[static_cast<int>(DnsRcode::ServFail)]);
+        resolver["nxdomainRate"] = stats.rcodes[static_cast<int>(DnsRcode::NXDomain)] / answered;
+        resolver["meanLatencyUs"] = stats.latency.meanUs();
+        resolver["p50LatencyUs"] = micros(stats.latency.percentileUs(0.50));
+        resolver["p99LatencyUs"] = micros(stats.latency.percentileUs(0.99));
+        resolver["latencyHistogram"] = histogram;
+        resolvers.append(resolver);
+    }
+
+    QJsonObject result;
+    result["totals"] = totals;
+    result["resolvers"] = resolvers;
+    return result;
+}
+
+QJsonObject PacketAnalyzerModel::getHttpEndpoints(int limit)
+{
+    using PacketAnalyzer2026::Core::LatencyHistogram;
+    using PacketAnalyzer2026::Protocols::Http1EndpointStats;
+
+    const auto micros = [](uint64_t value) {
+        return value == UINT64_MAX ? QJsonValue() : QJsonValue(static_cast<qint64>(value));
+    };
+
+    const auto summary = m_flowShards->merged();
+    const auto& httpStats = summary.http;
+    QJsonObject totals;
+    totals["requests"] = static_cast<qint64>(httpStats.requests);
+    totals["responses"] = static_cast<qint64>(httpStats.responses);
+    totals["matched"] = static_cast<qint64>(httpStats.matched);
+    totals["unmatched"] = static_cast<qint64>(httpStats.unmatched);
+    totals["pipelineOverflows"] = static_cast<qint64>(httpStats.pipelineOverflows);
+    totals["untrackedEndpoints"] = static_cast<qint64>(httpStats.untrackedEndpoints);
+    totals["openConnections"] = static_cast<qint64>(summary.httpConnections);
+    totals["reassemblyGaps"] = static_cast<qint64>(summary.reassemblyGaps);
+
+    const auto& activity = summary.streams;
+    QJsonObject webSocket;
+    webSocket["messages"] = static_cast<qint64>(activity.webSocketMessages);
+    webSocket["bytes"] = static_cast<qint64>(activity.webSocketBytes);
+    webSocket["truncated"] = static_cast<qint64>(activity.truncatedWebSocketMessages);
+    webSocket["controlFrames"] = static_cast<qint64>(activity.webSocketControlFrames);
+    QJsonObject http2;
+    http2["headerBlocks"] = static_cast<qint64>(activity.http2HeaderBlocks);
+    http2["grpcHeaderBlocks"] = static_cast<qint64>(activity.grpcHeaderBlocks);
+
+    // Busiest endpoints first
+    std::vector<const Http1EndpointStats*> ranked;
+    ranked.reserve(summary.endpoints.size());
+    for (const Http1EndpointStats& endpoint : summary.endpoints) {
+        ranked.push_back(&endpoint);
+    }
+    const size_t count = std::min(ranked.size(), static_cast<size_t>(std::max(limit, 0)));
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+                      [](const Http1EndpointStats* a, const Http1EndpointStats* b) { return a->requests > b->requests; });
+
+    QJsonArray endpoints;
+    for (size_t i = 0; i < count; ++i) {
+        const Http1EndpointStats& stats = *ranked[i];
+        QJsonObject status;
+        for (int statusClass = 1; statusClass <= 5; ++statusClass) {
+            status[QString("%1xx").arg(statusClass)] = static_cast<qint64>(stats.statusClasses[statusClass]);
+        }
+
+        QJsonArray histogram;
+        for (size_t bucket = 0; bucket < LatencyHistogram::BUCKETS; ++bucket) {
+            QJsonObject entry;
+            entry["belowUs"] = micros(LatencyHistogram::bucketLimitUs(bucket));
+            entry["count"] = static_cast<qint64>(stats.latency.buckets[bucket]);
+            histogram.append(entry);
+        }
+
+        QJsonObject endpoint;
+        endpoint["method"] = QString::fromStdString(stats.method);
+        endpoint["host"] = QString::fromStdString(stats.host);
+        endpoint["path"] = QString::fromStdString(stats.path);
+        endpoint["requests"] = static_cast<qint64>(stats.requests);
+        endpoint["responses"] = static_cast<qint64>(stats.responses);
+        endpoint["unanswered"] = static_cast<qint64>(stats.unanswered);
+        endpoint["status"] = status;
+        endpoint["meanResponseUs"] = stats.latency.meanUs();
+        endpoint["p50ResponseUs"] = micros(stats.latency.percentileUs(0.50));
+        endpoint["p99ResponseUs"] = micros(stats.latency.percentileUs(0.99));
+        endpoint["latencyHistogram"] = histogram;
+        endpoints.append(endpoint);
+    }
+
+    QJsonObject result;
+    result["totals"] = totals;
+    result["endpoints"] = endpoints;
+    result["webSocket"] = webSocket;
+    result["http2"] = http2;
+    return result;
 }
 
 QJsonArray PacketAnalyzerModel::getProtocolDistribution()
@@ -5,8 +5,21 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <atomic>
+#include <memory>
 #include "../core/PacketCaptureEngine.h"
+#include "../core/FanoutCapture.hpp"
+#include "../core/FlowShardedDispatcher.hpp"
+#include "../core/PacketRecord.hpp"
+#include "../performance/ThreadPool.hpp"
+#include "../protocols/FlowAnalysisShard.hpp"
 #include "../database/DatabaseManager.h"
+#include "PacketListModel.h"
+#include "SessionPacketModel.h"
+#include "HexDumpModel.h"
+#include "ProtocolTreeModel.h"
+#include "UiUpdateCoalescer.h"
 
 class PacketAnalyzerModel : public QObject
 {
@@ -18,11 +31,18 @@ class PacketAnalyzerModel : public QObject
     Q_PROPERTY(QString currentInterface READ currentInterface NOTIFY currentInterfaceChanged)
     Q_PROPERTY(QString currentFilter READ currentFilter NOTIFY currentFilterChanged)
     Q_PROPERTY(QJsonArray availableInterfaces READ availableInterfaces NOTIFY availableInterfacesChanged)
-    Q_PROPERTY(QJsonArray packets READ packets NOTIFY packetsChanged)
+    Q_PROPERTY(PacketListModel* packets READ packets CONSTANT)
+    Q_PROPERTY(SessionPacketModel* sessionPackets READ sessionPackets CONSTANT)
+    Q_PROPERTY(HexDumpModel* hexDump READ hexDump CONSTANT)
+    Q_PROPERTY(ProtocolTreeModel* protocolTree READ protocolTree CONSTANT)
     Q_PROPERTY(QJsonObject protocolStatistics READ protocolStatistics NOTIFY protocolStatisticsChanged)
     Q_PROPERTY(bool isAuthenticated READ isAuthenticated NOTIFY isAuthenticatedChanged)
     Q_PROPERTY(QString currentUser READ currentUser NOTIFY currentUserChanged)
     Q_PROPERTY(int currentSessionId READ currentSessionId NOTIFY currentSessionIdChanged)
+    Q_PROPERTY(bool checksumValidation READ checksumValidation WRITE setChecksumValidation NOTIFY checksumValidationChanged)
+    Q_PROPERTY(qint64 captureDrops READ captureDrops NOTIFY captureStatisticsChanged)
+    Q_PROPERTY(qint64 captureQueueFreezes READ captureQueueFreezes NOTIFY captureStatisticsChanged)
+    Q_PROPERTY(QJsonArray captureWorkers READ captureWorkers NOTIFY captureStatisticsChanged)
 
 public:
     explicit PacketAnalyzerModel(QObject* parent = nullptr);
@@ -38,6 +58,8 @@ public:
     Q_INVOKABLE void stopCapture();
     Q_INVOKABLE bool setInterface(const QString& interfaceName);
     Q_INVOKABLE bool setFilter(const QString& filter);
+    // Verifies IPv4/TCP/UDP checksums on the capture threads; costs a pass over every payload
+    void setChecksumValidation(bool enabled);
 
     // Data export
     Q_INVOKABLE bool exportToPcap(const QString& filePath);
@@ -57,10 +79,19 @@ public:
     Q_INVOKABLE bool setPreference(const QString& key, const QVariant& value);
     Q_INVOKABLE QVariant getPreference(const QString& key, const QVariant& defaultValue = QVariant());
 
+    // UI refresh rate for coalesced property and row updates (frames per second)
+    Q_INVOKABLE void setUiRefreshRate(int frameRateHz);
+
+    // Points the hex dump and protocol tree at a packet table row; dissects it on demand
+    Q_INVOKABLE void selectPacket(int row);
+
     // Statistics and analysis
     Q_INVOKABLE QJsonObject getDetailedStatistics();
     Q_INVOKABLE QJsonObject getNetworkTopology();
     Q_INVOKABLE QJsonArray getTopTalkers(int limit = 10);
+    Q_INVOKABLE QJsonArray getTlsSessions(int limit = 100);
+    Q_INVOKABLE QJsonObject getDnsStatistics();
+    Q_INVOKABLE QJsonObject getHttpEndpoints(int limit = 50);
     Q_INVOKABLE QJsonArray getProtocolDistribution();
 
     // Property getters
@@ -71,28 +102,43 @@ public:
     QString currentInterface() const { return m_currentInterface; }
     QString currentFilter() const { return m_currentFilter; }
     QJsonArray availableInterfaces() const { return m_availableInterfaces; }
-    QJsonArray packets() const { return m_packets; }
+    PacketListModel* packets() const { return m_packetModel; }
+    SessionPacketModel* sessionPackets() const { return m_sessionModel; }
+    HexDumpModel* hexDump() const { return m_hexDumpModel; }
+    ProtocolTreeModel* protocolTree() const { return m_protocolTreeModel; }
     QJsonObject protocolStatistics() const { return m_protocolStatistics; }
     bool isAuthenticated() const { return m_isAuthenticated; }
     QString currentUser() const { return m_currentUser; }
     int currentSessionId() const { return m_currentSessionId; }
+    bool checksumValidation() const { return m_checksumValidation; }
+    qint64 captureDrops() const { return static_cast<qint64>(m_captureStats.totalDrops); }
+    qint64 captureQueueFreezes() const { return static_cast<qint64>(m_captureStats.totalQueueFreezes); }
+    QJsonArray captureWorkers() const;
 
 private slots:
     void onPacketCaptured(const QJsonObject& packet);
     void onStatisticsUpdated(int totalPackets, qint64 totalBytes, double bandwidth, double cpuUsage);
+    void onUiFrame(quint32 dirtyFlags);
     void onCaptureStarted(const QString& interface);
     void onCaptureStopped();
     void onCaptureError(const QString& error);
     void updateCpuUsage();
     void refreshInterfaces();
+    void pollCaptureStatistics();
 
 private:
     void initializeDatabase();
-    void updatePacketsList();
     void savePacketToDatabase(const PacketInfo& packet);
     QJsonObject packetInfoToJson(const PacketInfo& packet);
     double getCurrentCpuUsage();
     void logUserAction(const QString& action, const QString& details = "");
+    void resetFlowShards();
+    void scheduleFlowPump();
+    void pumpFlowChannel();
+    void stopFlowPump();
+    bool startRingCapture();
+    void stopRingCapture();
+    void publishBatch(PacketAnalyzer2026::Core::PacketBatchPtr batch);
 
     // Core components
     PacketCaptureEngine* m_captureEngine;
@@ -106,20 +152,65 @@ private:
     QString m_currentInterface;
     QString m_currentFilter;
     QJsonArray m_availableInterfaces;
-    QJsonArray m_packets;
     QJsonObject m_protocolStatistics;
     bool m_isAuthenticated;
     QString m_currentUser;
     int m_currentUserId;
     int m_currentSessionId;
+    bool m_checksumValidation = false;
+    PacketAnalyzer2026::Core::FanoutStatistics m_captureStats;   // Per fanout socket, polled by m_captureStatsTimer
 
     // Timers
     QTimer* m_cpuTimer;
     QTimer* m_interfaceRefreshTimer;
+    QTimer* m_captureStatsTimer;          // Fanout counters and bandwidth while the rings run
+    QElapsedTimer m_captureStatsClock;
 
     // Packet storage
-    QList<QJsonObject> m_recentPackets;
-    static const int MAX_DISPLAYED_PACKETS = 1000;
+    PacketListModel* m_packetModel;
+    SessionPacketModel* m_sessionModel;   // Stored sessions, paged from the database on demand
+    HexDumpModel* m_hexDumpModel;         // Lines of the selected packet, formatted on demand
+    ProtocolTreeModel* m_protocolTreeModel; // Field tree of the selected packet, dissected on selection
+
+    // Flow table, TLS, DNS and HTTP state per parsing thread; reports read the merged snapshots.
+    // Captured batches reach the shards through the capture->parsing channel, drained by one
+    // pump task at a time on the parsing pool. The channel and pump flags outlive the pool, and
+    // the dispatcher is declared after the pool so it is destroyed first.
+    using FlowShardDispatcher = PacketAnalyzer2026::Core::FlowShardedDispatcher<PacketAnalyzer2026::Protocols::FlowAnalysisShard>;
+    using BatchChannel = PacketAnalyzer2026::Performance::MpmcChannel<PacketAnalyzer2026::Core::PacketBatchPtr>;
+    static constexpr size_t FLOW_BATCHES_IN_FLIGHT = 16;  // Per pump round; the rest waits in the channel
+    std::shared_ptr<BatchChannel> m_parsingInput;
+    // Capture->table: drained on the UI frame. A full channel evicts its oldest batches, which
+    // the table would scroll out anyway. Workers post at most one wakeup until the frame runs.
+    std::shared_ptr<BatchChannel> m_uiInput;
+    std::atomic<bool> m_uiWakePending{false};
+    // Engine path: JSON rows gathered on the GUI thread; full batches go to the coalescer and
+    // the partial one is taken on the next frame, so the table gets one insert per frame
+    static constexpr size_t ENGINE_BATCH_PACKETS = 512;
+    std::shared_ptr<PacketAnalyzer2026::Core::PacketBatch> m_engineBatch;
+    std::atomic<bool> m_flowPumpScheduled{false};
+    std::atomic<bool> m_flowPumpPaused{false};
+    std::atomic<bool> m_flowPublishPending{false};   // Publish once the channel is empty (capture stopped)
+    std::unique_ptr<PacketAnalyzer2026::Performance::PacketProcessingThreadPool> m_pipeline;
+    std::unique_ptr<FlowShardDispatcher> m_flowShards;
+
+    // Linux capture: one TPACKET_V3 ring per capture pool thread, joined in a PACKET_FANOUT
+    // group, each filling its own batch builder. A builder is only touched by its worker's
+    // thread while capturing; the fanout is declared last so its workers stop first.
+    // Elsewhere the engine's per-packet path is used.
+    bool m_ringCapture = false;
+    std::vector<std::unique_ptr<PacketAnalyzer2026::Core::PacketBatchBuilder>> m_batchBuilders;
+    std::atomic<uint64_t> m_packetSequence{0};
+    PacketAnalyzer2026::Core::FanoutCapture m_fanout;
+
+    // Frame-rate-bounded notification of the high-frequency properties
+    enum DirtyFlag : quint32 {
+        DirtyPacketCount       = 1 << 0,
+        DirtyBandwidth         = 1 << 1,
+        DirtyCpuUsage          = 1 << 2,
+        DirtyCaptureStatistics = 1 << 3
+    };
+    UiUpdateCoalescer* m_uiCoalescer;
 
 signals:
     void isCapturingChanged();
@@ -129,11 +220,12 @@ signals:
     void currentInterfaceChanged();
     void currentFilterChanged();
     void availableInterfacesChanged();
-    void packetsChanged();
     void protocolStatisticsChanged();
     void isAuthenticatedChanged();
     void currentUserChanged();
     void currentSessionIdChanged();
+    void checksumValidationChanged();
+    void captureStatisticsChanged();
     
     // User notifications
     void captureStarted(const QString& interface);
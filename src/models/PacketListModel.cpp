@@ -0,0 +1,203 @@
+#include "PacketListModel.h"
+
+using PacketAnalyzer2026::Core::PacketBatchPtr;
+using PacketAnalyzer2026::Core::PacketRecord;
+
+PacketListModel::PacketListModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_capacity(DEFAULT_CAPACITY)
+    , m_head(0)
+    , m_count(0)
+{
+    m_rows.resize(m_capacity);
+}
+
+int PacketListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant PacketListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_count) {
+        return QVariant();
+    }
+
+    // Strings are formatted here, for visible rows only
+    const PacketRecord& record = rowAt(index.row()).record;
+    switch (role) {
+        case NumberRole:     return static_cast<qulonglong>(record.number);
+        case TimestampRole:  return PacketRecordFormat::timestamp(record);
+        case TimeRole:       return QString::number(record.timestampNs / 1e9, 'f', 6);
+        case SourceRole:
+        case SourceIPRole:   return PacketRecordFormat::sourceAddress(record);
+        case DestRole:
+        case DestIPRole:     return PacketRecordFormat::destAddress(record);
+        case SourcePortRole: return record.sourcePort;
+        case DestPortRole:   return record.destPort;
+        case ProtocolRole:   return PacketRecordFormat::protocolName(record);
+        case LengthRole:     return QString::number(record.wireLength);
+        case SizeRole:       return record.wireLength;
+        case Qt::DisplayRole:
+        case InfoRole:       return PacketRecordFormat::info(record);
+        default:             return QVariant();
+    }
+}
+
+QHash<int, QByteArray> PacketListModel::roleNames() const
+{
+    return {
+        { NumberRole, "number" },
+        { TimestampRole, "timestamp" },
+        { TimeRole, "time" },
+        { SourceRole, "source" },
+        { SourceIPRole, "sourceIP" },
+        { DestRole, "dest" },
+        { DestIPRole, "destIP" },
+        { SourcePortRole, "sourcePort" },
+        { DestPortRole, "destPort" },
+        { ProtocolRole, "protocol" },
+        { LengthRole, "length" },
+        { SizeRole, "size" },
+        { InfoRole, "info" }
+    };
+}
+
+void PacketListModel::setCapacity(int capacity)
+{
+    if (capacity <= 0 || capacity == m_capacity) {
+        return;
+    }
+
+    // Keep the newest rows that still fit, re-based at slot 0
+    beginResetModel();
+    int keep = qMin(m_count, capacity);
+    std::vector<Row> rows(capacity);
+    for (int i = 0; i < keep; ++i) {
+        rows[i] = rowAt(m_count - keep + i);
+    }
+    m_rows.swap(rows);
+    m_capacity = capacity;
+    m_head = 0;
+    m_count = keep;
+    endResetModel();
+
+    emit capacityChanged();
+    emit countChanged();
+}
+
+const PacketRecord* PacketListModel::recordAt(int row) const
+{
+    if (row < 0 || row >= m_count) {
+        return nullptr;
+    }
+    return &rowAt(row).record;
+}
+
+PacketBatchPtr PacketListModel::batchAt(int row) const
+{
+    if (row < 0 || row >= m_count) {
+        return nullptr;
+    }
+    return rowAt(row).batch;
+}
+
+QVariantMap PacketListModel::get(int row) const
+{
+    const PacketRecord* record = recordAt(row);
+    if (!record) {
+        return QVariantMap();
+    }
+    return PacketRecordFormat::toJson(*record).toVariantMap();
+}
+
+QByteArray PacketListModel::rawData(int row) const
+{
+    const PacketRecord* record = recordAt(row);
+    if (!record || !rowAt(row).batch) {
+        return QByteArray();
+    }
+    const PacketBatchPtr& batch = rowAt(row).batch;
+    // Shares nothing with the arena on purpose: QML may hold it after the row is evicted
+    return QByteArray(reinterpret_cast<const char*>(batch->data(*record)), static_cast<int>(record->capturedLength));
+}
+
+void PacketListModel::clear()
+{
+    if (m_count == 0) {
+        return;
+    }
+
+    beginResetModel();
+    std::vector<Row>(m_capacity).swap(m_rows);
+    m_head = 0;
+    m_count = 0;
+    endResetModel();
+    emit countChanged();
+}
+
+void PacketListModel::appendBatch(const PacketBatchPtr& batch)
+{
+    if (batch && !batch->empty()) {
+        appendBatches({ batch });
+    }
+}
+
+void PacketListModel::appendBatches(const std::vector<PacketBatchPtr>& batches)
+{
+    size_t total = 0;
+    for (const auto& batch : batches) {
+        total += batch ? batch->size() : 0;
+    }
+    if (total == 0) {
+        return;
+    }
+
+    // Rows that would be evicted within this same call are never inserted
+    const int incoming = static_cast<int>(qMin<size_t>(total, static_cast<size_t>(m_capacity)));
+    size_t skip = total - incoming;
+
+    auto forEachIncoming = [&](auto&& store) {
+        size_t toSkip = skip;
+        int written = 0;
+        for (const auto& batch : batches) {
+            if (!batch) continue;
+            const auto& records = batch->records;
+            size_t first = qMin(toSkip, records.size());
+            toSkip -= first;
+            for (size_t i = first; i < records.size(); ++i) {
+                store(written++, Row{ records[i], batch });
+            }
+        }
+    };
+
+    // More new rows than the window holds replaces every row
+    if (incoming == m_capacity) {
+        beginResetModel();
+        forEachIncoming([this](int i, Row&& row) { m_rows[i] = std::move(row); });
+        m_head = 0;
+        m_count = incoming;
+        endResetModel();
+        emit countChanged();
+        return;
+    }
+
+    const int overflow = m_count + incoming - m_capacity;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        for (int i = 0; i < overflow; ++i) {
+            m_rows[(m_head + i) % m_capacity].batch.reset();
+        }
+        m_head = (m_head + overflow) % m_capacity;
+        m_count -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count + incoming - 1);
+    const int base = m_head + m_count;
+    forEachIncoming([this, base](int i, Row&& row) { m_rows[(base + i) % m_capacity] = std::move(row); });
+    m_count += incoming;
+    endInsertRows();
+
+    emit countChanged();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QVariantMap>
+#include <vector>
+#include "PacketRecordFormat.h"
+
+// List model for the packet table, backed by a fixed-capacity ring of binary records.
+// Appending a batch costs O(batch): rows are inserted at the end, and once the ring
+// is full the same number of oldest rows is removed from the front.
+class PacketListModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+
+public:
+    enum Roles {
+        NumberRole = Qt::UserRole + 1,
+        TimestampRole,
+        TimeRole,
+        SourceRole,
+        SourceIPRole,
+        DestRole,
+        DestIPRole,
+        SourcePortRole,
+        DestPortRole,
+        ProtocolRole,
+        LengthRole,
+        SizeRole,
+        InfoRole
+    };
+
+    static const int DEFAULT_CAPACITY = 100000;
+
+    explicit PacketListModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_count; }
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity);
+
+    const PacketAnalyzer2026::Core::PacketRecord* recordAt(int row) const;
+    PacketAnalyzer2026::Core::PacketBatchPtr batchAt(int row) const;
+
+    // Appends several batches with a single remove/insert pair, used once per UI frame
+    void appendBatches(const std::vector<PacketAnalyzer2026::Core::PacketBatchPtr>& batches);
+
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE QByteArray rawData(int row) const;
+    Q_INVOKABLE void clear();
+
+public slots:
+    void appendBatch(const PacketAnalyzer2026::Core::PacketBatchPtr& batch);
+
+signals:
+    void countChanged();
+    void capacityChanged();
+
+private:
+    struct Row {
+        PacketAnalyzer2026::Core::PacketRecord record;
+        PacketAnalyzer2026::Core::PacketBatchPtr batch;   // Owns the raw bytes
+    };
+
+    const Row& rowAt(int row) const { return m_rows[(m_head + row) % m_capacity]; }
+
+    std::vector<Row> m_rows;
+    int m_capacity;
+    int m_head;     // Ring slot of row 0
+    int m_count;
+};
@@ -0,0 +1,175 @@
+#include "PacketRecordFormat.h"
+#include <QDateTime>
+#include <QHostAddress>
+#include <QStringList>
+#include <cstring>
+
+using PacketAnalyzer2026::Core::PacketRecord;
+
+namespace {
+
+QString formatAddress(uint8_t ipVersion, const uint8_t* address)
+{
+    if (ipVersion == 4) {
+        quint32 ipv4 = (quint32(address[0]) << 24) | (quint32(address[1]) << 16) |
+                       (quint32(address[2]) << 8) | address[3];
+        return QHostAddress(ipv4).toString();
+    }
+    if (ipVersion == 6) {
+        return QHostAddress(address).toString();
+    }
+    return QString();
+}
+
+QString tcpFlagString(uint8_t flags)
+{
+    static const char* names[] = { "FIN", "SYN", "RST", "PSH", "ACK", "URG", "ECE", "CWR" };
+    QStringList set;
+    for (int bit = 0; bit < 8; ++bit) {
+        if (flags & (1 << bit)) {
+            set << names[bit];
+        }
+    }
+    return set.join(",");
+}
+
+} // namespace
+
+namespace PacketRecordFormat
+{
+
+QString sourceAddress(const PacketRecord& record)
+{
+    return formatAddress(record.ipVersion, record.sourceAddress);
+}
+
+QString destAddress(const PacketRecord& record)
+{
+    return formatAddress(record.ipVersion, record.destAddress);
+}
+
+QString address(uint8_t ipVersion, const uint8_t* address)
+{
+    return formatAddress(ipVersion, address);
+}
+
+QString protocolName(const PacketRecord& record)
+{
+    if (record.ipVersion == 0) {
+        return record.etherType == 0x0806 ? QStringLiteral("ARP")
+                                          : QString("0x%1").arg(record.etherType, 4, 16, QChar('0'));
+    }
+
+    if (record.appProtocol != 0) {
+        const std::string_view name = PacketAnalyzer2026::Protocols::DissectorRegistry::name(record.appProtocol);
+        return QString::fromLatin1(name.data(), static_cast<int>(name.size()));
+    }
+
+    switch (record.ipProtocol) {
+        case 1:  return QStringLiteral("ICMP");
+        case 6:  return QStringLiteral("TCP");
+        case 17: return QStringLiteral("UDP");
+        case 58: return QStringLiteral("ICMPv6");
+        default: return record.ipVersion == 6 ? QStringLiteral("IPv6") : QStringLiteral("IPv4");
+    }
+}
+
+QString info(const PacketRecord& record)
+{
+    if (record.flags & PacketAnalyzer2026::Core::PACKET_MALFORMED) {
+        return QStringLiteral("Malformed packet");
+    }
+    if (record.flags & PacketAnalyzer2026::Core::PACKET_FRAGMENT) {
+        return QStringLiteral("Fragmented IP datagram");
+    }
+    const QString reassembled = (record.flags & PacketAnalyzer2026::Core::PACKET_REASSEMBLED)
+        ? QStringLiteral(" (reassembled)") : QString();
+    if (record.ipProtocol == 6) {
+        return QString("%1 → %2 [%3]").arg(record.sourcePort).arg(record.destPort).arg(tcpFlagString(record.tcpFlags)) + reassembled;
+    }
+    if (record.ipProtocol == 17) {
+        return QString("%1 → %2").arg(record.sourcePort).arg(record.destPort) + reassembled;
+    }
+    return reassembled.trimmed();
+}
+
+// Outermost first, e.g. "VLAN / VXLAN"; empty for native traffic
+QString encapsulation(const PacketRecord& record)
+{
+    using PacketAnalyzer2026::Core::EncapsulationStack;
+
+    QStringList layers;
+    for (uint8_t i = 0; i < EncapsulationStack::MAX_LAYERS; ++i) {
+        const auto layer = EncapsulationStack::layer(record.encapsulation, i);
+        if (layer == PacketAnalyzer2026::Core::ENCAP_NONE) break;
+        layers << QString::fromLatin1(EncapsulationStack::name(layer));
+    }
+    return layers.join(QStringLiteral(" / "));
+}
+
+QString timestamp(const PacketRecord& record)
+{
+    return QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(record.timestampNs / 1000000))
+        .toString("yyyy-MM-dd hh:mm:ss.zzz");
+}
+
+QJsonObject toJson(const PacketRecord& record)
+{
+    QJsonObject obj;
+    QString source = sourceAddress(record);
+    QString dest = destAddress(record);
+    QString protocol = protocolName(record);
+    QString summary = info(record);
+
+    // Keys used by complete_interface.qml, PacketTableView.qml and DatabaseManager
+    obj["number"] = static_cast<qint64>(record.number);
+    obj["timestamp"] = timestamp(record);
+    obj["time"] = QString::number(record.timestampNs / 1e9, 'f', 6);
+    obj["source"] = source;
+    obj["sourceIP"] = source;
+    obj["dest"] = dest;
+    obj["destIP"] = dest;
+    obj["source_port"] = record.sourcePort;
+    obj["dest_port"] = record.destPort;
+    obj["protocol"] = protocol;
+    obj["length"] = QString::number(record.wireLength);
+    obj["size"] = static_cast<int>(record.wireLength);
+    obj["info"] = summary;
+    obj["encapsulation"] = encapsulation(record);
+    return obj;
+}
+
+PacketRecord fromJson(const QJsonObject& packet)
+{
+    PacketRecord record{};
+    record.number = static_cast<uint64_t>(packet["number"].toVariant().toULongLong());
+    record.wireLength = packet["length"].toString().toUInt();
+    record.sourcePort = static_cast<uint16_t>(packet["source_port"].toInt());
+    record.destPort = static_cast<uint16_t>(packet["dest_port"].toInt());
+
+    const QString protocol = packet["protocol"].toString();
+    record.ipProtocol = protocol == "TCP" ? 6 : protocol == "UDP" ? 17 : protocol == "ICMP" ? 1 : 0;
+
+    auto setAddress = [&record](const QString& text, uint8_t* out) {
+        QHostAddress address(text);
+        if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+            quint32 v4 = address.toIPv4Address();
+            out[0] = v4 >> 24; out[1] = v4 >> 16; out[2] = v4 >> 8; out[3] = v4;
+            record.ipVersion = 4;
+        } else if (address.protocol() == QAbstractSocket::IPv6Protocol) {
+            Q_IPV6ADDR v6 = address.toIPv6Address();
+            memcpy(out, v6.c, 16);
+            record.ipVersion = 6;
+        }
+    };
+    setAddress(packet["source"].toString(), record.sourceAddress);
+    setAddress(packet["dest"].toString(), record.destAddress);
+    return record;
+}
+
+void registerMetaTypes()
+{
+    qRegisterMetaType<PacketAnalyzer2026::Core::PacketBatchPtr>("PacketAnalyzer2026::Core::PacketBatchPtr");
+}
+
+} // namespace PacketRecordFormat
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QMetaType>
+#include <QString>
+#include "../core/PacketRecord.hpp"
+
+Q_DECLARE_METATYPE(PacketAnalyzer2026::Core::PacketBatchPtr)
+
+// Converts binary packet records into the strings and JSON rows QML expects.
+// Only called for rows the UI actually displays, never on the capture path.
+namespace PacketRecordFormat
+{
+    QString sourceAddress(const PacketAnalyzer2026::Core::PacketRecord& record);
+    QString destAddress(const PacketAnalyzer2026::Core::PacketRecord& record);
+    QString address(uint8_t ipVersion, const uint8_t* address);
+    QString protocolName(const PacketAnalyzer2026::Core::PacketRecord& record);
+    QString info(const PacketAnalyzer2026::Core::PacketRecord& record);
+    QString encapsulation(const PacketAnalyzer2026::Core::PacketRecord& record);
+    QString timestamp(const PacketAnalyzer2026::Core::PacketRecord& record);
+    QJsonObject toJson(const PacketAnalyzer2026::Core::PacketRecord& record);
+    // Inverse of toJson for the summary columns, for the engine's per-packet JSON rows
+    PacketAnalyzer2026::Core::PacketRecord fromJson(const QJsonObject& packet);
+
+    void registerMetaTypes();
+}
@@ -0,0 +1,158 @@
+#include "ProtocolTreeModel.h"
+#include "PacketListModel.h"
+
+using PacketAnalyzer2026::Core::DissectedField;
+using PacketAnalyzer2026::Core::PacketBatchPtr;
+using PacketAnalyzer2026::Core::PacketDissection;
+using PacketAnalyzer2026::Core::PacketDissector;
+using PacketAnalyzer2026::Core::PacketRecord;
+
+ProtocolTreeModel::ProtocolTreeModel(QObject* parent)
+    : QAbstractItemModel(parent)
+    , m_source(nullptr)
+    , m_packetNumber(0)
+{
+}
+
+// Each index stores its field's position in the flat dissection vector as the internal id
+QModelIndex ProtocolTreeModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (column != 0 || row < 0) {
+        return QModelIndex();
+    }
+
+    const DissectedField* parentField = fieldFor(parent);
+    if (parent.isValid() && !parentField) {
+        return QModelIndex();
+    }
+    const std::vector<int32_t>& siblings = parentField ? parentField->children : m_dissection.layers;
+    if (row >= static_cast<int>(siblings.size())) {
+        return QModelIndex();
+    }
+    return createIndex(row, 0, static_cast<quintptr>(siblings[row]));
+}
+
+QModelIndex ProtocolTreeModel::parent(const QModelIndex& child) const
+{
+    const DissectedField* field = fieldFor(child);
+    if (!field || field->parent < 0) {
+        return QModelIndex();
+    }
+    return indexOf(field->parent);
+}
+
+int ProtocolTreeModel::rowCount(const QModelIndex& parent) const
+{
+    if (!parent.isValid()) {
+        return static_cast<int>(m_dissection.layers.size());
+    }
+    const DissectedField* field = fieldFor(parent);
+    return field ? static_cast<int>(field->children.size()) : 0;
+}
+
+int ProtocolTreeModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return 1;
+}
+
+QVariant ProtocolTreeModel::data(const QModelIndex& index, int role) const
+{
+    const DissectedField* field = fieldFor(index);
+    if (!field) {
+        return QVariant();
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+        case LabelRole:      return QString::fromStdString(field->label);
+        case OffsetRole:     return field->offset;
+        case LengthRole:     return field->length;
+        case IsLayerRole:    return field->parent < 0;
+        default:             return QVariant();
+    }
+}
+
+QHash<int, QByteArray> ProtocolTreeModel::roleNames() const
+{
+    return {
+        { Qt::DisplayRole, "display" },
+        { LabelRole, "label" },
+        { OffsetRole, "offset" },
+        { LengthRole, "length" },
+        { IsLayerRole, "isLayer" }
+    };
+}
+
+void ProtocolTreeModel::setPacket(const PacketBatchPtr& batch, const PacketRecord& record)
+{
+    if (!batch || record.dataOffset + static_cast<size_t>(record.capturedLength) > batch->bytes.size()) {
+        clear();
+        return;
+    }
+
+    // The only place deep dissection runs, once per selection
+    PacketDissection dissection = PacketDissector::dissect(batch->data(record), record.capturedLength, record.wireLength);
+
+    beginResetModel();
+    m_dissection = std::move(dissection);
+    m_packetNumber = record.number;
+    endResetModel();
+    emit packetChanged();
+}
+
+void ProtocolTreeModel::showRow(int row)
+{
+    const PacketRecord* record = m_source ? m_source->recordAt(row) : nullptr;
+    if (!record) {
+        clear();
+        return;
+    }
+    setPacket(m_source->batchAt(row), *record);
+}
+
+void ProtocolTreeModel::clear()
+{
+    if (m_dissection.fields.empty()) {
+        return;
+    }
+
+    beginResetModel();
+    m_dissection = PacketDissection{};
+    m_packetNumber = 0;
+    endResetModel();
+    emit packetChanged();
+}
+
+QModelIndex ProtocolTreeModel::fieldAt(int byteOffset) const
+{
+    if (byteOffset < 0) {
+        return QModelIndex();
+    }
+    return indexOf(m_dissection.fieldAt(static_cast<uint32_t>(byteOffset)));
+}
+
+QVariantMap ProtocolTreeModel::byteRange(const QModelIndex& index) const
+{
+    QVariantMap range;
+    const DissectedField* field = fieldFor(index);
+    range["offset"] = field ? static_cast<int>(field->offset) : -1;
+    range["length"] = field ? static_cast<int>(field->length) : 0;
+    return range;
+}
+
+const DissectedField* ProtocolTreeModel::fieldFor(const QModelIndex& index) const
+{
+    if (!index.isValid() || index.model() != this || index.internalId() >= m_dissection.fields.size()) {
+        return nullptr;
+    }
+    return &m_dissection.fields[index.internalId()];
+}
+
+QModelIndex ProtocolTreeModel::indexOf(int32_t field) const
+{
+    if (field < 0 || field >= static_cast<int32_t>(m_dissection.fields.size())) {
+        return QModelIndex();
+    }
+    return createIndex(m_dissection.fields[field].row, 0, static_cast<quintptr>(field));
+}
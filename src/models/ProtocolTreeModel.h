@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QVariantMap>
+#include "PacketRecordFormat.h"
+#include "../core/PacketDissector.hpp"
+
+class PacketListModel;
+
+// Field tree of the selected packet. Nothing is dissected on the capture path: showRow()
+// runs the full dissector over the row's stored raw bytes once, when the analyst selects it.
+// Every node carries the byte range it was decoded from for highlighting in the hex view.
+class ProtocolTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+    Q_PROPERTY(qulonglong packetNumber READ packetNumber NOTIFY packetChanged)
+    Q_PROPERTY(int fieldCount READ fieldCount NOTIFY packetChanged)
+
+public:
+    enum Roles {
+        LabelRole = Qt::UserRole + 1,
+        OffsetRole,
+        LengthRole,
+        IsLayerRole
+    };
+
+    explicit ProtocolTreeModel(QObject* parent = nullptr);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    qulonglong packetNumber() const { return m_packetNumber; }
+    int fieldCount() const { return static_cast<int>(m_dissection.fields.size()); }
+
+    void setSource(PacketListModel* packets) { m_source = packets; }
+    void setPacket(const PacketAnalyzer2026::Core::PacketBatchPtr& batch,
+                   const PacketAnalyzer2026::Core::PacketRecord& record);
+
+    Q_INVOKABLE void showRow(int row);
+    Q_INVOKABLE void clear();
+
+    // Narrowest field covering a byte, for selecting the tree node of a clicked hex byte
+    Q_INVOKABLE QModelIndex fieldAt(int byteOffset) const;
+    // {offset, length} of a node, for highlighting its bytes in the hex view
+    Q_INVOKABLE QVariantMap byteRange(const QModelIndex& index) const;
+
+signals:
+    void packetChanged();
+
+private:
+    const PacketAnalyzer2026::Core::DissectedField* fieldFor(const QModelIndex& index) const;
+    QModelIndex indexOf(int32_t field) const;
+
+    PacketListModel* m_source;
+    PacketAnalyzer2026::Core::PacketDissection m_dissection;
+    qulonglong m_packetNumber;
+};
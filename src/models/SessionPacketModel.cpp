@@ -0,0 +1,189 @@
+#include "SessionPacketModel.h"
+#include "../database/DatabaseManager.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QDebug>
+
+SessionPacketModel::SessionPacketModel(DatabaseManager* database, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_database(database)
+    , m_sessionId(-1)
+    , m_totalCount(0)
+    , m_firstRow(0)
+    , m_exposedRows(0)
+    , m_pages(CACHED_PAGES)
+{
+}
+
+int SessionPacketModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_exposedRows;
+}
+
+QVariant SessionPacketModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) {
+        return QVariant();
+    }
+
+    const QJsonObject* packet = rowAt(index.row());
+    if (!packet) {
+        return QVariant();
+    }
+
+    switch (role) {
+        case NumberRole:     return (*packet)["number"].toVariant();
+        case TimestampRole:
+            return QDateTime::fromMSecsSinceEpoch((*packet)["timestamp_ns"].toVariant().toLongLong() / 1000000)
+                .toString("yyyy-MM-dd hh:mm:ss.zzz");
+        case TimeRole:
+            return QString::number((*packet)["timestamp_ns"].toVariant().toLongLong() / 1e9, 'f', 6);
+        case SourceRole:
+        case SourceIPRole:   return (*packet)["source"].toString();
+        case DestRole:
+        case DestIPRole:     return (*packet)["dest"].toString();
+        case SourcePortRole: return (*packet)["source_port"].toInt();
+        case DestPortRole:   return (*packet)["dest_port"].toInt();
+        case ProtocolRole:   return (*packet)["protocol"].toString();
+        case LengthRole:     return (*packet)["length"].toString();
+        case SizeRole:       return (*packet)["size"].toInt();
+        case Qt::DisplayRole:
+        case InfoRole:       return (*packet)["info"].toString();
+        default:             return QVariant();
+    }
+}
+
+QHash<int, QByteArray> SessionPacketModel::roleNames() const
+{
+    // Same role names as PacketListModel so the table delegates work with either model
+    return {
+        { NumberRole, "number" },
+        { TimestampRole, "timestamp" },
+        { TimeRole, "time" },
+        { SourceRole, "source" },
+        { SourceIPRole, "sourceIP" },
+        { DestRole, "dest" },
+        { DestIPRole, "destIP" },
+        { SourcePortRole, "sourcePort" },
+        { DestPortRole, "destPort" },
+        { ProtocolRole, "protocol" },
+        { LengthRole, "length" },
+        { SizeRole, "size" },
+        { InfoRole, "info" }
+    };
+}
+
+bool SessionPacketModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && m_exposedRows < m_totalCount;
+}
+
+void SessionPacketModel::fetchMore(const QModelIndex& parent)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    // Only grows rowCount; rows are read when a delegate first asks for them
+    qint64 remaining = m_totalCount - m_exposedRows;
+    int step = static_cast<int>(qMin<qint64>(remaining, FETCH_STEP));
+    if (step <= 0) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), m_exposedRows, m_exposedRows + step - 1);
+    m_exposedRows += step;
+    endInsertRows();
+    emit countChanged();
+}
+
+bool SessionPacketModel::loadSession(int sessionId)
+{
+    if (!m_database || !m_database->isConnected()) {
+        return false;
+    }
+
+    QJsonObject range = m_database->getPacketRowRange(sessionId);
+
+    beginResetModel();
+    m_pages.clear();
+    m_sessionId = sessionId;
+    m_totalCount = qMin<qint64>(range["count"].toVariant().toLongLong(), INT_MAX);
+    m_firstRow = range["first"].toVariant().toLongLong();
+    m_exposedRows = static_cast<int>(qMin<qint64>(m_totalCount, FETCH_STEP));
+    endResetModel();
+
+    emit sessionChanged();
+    emit countChanged();
+    return m_totalCount > 0;
+}
+
+void SessionPacketModel::clear()
+{
+    beginResetModel();
+    m_pages.clear();
+    m_sessionId = -1;
+    m_totalCount = 0;
+    m_firstRow = 0;
+    m_exposedRows = 0;
+    endResetModel();
+
+    emit sessionChanged();
+    emit countChanged();
+}
+
+QVariantMap SessionPacketModel::get(int row) const
+{
+    const QJsonObject* packet = rowAt(row);
+    return packet ? packet->toVariantMap() : QVariantMap();
+}
+
+void SessionPacketModel::ensureRowAvailable(int row)
+{
+    if (row < m_exposedRows || row >= m_totalCount) {
+        return;
+    }
+
+    int target = static_cast<int>(qMin<qint64>(m_totalCount, (static_cast<qint64>(row) / FETCH_STEP + 1) * FETCH_STEP));
+    beginInsertRows(QModelIndex(), m_exposedRows, target - 1);
+    m_exposedRows = target;
+    endInsertRows();
+    emit countChanged();
+}
+
+const QJsonObject* SessionPacketModel::rowAt(int row) const
+{
+    if (row < 0 || row >= m_exposedRows) {
+        return nullptr;
+    }
+
+    Page* page = loadPage(row / PAGE_SIZE);
+    int offset = row % PAGE_SIZE;
+    if (!page || offset >= page->rows.size()) {
+        return nullptr;
+    }
+    return &page->rows[offset];
+}
+
+SessionPacketModel::Page* SessionPacketModel::loadPage(int page) const
+{
+    if (Page* cached = m_pages.object(page)) {
+        return cached;
+    }
+    if (!m_database) {
+        return nullptr;
+    }
+
+    // Ordinals are dense from m_firstRow, so the page's keyset start needs no lookup
+    const qint64 firstRow = m_firstRow + static_cast<qint64>(page) * PAGE_SIZE;
+    QJsonArray packets = m_database->getPacketMetadataAt(m_sessionId, firstRow, PAGE_SIZE);
+
+    auto* loaded = new Page;
+    loaded->rows.reserve(packets.size());
+    for (const QJsonValue& packet : packets) {
+        loaded->rows.append(packet.toObject());
+    }
+
+    m_pages.insert(page, loaded);
+    return m_pages.object(page);
+}
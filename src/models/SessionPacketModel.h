@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <QJsonObject>
+#include <QVector>
+#include <QVariantMap>
+
+class DatabaseManager;
+
+// Read-only list model over one stored capture session, sized for tens of millions of rows.
+// rowCount grows through canFetchMore/fetchMore as the view scrolls; row data is loaded a page
+// at a time and kept in a small LRU page cache. Stored packets carry a dense per-session
+// row_ordinal, so a page's keyset start is first + page * PAGE_SIZE and loading any page, near
+// or far, costs one indexed range read.
+class SessionPacketModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int sessionId READ sessionId NOTIFY sessionChanged)
+    Q_PROPERTY(qint64 totalCount READ totalCount NOTIFY sessionChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        NumberRole = Qt::UserRole + 1,
+        TimestampRole,
+        TimeRole,
+        SourceRole,
+        SourceIPRole,
+        DestRole,
+        DestIPRole,
+        SourcePortRole,
+        DestPortRole,
+        ProtocolRole,
+        LengthRole,
+        SizeRole,
+        InfoRole
+    };
+
+    static const int PAGE_SIZE = 256;
+    static const int CACHED_PAGES = 64;
+    static const int FETCH_STEP = 4096;
+
+    explicit SessionPacketModel(DatabaseManager* database, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    int sessionId() const { return m_sessionId; }
+    qint64 totalCount() const { return m_totalCount; }
+    int count() const { return m_exposedRows; }
+
+    Q_INVOKABLE bool loadSession(int sessionId);
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE QVariantMap get(int row) const;
+    // Exposes rows up to and including the given one, for jumping to a packet far ahead
+    Q_INVOKABLE void ensureRowAvailable(int row);
+
+signals:
+    void sessionChanged();
+    void countChanged();
+
+private:
+    struct Page {
+        QVector<QJsonObject> rows;
+    };
+
+    const QJsonObject* rowAt(int row) const;
+    Page* loadPage(int page) const;
+
+    DatabaseManager* m_database;
+    int m_sessionId;
+    qint64 m_totalCount;
+    qint64 m_firstRow;                    // row_ordinal of the session's first packet
+    int m_exposedRows;
+    mutable QCache<int, Page> m_pages;
+};
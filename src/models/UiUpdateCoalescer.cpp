@@ -0,0 +1,93 @@
+#include "UiUpdateCoalescer.h"
+
+UiUpdateCoalescer::UiUpdateCoalescer(int frameRateHz, QObject* parent)
+    : QObject(parent)
+    , m_dirty(0)
+    , m_pendingRows(0)
+    , m_rowBudget(100000)
+    , m_frameRate(0)
+    , m_baseIntervalMs(16)
+    , m_currentIntervalMs(16)
+    , m_shedRows(0)
+    , m_lateFrames(0)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &UiUpdateCoalescer::onFrame);
+    setFrameRate(frameRateHz);
+}
+
+void UiUpdateCoalescer::setFrameRate(int frameRateHz)
+{
+    m_frameRate = qBound(1, frameRateHz, 240);
+    m_baseIntervalMs = qMax(1, 1000 / m_frameRate);
+    m_currentIntervalMs = m_baseIntervalMs;
+}
+
+void UiUpdateCoalescer::markDirty(quint32 flags)
+{
+    m_dirty |= flags;
+    scheduleFrame();
+}
+
+void UiUpdateCoalescer::enqueueBatch(const PacketAnalyzer2026::Core::PacketBatchPtr& batch)
+{
+    if (!batch || batch->empty()) {
+        return;
+    }
+
+    m_pending.push_back(batch);
+    m_pendingRows += batch->size();
+    shedToBudget();
+    scheduleFrame();
+}
+
+std::vector<PacketAnalyzer2026::Core::PacketBatchPtr> UiUpdateCoalescer::takePendingBatches()
+{
+    std::vector<PacketAnalyzer2026::Core::PacketBatchPtr> batches;
+    batches.swap(m_pending);
+    m_pendingRows = 0;
+    return batches;
+}
+
+void UiUpdateCoalescer::scheduleFrame()
+{
+    // The timer only runs while something is pending, so an idle UI costs no wakeups
+    if (!m_timer.isActive()) {
+        m_sinceScheduled.start();
+        m_timer.start(m_currentIntervalMs);
+    }
+}
+
+void UiUpdateCoalescer::shedToBudget()
+{
+    // Whole batches older than the budget would be evicted from the view on arrival anyway
+    size_t drop = 0;
+    while (drop < m_pending.size() && m_pendingRows - m_pending[drop]->size() >= m_rowBudget) {
+        m_pendingRows -= m_pending[drop]->size();
+        m_shedRows += m_pending[drop]->size();
+        ++drop;
+    }
+    if (drop > 0) {
+        m_pending.erase(m_pending.begin(), m_pending.begin() + drop);
+    }
+}
+
+void UiUpdateCoalescer::onFrame()
+{
+    // A frame that fires well past its deadline means the event loop is saturated:
+    // back off the frame rate, and recover gradually once frames are on time again
+    qint64 elapsed = m_sinceScheduled.elapsed();
+    if (elapsed > 2 * m_currentIntervalMs) {
+        m_lateFrames++;
+        m_currentIntervalMs = qMin(m_currentIntervalMs * 2, MAX_INTERVAL_MS);
+    } else if (m_currentIntervalMs > m_baseIntervalMs) {
+        m_currentIntervalMs = qMax(m_baseIntervalMs, m_currentIntervalMs / 2);
+    }
+
+    quint32 flags = m_dirty;
+    m_dirty = 0;
+    if (flags != 0 || !m_pending.empty()) {
+        emit frameReady(flags);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <vector>
+#include "../core/PacketRecord.hpp"
+
+// Collects model changes and publishes them at most once per display frame.
+// Producers only set dirty bits or queue batches; frameReady() fires on the next
+// frame tick with everything that changed since the previous one. When the event
+// loop falls behind, the frame interval backs off and queued rows that could never
+// be shown are dropped, so UI work stays bounded no matter how fast packets arrive.
+class UiUpdateCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UiUpdateCoalescer(int frameRateHz = 60, QObject* parent = nullptr);
+
+    void setFrameRate(int frameRateHz);
+    int frameRate() const { return m_frameRate; }
+    int effectiveFrameRate() const { return 1000 / m_currentIntervalMs; }
+
+    // Pending rows beyond this are shed oldest-first; set it to the list model's capacity
+    void setRowBudget(size_t rows) { m_rowBudget = rows; }
+
+    void markDirty(quint32 flags);
+    void enqueueBatch(const PacketAnalyzer2026::Core::PacketBatchPtr& batch);
+    std::vector<PacketAnalyzer2026::Core::PacketBatchPtr> takePendingBatches();
+
+    quint64 shedRows() const { return m_shedRows; }
+    quint64 lateFrames() const { return m_lateFrames; }
+
+signals:
+    void frameReady(quint32 dirtyFlags);
+
+private slots:
+    void onFrame();
+
+private:
+    void scheduleFrame();
+    void shedToBudget();
+
+    QTimer m_timer;
+    QElapsedTimer m_sinceScheduled;
+    quint32 m_dirty;
+    std::vector<PacketAnalyzer2026::Core::PacketBatchPtr> m_pending;
+    size_t m_pendingRows;
+    size_t m_rowBudget;
+    int m_frameRate;
+    int m_baseIntervalMs;
+    int m_currentIntervalMs;
+    quint64 m_shedRows;
+    quint64 m_lateFrames;
+
+    static const int MAX_INTERVAL_MS = 250;
+};
@@ -0,0 +1,102 @@
+// BufferPool.hpp - Fixed-budget pool of equal-sized blocks chained by index
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+
+namespace PacketAnalyzer2026::Performance {
+
+// One up-front arena split into blocks that link into chains through a parallel index array,
+// so a chain costs 4 bytes per block of metadata and no per-allocation heap traffic. When
+// the budget is used up allocate() fails instead of growing; callers decide what to drop.
+//
+// Not thread-safe: each capture worker owns its pool, and flow affinity keeps every flow's
+// buffers on one worker. Split the global budget across workers when creating them.
+class BufferPool {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+private:
+    std::unique_ptr<uint8_t[]> arena_;
+    std::unique_ptr<uint32_t[]> next_;
+    uint32_t blockSize_;
+    uint32_t blockCount_;
+    uint32_t freeHead_;
+    uint32_t freeBlocks_;
+    uint64_t allocationFailures_ = 0;
+    std::string name_;
+
+public:
+    BufferPool(size_t budgetBytes, uint32_t blockSize, const std::string& name)
+        : blockSize_(blockSize)
+        , blockCount_(0)
+        , freeHead_(NONE)
+        , freeBlocks_(0)
+        , name_(name)
+    {
+        if (blockSize == 0 || budgetBytes < blockSize) {
+            throw std::invalid_argument("Buffer pool '" + name + "' budget must hold at least one block");
+        }
+        if (budgetBytes / blockSize >= NONE) {
+            throw std::invalid_argument("Buffer pool '" + name + "' has too many blocks for 32-bit indices");
+        }
+
+        blockCount_ = static_cast<uint32_t>(budgetBytes / blockSize);
+        arena_.reset(new uint8_t[static_cast<size_t>(blockCount_) * blockSize_]);
+        next_.reset(new uint32_t[blockCount_]);
+        for (uint32_t i = 0; i < blockCount_; ++i) {
+            next_[i] = i + 1 < blockCount_ ? i + 1 : NONE;
+        }
+        freeHead_ = 0;
+        freeBlocks_ = blockCount_;
+
+        std::cout << "🧱 Buffer pool '" << name_ << "': " << blockCount_ << " x " << blockSize_
+                  << " byte blocks (" << (static_cast<size_t>(blockCount_) * blockSize_ >> 20) << " MiB)" << std::endl;
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // Returns NONE when the budget is exhausted
+    uint32_t allocate() {
+        if (freeHead_ == NONE) {
+            allocationFailures_++;
+            return NONE;
+        }
+        uint32_t block = freeHead_;
+        freeHead_ = next_[block];
+        next_[block] = NONE;
+        freeBlocks_--;
+        return block;
+    }
+
+    // Returns a whole chain starting at head to the free list
+    void releaseChain(uint32_t head) {
+        while (head != NONE) {
+            uint32_t following = next_[head];
+            next_[head] = freeHead_;
+            freeHead_ = head;
+            freeBlocks_++;
+            head = following;
+        }
+    }
+
+    uint8_t* data(uint32_t block) { return arena_.get() + static_cast<size_t>(block) * blockSize_; }
+    const uint8_t* data(uint32_t block) const { return arena_.get() + static_cast<size_t>(block) * blockSize_; }
+
+    uint32_t next(uint32_t block) const { return next_[block]; }
+    void link(uint32_t block, uint32_t following) { next_[block] = following; }
+
+    uint32_t blockSize() const { return blockSize_; }
+    uint32_t blockCount() const { return blockCount_; }
+    uint32_t freeBlocks() const { return freeBlocks_; }
+    size_t bytesInUse() const { return static_cast<size_t>(blockCount_ - freeBlocks_) * blockSize_; }
+    uint64_t allocationFailures() const { return allocationFailures_; }
+    const std::string& name() const { return name_; }
+};
+
+} // namespace PacketAnalyzer2026::Performance
@@ -0,0 +1,28 @@
+// CpuFeatures.hpp - Compiler-portable instruction-set detection and bit scans
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// MSVC never defines __SSE2__; SSE2 is the x64 baseline and /arch:SSE2 on x86
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PA2026_HAVE_SSE2 1
+#endif
+
+namespace PacketAnalyzer2026::Performance {
+
+// Index of the lowest set bit; value must be non-zero
+inline unsigned countTrailingZeros(uint32_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+}
+
+} // namespace PacketAnalyzer2026::Performance
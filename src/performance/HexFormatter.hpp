@@ -0,0 +1,123 @@
+// HexFormatter.hpp - Vectorized hex and printable-ASCII formatting of raw packet bytes
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CpuFeatures.hpp"
+
+#if defined(PA2026_HAVE_SSE2)
+#include <emmintrin.h>
+#define PA2026_HEX_SSE2 1
+#elif defined(__aarch64__)
+// vqtbl1q_u8 is AArch64-only; 32-bit ARM NEON takes the scalar path
+#include <arm_neon.h>
+#define PA2026_HEX_NEON 1
+#endif
+
+namespace PacketAnalyzer2026::Performance {
+
+// Formats one dump line at a time: 16 bytes become 32 lowercase hex digits and 16 ASCII
+// characters with everything outside 0x20..0x7E shown as '.'. Both kernels cover SSE2 and
+// NEON, the baseline of x86-64 and AArch64, so no runtime dispatch is needed.
+class HexFormatter {
+public:
+    static constexpr size_t BYTES_PER_LINE = 16;
+
+    // Writes 2 * length hex digits to out; length may be anything up to BYTES_PER_LINE
+    static void toHex(const uint8_t* bytes, size_t length, char* out) {
+#if defined(PA2026_HEX_SSE2)
+        if (length == BYTES_PER_LINE) {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+            const __m128i lowMask = _mm_set1_epi8(0x0F);
+            const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), lowMask);
+            const __m128i low = _mm_and_si128(input, lowMask);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), nibblesToAscii(_mm_unpacklo_epi8(high, low)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), nibblesToAscii(_mm_unpackhi_epi8(high, low)));
+            return;
+        }
+#elif defined(PA2026_HEX_NEON)
+        if (length == BYTES_PER_LINE) {
+            const uint8x16_t input = vld1q_u8(bytes);
+            uint8x16x2_t digits;
+            digits.val[0] = nibblesToAscii(vshrq_n_u8(input, 4));
+            digits.val[1] = nibblesToAscii(vandq_u8(input, vdupq_n_u8(0x0F)));
+            vst2q_u8(reinterpret_cast<uint8_t*>(out), digits);
+            return;
+        }
+#endif
+        static constexpr char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < length; ++i) {
+            out[2 * i] = digits[bytes[i] >> 4];
+            out[2 * i + 1] = digits[bytes[i] & 0x0F];
+        }
+    }
+
+    // Writes length characters to out, replacing non-printable bytes with '.'
+    static void toPrintable(const uint8_t* bytes, size_t length, char* out) {
+#if defined(PA2026_HEX_SSE2)
+        if (length == BYTES_PER_LINE) {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+            // Signed compares: bytes >= 0x80 are negative and fail the lower bound
+            const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8(0x1F)),
+                                                    _mm_cmplt_epi8(input, _mm_set1_epi8(0x7F)));
+            const __m128i result = _mm_or_si128(_mm_and_si128(printable, input),
+                                                _mm_andnot_si128(printable, _mm_set1_epi8('.')));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+            return;
+        }
+#elif defined(PA2026_HEX_NEON)
+        if (length == BYTES_PER_LINE) {
+            const uint8x16_t input = vld1q_u8(bytes);
+            const uint8x16_t printable = vandq_u8(vcgeq_u8(input, vdupq_n_u8(0x20)), vcleq_u8(input, vdupq_n_u8(0x7E)));
+            vst1q_u8(reinterpret_cast<uint8_t*>(out), vbslq_u8(printable, input, vdupq_n_u8('.')));
+            return;
+        }
+#endif
+        for (size_t i = 0; i < length; ++i) {
+            out[i] = isPrintable(bytes[i]) ? static_cast<char>(bytes[i]) : '.';
+        }
+    }
+
+    static constexpr bool isPrintable(uint8_t byte) {
+        return byte >= 0x20 && byte <= 0x7E;
+    }
+
+    // Length of the printable run starting at bytes[0], scanning 16 bytes per step
+    static size_t printableRun(const uint8_t* bytes, size_t length) {
+        size_t run = 0;
+#if defined(PA2026_HEX_SSE2)
+        while (run + 16 <= length) {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + run));
+            const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8(0x1F)),
+                                                    _mm_cmplt_epi8(input, _mm_set1_epi8(0x7F)));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(printable));
+            if (mask != 0xFFFF) {
+                return run + static_cast<size_t>(countTrailingZeros(~mask));
+            }
+            run += 16;
+        }
+#endif
+        while (run < length && isPrintable(bytes[run])) {
+            ++run;
+        }
+        return run;
+    }
+
+private:
+#if defined(PA2026_HEX_SSE2)
+    // 0..9 -> '0'..'9', 10..15 -> 'a'..'f'
+    static __m128i nibblesToAscii(__m128i nibbles) {
+        const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+        return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+    }
+#elif defined(PA2026_HEX_NEON)
+    static uint8x16_t nibblesToAscii(uint8x16_t nibbles) {
+        static const uint8_t table[16] = { '0', '1', '2', '3', '4', '5', '6', '7',
+                                           '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+        return vqtbl1q_u8(vld1q_u8(table), nibbles);
+    }
+#endif
+};
+
+} // namespace PacketAnalyzer2026::Performance
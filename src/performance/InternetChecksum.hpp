@@ -0,0 +1,134 @@
+// InternetChecksum.hpp - Vectorized RFC 1071 ones'-complement sums for IP, TCP and UDP checksums
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "CpuFeatures.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PA2026_CSUM_AVX2 1
+#elif defined(PA2026_HAVE_SSE2)
+#include <emmintrin.h>
+#define PA2026_CSUM_SSE2 1
+#endif
+
+namespace PacketAnalyzer2026::Performance {
+
+// The ones'-complement sum is independent of byte order (RFC 1071 2(B)), so the kernels
+// add native 16-bit words and only the folded result is swapped to network order. AVX2
+// and SSE2 widen words into 32-bit lanes; the scalar path adds 32-bit halves into a
+// 64-bit accumulator, 8 bytes at a time.
+class InternetChecksum {
+private:
+    static uint16_t foldNative(uint64_t sum) {
+        while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+        const uint16_t folded = static_cast<uint16_t>(sum);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return folded;
+#else
+        return static_cast<uint16_t>((folded << 8) | (folded >> 8));
+#endif
+    }
+
+#if defined(PA2026_CSUM_AVX2)
+    static uint64_t reduce(__m256i lanes) {
+        alignas(32) uint32_t words[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words), lanes);
+        uint64_t sum = 0;
+        for (uint32_t word : words) sum += word;
+        return sum;
+    }
+#elif defined(PA2026_CSUM_SSE2)
+    static uint64_t reduce(__m128i lanes) {
+        alignas(16) uint32_t words[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(words), lanes);
+        return static_cast<uint64_t>(words[0]) + words[1] + words[2] + words[3];
+    }
+#endif
+
+public:
+    // Folded 16-bit sum of data in network byte order, not complemented. Sums of pieces
+    // can be combined with add(), as long as every piece but the last has even length.
+    static uint16_t sum(const uint8_t* data, size_t length) {
+        uint64_t total = 0;
+        size_t i = 0;
+
+        // Each 32-bit lane gains at most 2 * 0xFFFF per step; flushing every 4096 steps
+        // keeps lanes far from overflow for any length
+#if defined(PA2026_CSUM_AVX2)
+        const __m256i zero = _mm256_setzero_si256();
+        while (i + 32 <= length) {
+            __m256i lanes = zero;
+            const size_t stop = i + std::min<size_t>((length - i) & ~size_t(31), 4096 * 32);
+            for (; i + 64 <= stop; i += 64) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+                lanes = _mm256_add_epi32(lanes, _mm256_add_epi32(_mm256_unpacklo_epi16(a, zero), _mm256_unpackhi_epi16(a, zero)));
+                lanes = _mm256_add_epi32(lanes, _mm256_add_epi32(_mm256_unpacklo_epi16(b, zero), _mm256_unpackhi_epi16(b, zero)));
+            }
+            for (; i + 32 <= stop; i += 32) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                lanes = _mm256_add_epi32(lanes, _mm256_add_epi32(_mm256_unpacklo_epi16(a, zero), _mm256_unpackhi_epi16(a, zero)));
+            }
+            total += reduce(lanes);
+        }
+#elif defined(PA2026_CSUM_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        while (i + 16 <= length) {
+            __m128i lanes = zero;
+            const size_t stop = i + std::min<size_t>((length - i) & ~size_t(15), 4096 * 16);
+            for (; i + 32 <= stop; i += 32) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+                lanes = _mm_add_epi32(lanes, _mm_add_epi32(_mm_unpacklo_epi16(a, zero), _mm_unpackhi_epi16(a, zero)));
+                lanes = _mm_add_epi32(lanes, _mm_add_epi32(_mm_unpacklo_epi16(b, zero), _mm_unpackhi_epi16(b, zero)));
+            }
+            for (; i + 16 <= stop; i += 16) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                lanes = _mm_add_epi32(lanes, _mm_add_epi32(_mm_unpacklo_epi16(a, zero), _mm_unpackhi_epi16(a, zero)));
+            }
+            total += reduce(lanes);
+        }
+#endif
+        for (; i + 8 <= length; i += 8) {
+            uint32_t halves[2];
+            std::memcpy(halves, data + i, 8);
+            total += static_cast<uint64_t>(halves[0]) + halves[1];
+        }
+        for (; i + 2 <= length; i += 2) {
+            uint16_t word;
+            std::memcpy(&word, data + i, 2);
+            total += word;
+        }
+        if (i < length) {
+            // The odd byte is the high half of a zero-padded network-order word
+            const uint8_t padded[2] = { data[i], 0 };
+            uint16_t word;
+            std::memcpy(&word, padded, 2);
+            total += word;
+        }
+        return foldNative(total);
+    }
+
+    // Ones'-complement addition of two folded sums (or plain network-order words)
+    static uint16_t add(uint16_t a, uint16_t b) {
+        const uint32_t total = static_cast<uint32_t>(a) + b;
+        return static_cast<uint16_t>((total & 0xFFFF) + (total >> 16));
+    }
+
+    // A received header or segment, checksum field included, is intact when this is 0xFFFF
+    static uint16_t verify(const uint8_t* data, size_t length, uint16_t pseudoHeader = 0) {
+        return add(sum(data, length), pseudoHeader);
+    }
+
+    // Checksum field value for data whose own checksum field is zero
+    static uint16_t compute(const uint8_t* data, size_t length, uint16_t pseudoHeader = 0) {
+        return static_cast<uint16_t>(~verify(data, length, pseudoHeader));
+    }
+};
+
+} // namespace PacketAnalyzer2026::Performance
@@ -0,0 +1,157 @@
+// MpmcQueue.hpp - Bounded lock-free multi-producer multi-consumer ring (Vyukov sequence cells)
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace PacketAnalyzer2026::Performance {
+
+// Each cell carries a sequence number that says whose turn it is: producers claim a cell
+// whose sequence equals their ticket, consumers one whose sequence is ticket + 1. A push
+// or pop is one CAS on the shared position plus one store to the cell, with no locks and
+// no allocation after construction. Both ends fail rather than wait when full or empty.
+// The batched calls check a run of consecutive cells first and claim the whole run with
+// the same single CAS, so moving n values costs one contended operation instead of n.
+//
+// T must be default-constructible and move-assignable; popped cells keep a moved-from T.
+template<typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueuePosition_{0};
+    alignas(64) std::atomic<size_t> dequeuePosition_{0};
+
+public:
+    explicit MpmcQueue(size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("MPMC queue capacity must be a power of two of at least 2");
+        }
+        cells_.reset(new Cell[capacity]);
+        mask_ = capacity - 1;
+        for (size_t i = 0; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // Moves from value only on success
+    bool tryPush(T& value) {
+        size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Moves the first n values, where n is the return value
+    size_t tryPushBatch(T* values, size_t count) {
+        size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        while (count != 0) {
+            size_t n = 0;
+            intptr_t difference = 0;
+            for (; n < count; ++n) {
+                const size_t sequence = cells_[(position + n) & mask_].sequence.load(std::memory_order_acquire);
+                difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + n);
+                if (difference != 0) break;
+            }
+            if (n == 0) {
+                if (difference < 0) return 0;
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+                continue;
+            }
+            // Free cells stay free until someone holds their ticket, so the run is ours if the CAS wins
+            if (enqueuePosition_.compare_exchange_weak(position, position + n, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < n; ++i) {
+                    Cell& cell = cells_[(position + i) & mask_];
+                    cell.value = std::move(values[i]);
+                    cell.sequence.store(position + i + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+        return 0;
+    }
+
+    bool tryPop(T& out) {
+        size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Fills out[0, n) with the oldest values and returns n
+    size_t tryPopBatch(T* out, size_t maxCount) {
+        size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        while (maxCount != 0) {
+            size_t n = 0;
+            intptr_t difference = 0;
+            for (; n < maxCount; ++n) {
+                const size_t sequence = cells_[(position + n) & mask_].sequence.load(std::memory_order_acquire);
+                difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + n + 1);
+                if (difference != 0) break;
+            }
+            if (n == 0) {
+                if (difference < 0) return 0;
+                position = dequeuePosition_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeuePosition_.compare_exchange_weak(position, position + n, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < n; ++i) {
+                    Cell& cell = cells_[(position + i) & mask_];
+                    out[i] = std::move(cell.value);
+                    cell.sequence.store(position + i + mask_ + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+        return 0;
+    }
+
+    // Racy snapshot; exact only when no other thread is pushing or popping
+    size_t sizeApprox() const {
+        const size_t enqueued = enqueuePosition_.load(std::memory_order_relaxed);
+        const size_t dequeued = dequeuePosition_.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+};
+
+} // namespace PacketAnalyzer2026::Performance
@@ -0,0 +1,289 @@
+// PipelineChannel.hpp - Bounded stage-to-stage channels with overflow policies and occupancy/drop counters
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "MpmcQueue.hpp"
+#include "SpscQueue.hpp"
+
+namespace PacketAnalyzer2026::Performance {
+
+// What a producer does when the channel is full
+enum class OverflowPolicy {
+    Block,          // Wait for the consumer; backpressure reaches the producer (and from capture, the kernel ring)
+    DropNewest,     // Discard what does not fit
+    DropOldest,     // Evict queued items to make room; needs a multi-consumer ring
+    Sample          // Above sampleThreshold keep one item in sampleOneIn; discard the rest when full
+};
+
+inline const char* overflowPolicyName(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::Block:      return "block";
+        case OverflowPolicy::DropNewest: return "drop-newest";
+        case OverflowPolicy::DropOldest: return "drop-oldest";
+        case OverflowPolicy::Sample:     return "sample";
+    }
+    return "unknown";
+}
+
+struct ChannelConfig {
+    size_t capacity = 8192;                     // Power of two
+    OverflowPolicy overflow = OverflowPolicy::Block;
+    double sampleThreshold = 0.75;              // Sample: fill fraction at which thinning starts
+    uint32_t sampleOneIn = 8;                   // Sample: keep one item in this many above the threshold
+};
+
+struct ChannelStatistics {
+    std::string name;
+    OverflowPolicy overflow;
+    size_t capacity;
+    size_t occupancy;
+    size_t highWatermark;
+    uint64_t pushed;            // Accepted into the ring
+    uint64_t popped;
+    uint64_t droppedNewest;     // Rejected because the ring was full or closed
+    uint64_t droppedOldest;     // Evicted to make room
+    uint64_t sampledOut;        // Thinned by the sample policy
+    uint64_t blockedPushes;     // Pushes that had to wait for room
+
+    uint64_t dropped() const { return droppedNewest + droppedOldest + sampledOut; }
+    double fillPercent() const { return capacity ? 100.0 * occupancy / capacity : 0.0; }
+};
+
+// Type-independent half of a channel, so owners can list and report channels of any item type
+class PipelineChannelBase {
+protected:
+    static constexpr int BLOCK_SPINS = 64;
+
+    std::string name_;
+    ChannelConfig config_;
+    size_t sampleLevel_;
+
+    // Producer-side counters share one line, the consumer's count has its own
+    alignas(64) std::atomic<uint64_t> pushed_{0};
+    std::atomic<uint64_t> droppedNewest_{0};
+    std::atomic<uint64_t> droppedOldest_{0};
+    std::atomic<uint64_t> sampledOut_{0};
+    std::atomic<uint64_t> blockedPushes_{0};
+    std::atomic<uint64_t> sampleTicket_{0};
+    std::atomic<size_t> highWatermark_{0};
+    alignas(64) std::atomic<uint64_t> popped_{0};
+
+    alignas(64) std::atomic<bool> closed_{false};
+    std::atomic<size_t> waiters_{0};
+    std::mutex waitMutex_;
+    std::condition_variable roomAvailable_;
+
+    PipelineChannelBase(std::string name, const ChannelConfig& config)
+        : name_(std::move(name)), config_(config) {
+        if (config_.sampleOneIn == 0) {
+            throw std::invalid_argument("Channel '" + name_ + "' needs sampleOneIn of at least 1");
+        }
+        const double threshold = std::clamp(config_.sampleThreshold, 0.0, 1.0);
+        sampleLevel_ = static_cast<size_t>(threshold * static_cast<double>(config_.capacity));
+    }
+
+    void noteOccupancy(size_t occupancy) {
+        size_t seen = highWatermark_.load(std::memory_order_relaxed);
+        while (occupancy > seen &&
+               !highWatermark_.compare_exchange_weak(seen, occupancy, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Spins briefly, then sleeps until a consumer makes room, the channel closes or 1 ms passes.
+    // The timeout bounds the cost of the rare wakeup that slips between a check and the wait.
+    template<typename HasRoom>
+    void waitForRoom(HasRoom hasRoom) {
+        for (int spin = 0; spin < BLOCK_SPINS; ++spin) {
+            if (hasRoom() || closed()) return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(waitMutex_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!hasRoom() && !closed()) {
+            roomAvailable_.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notifyRoom() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            roomAvailable_.notify_all();
+        }
+    }
+
+public:
+    virtual ~PipelineChannelBase() = default;
+
+    PipelineChannelBase(const PipelineChannelBase&) = delete;
+    PipelineChannelBase& operator=(const PipelineChannelBase&) = delete;
+
+    virtual size_t occupancy() const = 0;
+
+    const std::string& name() const { return name_; }
+    const ChannelConfig& config() const { return config_; }
+
+    // Producers stop blocking and further pushes are rejected; consumers can still drain
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            closed_.store(true, std::memory_order_release);
+        }
+        roomAvailable_.notify_all();
+    }
+
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    ChannelStatistics statistics() const {
+        return {
+            name_,
+            config_.overflow,
+            config_.capacity,
+            occupancy(),
+            highWatermark_.load(std::memory_order_relaxed),
+            pushed_.load(std::memory_order_relaxed),
+            popped_.load(std::memory_order_relaxed),
+            droppedNewest_.load(std::memory_order_relaxed),
+            droppedOldest_.load(std::memory_order_relaxed),
+            sampledOut_.load(std::memory_order_relaxed),
+            blockedPushes_.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+// Bounded channel between two pipeline stages over a lock-free ring. Ring is SpscQueue<T>
+// for one producer and one consumer thread, or MpmcQueue<T> when several threads feed or
+// drain it (and for DropOldest, where producers evict from the consumer end). Memory is
+// fixed at construction, so a stalled downstream stage costs drops or backpressure, never
+// growth. Batched calls move a run of items with one index update.
+template<typename T, typename Ring>
+class PipelineChannel : public PipelineChannelBase {
+private:
+    static constexpr bool MULTI_CONSUMER = std::is_same_v<Ring, MpmcQueue<T>>;
+    static constexpr int EVICTION_ROUNDS = 4;
+
+    Ring ring_;
+
+    size_t pushBlocking(T* values, size_t count) {
+        size_t accepted = ring_.tryPushBatch(values, count);
+        if (accepted == count) return accepted;
+
+        blockedPushes_.fetch_add(1, std::memory_order_relaxed);
+        while (accepted < count && !closed()) {
+            waitForRoom([this] { return ring_.sizeApprox() < ring_.capacity(); });
+            accepted += ring_.tryPushBatch(values + accepted, count - accepted);
+        }
+        return accepted;
+    }
+
+    // Pops from the consumer end to make room; other producers may take the room first,
+    // so this gives up after a few rounds and lets the remainder count as dropped
+    size_t pushEvicting(T* values, size_t count) {
+        size_t accepted = ring_.tryPushBatch(values, count);
+        for (int round = 0; round < EVICTION_ROUNDS && accepted < count; ++round) {
+            uint64_t evicted = 0;
+            T discarded;
+            for (size_t i = accepted; i < count && ring_.tryPop(discarded); ++i) {
+                ++evicted;
+            }
+            droppedOldest_.fetch_add(evicted, std::memory_order_relaxed);
+            accepted += ring_.tryPushBatch(values + accepted, count - accepted);
+        }
+        return accepted;
+    }
+
+    // Above the sample level keeps every sampleOneIn-th item by a channel-wide ticket,
+    // compacting the survivors to the front of values
+    size_t pushSampled(T* values, size_t count, size_t& thinned) {
+        if (ring_.sizeApprox() < sampleLevel_ || config_.sampleOneIn == 1) {
+            return ring_.tryPushBatch(values, count);
+        }
+        const uint64_t ticket = sampleTicket_.fetch_add(count, std::memory_order_relaxed);
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if ((ticket + i) % config_.sampleOneIn == 0) {
+                if (kept != i) values[kept] = std::move(values[i]);
+                ++kept;
+            }
+        }
+        thinned = count - kept;
+        return ring_.tryPushBatch(values, kept);
+    }
+
+public:
+    PipelineChannel(std::string name, const ChannelConfig& config = {})
+        : PipelineChannelBase(std::move(name), config), ring_(config.capacity) {
+        if (config.overflow == OverflowPolicy::DropOldest && !MULTI_CONSUMER) {
+            throw std::invalid_argument("Channel '" + name_ + "': drop-oldest evicts from the consumer end and "
+                                        "needs an MPMC ring");
+        }
+    }
+
+    // Offers values[0, count) and returns how many were accepted. Items are taken in order
+    // and the array should be treated as consumed: rejected and sampled-out items may be
+    // left moved-from. With Block this only returns short once the channel is closed.
+    size_t pushBatch(T* values, size_t count) {
+        if (count == 0) return 0;
+
+        size_t accepted = 0;
+        size_t thinned = 0;
+        if (!closed()) {
+            switch (config_.overflow) {
+                case OverflowPolicy::Block:      accepted = pushBlocking(values, count); break;
+                case OverflowPolicy::DropNewest: accepted = ring_.tryPushBatch(values, count); break;
+                case OverflowPolicy::DropOldest: accepted = pushEvicting(values, count); break;
+                case OverflowPolicy::Sample:     accepted = pushSampled(values, count, thinned); break;
+            }
+        }
+
+        if (accepted != 0) {
+            pushed_.fetch_add(accepted, std::memory_order_relaxed);
+            noteOccupancy(ring_.sizeApprox());
+        }
+        if (thinned != 0) sampledOut_.fetch_add(thinned, std::memory_order_relaxed);
+        if (accepted + thinned != count) {
+            droppedNewest_.fetch_add(count - accepted - thinned, std::memory_order_relaxed);
+        }
+        return accepted;
+    }
+
+    bool push(T& value) { return pushBatch(&value, 1) == 1; }
+    bool push(T&& value) { return pushBatch(&value, 1) == 1; }
+
+    // Never waits; stages poll their input channels from their own loops or pool tasks
+    size_t popBatch(T* out, size_t maxCount) {
+        const size_t n = ring_.tryPopBatch(out, maxCount);
+        if (n != 0) {
+            popped_.fetch_add(n, std::memory_order_relaxed);
+            if (config_.overflow == OverflowPolicy::Block) notifyRoom();
+        }
+        return n;
+    }
+
+    bool tryPop(T& out) { return popBatch(&out, 1) == 1; }
+
+    size_t occupancy() const override { return ring_.sizeApprox(); }
+    size_t capacity() const { return ring_.capacity(); }
+};
+
+template<typename T>
+using SpscChannel = PipelineChannel<T, SpscQueue<T>>;
+
+template<typename T>
+using MpmcChannel = PipelineChannel<T, MpmcQueue<T>>;
+
+} // namespace PacketAnalyzer2026::Performance
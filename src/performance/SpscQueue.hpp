@@ -0,0 +1,115 @@
+// SpscQueue.hpp - Bounded lock-free single-producer single-consumer ring with batched push and pop
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace PacketAnalyzer2026::Performance {
+
+// Lamport ring with free-running indices. Producer and consumer each own one index on its
+// own cache line and keep a cached copy of the other's, so in steady state an operation
+// touches only its own line and re-reads the shared index only when the cache says full
+// or empty. Batched calls move up to n values and publish them with a single store.
+//
+// Exactly one thread may push and exactly one thread may pop at a time.
+// T must be default-constructible and move-assignable; popped cells keep a moved-from T.
+template<typename T>
+class SpscQueue {
+private:
+    std::unique_ptr<T[]> cells_;
+    size_t mask_;
+
+    alignas(64) std::atomic<size_t> tail_{0};   // Written by the producer
+    size_t cachedHead_ = 0;
+
+    alignas(64) std::atomic<size_t> head_{0};   // Written by the consumer
+    size_t cachedTail_ = 0;
+
+    // Producer side: free cells, refreshing the consumer's index only when needed
+    size_t freeCells(size_t tail, size_t wanted) {
+        size_t available = capacity() - (tail - cachedHead_);
+        if (available < wanted) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            available = capacity() - (tail - cachedHead_);
+        }
+        return available;
+    }
+
+    // Consumer side: filled cells, refreshing the producer's index only when needed
+    size_t filledCells(size_t head, size_t wanted) {
+        size_t available = cachedTail_ - head;
+        if (available < wanted) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            available = cachedTail_ - head;
+        }
+        return available;
+    }
+
+public:
+    explicit SpscQueue(size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("SPSC queue capacity must be a power of two of at least 2");
+        }
+        cells_.reset(new T[capacity]);
+        mask_ = capacity - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. Moves from value only on success.
+    bool tryPush(T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (freeCells(tail, 1) == 0) return false;
+        cells_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only. Moves the first n values, where n is the return value.
+    size_t tryPushBatch(T* values, size_t count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t available = freeCells(tail, count);
+        const size_t n = count < available ? count : available;
+        for (size_t i = 0; i < n; ++i) {
+            cells_[(tail + i) & mask_] = std::move(values[i]);
+        }
+        if (n != 0) tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer only
+    bool tryPop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (filledCells(head, 1) == 0) return false;
+        out = std::move(cells_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Fills out[0, n) with the oldest values and returns n.
+    size_t tryPopBatch(T* out, size_t maxCount) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t available = filledCells(head, maxCount);
+        const size_t n = maxCount < available ? maxCount : available;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::move(cells_[(head + i) & mask_]);
+        }
+        if (n != 0) head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Racy snapshot; exact from the producer or consumer thread when the other is idle
+    size_t sizeApprox() const {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+};
+
+} // namespace PacketAnalyzer2026::Performance
@@ -0,0 +1,125 @@
+// Task.hpp - Move-only type-erased void() callable with inline storage for small captures
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace PacketAnalyzer2026::Performance {
+
+// Replacement for std::function<void()> on the scheduling path. Callables up to INLINE_SIZE
+// bytes that are nothrow-movable live inside the Task, so wrapping a lambda that captures a
+// few pointers or a shared_ptr allocates nothing; larger ones fall back to the heap. A
+// Task is one cache line and is moved, never copied.
+class Task {
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+private:
+    enum class Operation { Move, Destroy };
+
+    using Invoke = void (*)(void* storage);
+    using Manage = void (*)(Operation operation, void* storage, void* source);
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    Invoke invoke_ = nullptr;
+    Manage manage_ = nullptr;
+
+    template<typename F>
+    static constexpr bool storedInline = sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    static void invokeInline(void* storage) {
+        (*static_cast<F*>(storage))();
+    }
+
+    template<typename F>
+    static void manageInline(Operation operation, void* storage, void* source) {
+        if (operation == Operation::Move) {
+            new (storage) F(std::move(*static_cast<F*>(source)));
+            static_cast<F*>(source)->~F();
+        } else {
+            static_cast<F*>(storage)->~F();
+        }
+    }
+
+    template<typename F>
+    static void invokeHeap(void* storage) {
+        (**static_cast<F**>(storage))();
+    }
+
+    template<typename F>
+    static void manageHeap(Operation operation, void* storage, void* source) {
+        if (operation == Operation::Move) {
+            *static_cast<F**>(storage) = *static_cast<F**>(source);
+        } else {
+            delete *static_cast<F**>(storage);
+        }
+    }
+
+    void moveFrom(Task& other) noexcept {
+        if (other.manage_) {
+            other.manage_(Operation::Move, storage_, other.storage_);
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+            other.invoke_ = nullptr;
+            other.manage_ = nullptr;
+        }
+    }
+
+public:
+    Task() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+    Task(F&& callable) {
+        using Stored = std::decay_t<F>;
+        if constexpr (storedInline<Stored>) {
+            new (storage_) Stored(std::forward<F>(callable));
+            invoke_ = &invokeInline<Stored>;
+            manage_ = &manageInline<Stored>;
+        } else {
+            *reinterpret_cast<Stored**>(storage_) = new Stored(std::forward<F>(callable));
+            invoke_ = &invokeHeap<Stored>;
+            manage_ = &manageHeap<Stored>;
+        }
+    }
+
+    Task(Task&& other) noexcept {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        reset();
+    }
+
+    void reset() {
+        if (manage_) manage_(Operation::Destroy, storage_, nullptr);
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+    explicit operator bool() const { return invoke_ != nullptr; }
+
+    void operator()() { invoke_(storage_); }
+
+    // True when a callable of type F is stored without allocating
+    template<typename F>
+    static constexpr bool isInline() { return storedInline<std::decay_t<F>>; }
+};
+
+static_assert(sizeof(Task) == 64, "Task should stay one cache line");
+
+} // namespace PacketAnalyzer2026::Performance
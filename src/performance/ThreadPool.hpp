@@ -3,104 +3,306 @@
 
 #include <thread>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
 #include <future>
 #include <atomic>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "MpmcQueue.hpp"
+#include "PipelineChannel.hpp"
+#include "Task.hpp"
+#include "WorkStealingDeque.hpp"
 
 namespace PacketAnalyzer2026::Performance {
 
+// Work-stealing pool. Each worker owns a Chase-Lev deque: tasks submitted from one of the
+// pool's own threads go to that thread's deque and run LIFO, and idle workers steal the
+// oldest tasks from the others. Tasks from outside the pool go through a lock-free MPMC
+// injection queue, with a mutex-guarded spill list only when that is full. Tasks are
+// stored inline in their cells (see Task), so submit() does not allocate for small
+// callables and no lock is taken on the common path.
+//
+// Idle workers spin briefly, then park on a condition variable. Submitters only touch the
+// mutex when some worker is parked, so a busy pool schedules without system calls.
+//
+// submitTo() pins a task to one worker: it goes to that worker's inbox, which is never
+// stolen from and runs in submission order, so state owned by a worker (a flow shard, see
+// Core::FlowShardedDispatcher) is only ever touched by that worker's thread.
 class ThreadPool {
 private:
+    static constexpr size_t DEQUE_CAPACITY = 1024;
+    static constexpr size_t INJECTION_CAPACITY = 4096;
+    static constexpr size_t INBOX_CAPACITY = 1024;
+    static constexpr int IDLE_SPINS = 64;
+
+    struct alignas(64) Worker {
+        WorkStealingDeque<Task> deque{ DEQUE_CAPACITY };
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+
+        // Pinned tasks. The spill list keeps submission order when the inbox is full: once it
+        // is non-empty new tasks queue behind it, and the owner drains the inbox first.
+        MpmcQueue<Task> inbox{ INBOX_CAPACITY };
+        std::deque<Task> inboxSpill;
+        std::mutex inboxSpillMutex;
+        std::atomic<size_t> inboxSpillSize{0};
+
+        size_t pinnedApprox() const {
+            return inbox.sizeApprox() + inboxSpillSize.load(std::memory_order_relaxed);
+        }
+    };
+
+    struct CurrentWorker {
+        const ThreadPool* pool = nullptr;
+        size_t index = SIZE_MAX;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workerState_;
     std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex queueMutex_;
-    std::condition_variable condition_;
+    MpmcQueue<Task> injection_{ INJECTION_CAPACITY };
+    std::deque<Task> spill_;                    // Injection overflow, under spillMutex_
+    mutable std::mutex spillMutex_;
+    std::atomic<size_t> spillSize_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    std::atomic<size_t> sleepers_{0};
+
     std::atomic<bool> stop_{false};
     std::string name_;
     std::atomic<size_t> activeTasks_{0};
     std::atomic<size_t> totalTasks_{0};
 
+    static CurrentWorker& currentWorker() {
+        static thread_local CurrentWorker current;
+        return current;
+    }
+
+    bool takePinned(Worker& worker, Task& task) {
+        if (worker.inbox.tryPop(task)) return true;
+        if (worker.inboxSpillSize.load(std::memory_order_relaxed) == 0) return false;
+
+        std::lock_guard<std::mutex> lock(worker.inboxSpillMutex);
+        if (worker.inboxSpill.empty()) return false;
+        task = std::move(worker.inboxSpill.front());
+        worker.inboxSpill.pop_front();
+        worker.inboxSpillSize.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool takeInjected(Task& task) {
+        if (injection_.tryPop(task)) return true;
+        if (spillSize_.load(std::memory_order_relaxed) == 0) return false;
+
+        std::lock_guard<std::mutex> lock(spillMutex_);
+        if (spill_.empty()) return false;
+        task = std::move(spill_.front());
+        spill_.pop_front();
+        spillSize_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Starts at a different victim per attempt so thieves spread out
+    bool stealTask(size_t self, size_t& seed, Task& task) {
+        const size_t count = workerState_.size();
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        const size_t first = static_cast<size_t>(seed >> 33) % count;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t victim = (first + i) % count;
+            if (victim != self && workerState_[victim]->deque.steal(task)) {
+                workerState_[self]->stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool findTask(size_t self, size_t& seed, Task& task) {
+        Worker& worker = *workerState_[self];
+        return worker.deque.pop(task) || takePinned(worker, task) || takeInjected(task) ||
+               stealTask(self, seed, task);
+    }
+
+    // Work that self could run: anything shared, plus its own pinned tasks
+    bool hasQueuedWork(size_t self) const {
+        if (workerState_[self]->pinnedApprox() != 0) return true;
+        if (injection_.sizeApprox() != 0 || spillSize_.load(std::memory_order_relaxed) != 0) return true;
+        for (const auto& worker : workerState_) {
+            if (!worker->deque.emptyApprox()) return true;
+        }
+        return false;
+    }
+
+    void park(size_t self) {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // Re-checked after announcing the sleep, so a submitter either sees us or we see its task
+        if (!hasQueuedWork(self) && !stop_.load(std::memory_order_relaxed)) {
+            sleepCondition_.wait(lock);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void wakeOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            sleepCondition_.notify_one();
+        }
+    }
+
+    // A pinned task needs one particular worker, and the condition variable cannot pick it
+    void wakeAll() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            sleepCondition_.notify_all();
+        }
+    }
+
+    void run(size_t index) {
+        currentWorker() = CurrentWorker{ this, index };
+        size_t seed = index + 1;
+        Worker& self = *workerState_[index];
+
+        while (true) {
+            Task task;
+            bool found = false;
+            for (int spin = 0; spin < IDLE_SPINS && !found; ++spin) {
+                found = findTask(index, seed, task);
+                if (!found && spin >= IDLE_SPINS / 2) std::this_thread::yield();
+            }
+
+            if (!found) {
+                // Queues are drained before shutting down, as the mutex-based pool did
+                if (stop_.load(std::memory_order_acquire) && !hasQueuedWork(index)) return;
+                park(index);
+                continue;
+            }
+
+            activeTasks_.fetch_add(1, std::memory_order_relaxed);
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cout << "❌ Task failed in " << name_ << " pool: " << e.what() << std::endl;
+            }
+            activeTasks_.fetch_sub(1, std::memory_order_relaxed);
+            self.executed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void schedule(Task task) {
+        if (stop_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+        }
+        totalTasks_.fetch_add(1, std::memory_order_relaxed);
+
+        const CurrentWorker& current = currentWorker();
+        if (!(current.pool == this && workerState_[current.index]->deque.push(task)) && !injection_.tryPush(task)) {
+            std::lock_guard<std::mutex> lock(spillMutex_);
+            spill_.push_back(std::move(task));
+            spillSize_.fetch_add(1, std::memory_order_relaxed);
+        }
+        wakeOne();
+    }
+
+    void schedulePinned(size_t index, Task task) {
+        if (index >= workerState_.size()) {
+            throw std::out_of_range("ThreadPool '" + name_ + "' has no worker " + std::to_string(index));
+        }
+        if (stop_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+        }
+        totalTasks_.fetch_add(1, std::memory_order_relaxed);
+
+        Worker& worker = *workerState_[index];
+        if (worker.inboxSpillSize.load(std::memory_order_acquire) != 0 || !worker.inbox.tryPush(task)) {
+            std::lock_guard<std::mutex> lock(worker.inboxSpillMutex);
+            worker.inboxSpill.push_back(std::move(task));
+            worker.inboxSpillSize.fetch_add(1, std::memory_order_release);
+        }
+        wakeAll();
+    }
+
 public:
     ThreadPool(size_t numThreads, const std::string& name) : name_(name) {
+        if (numThreads == 0) {
+            throw std::invalid_argument("ThreadPool '" + name + "' needs at least one thread");
+        }
         for (size_t i = 0; i < numThreads; ++i) {
-            workers_.emplace_back([this, i] {
-                for (;;) {
-                    std::function<void()> task;
-                    
-                    {
-                        std::unique_lock<std::mutex> lock(queueMutex_);
-                        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
-                        
-                        if (stop_ && tasks_.empty()) return;
-                        
-                        task = std::move(tasks_.front());
-                        tasks_.pop();
-                        activeTasks_++;
-                    }
-                    
-                    try {
-                        task();
-                    } catch (const std::exception& e) {
-                        std::cout << "❌ Task failed in " << name_ << " pool: " << e.what() << std::endl;
-                    }
-                    
-                    activeTasks_--;
-                }
-            });
+            workerState_.push_back(std::make_unique<Worker>());
         }
-        
+        for (size_t i = 0; i < numThreads; ++i) {
+            workers_.emplace_back([this, i] { run(i); });
+        }
+
         std::cout << "🧵 Thread Pool '" << name_ << "' initialized with " << numThreads << " threads" << std::endl;
     }
 
     ~ThreadPool() {
         {
-            std::unique_lock<std::mutex> lock(queueMutex_);
+            std::lock_guard<std::mutex> lock(sleepMutex_);
             stop_ = true;
         }
-        
-        condition_.notify_all();
-        
+
+        sleepCondition_.notify_all();
+
         for (std::thread& worker : workers_) {
             if (worker.joinable()) {
                 worker.join();
             }
         }
-        
+
         std::cout << "🧵 Thread Pool '" << name_ << "' destroyed" << std::endl;
     }
 
+    // Fire-and-forget: no future, and no allocation for callables that fit Task::INLINE_SIZE.
+    // Exceptions escaping the task are logged and dropped.
+    template<class F>
+    void submit(F&& f) {
+        schedule(Task(std::forward<F>(f)));
+    }
+
+    // Runs f on worker index (0 <= index < threadCount()) and nowhere else. Tasks pinned to
+    // the same worker from one thread run in the order they were submitted.
+    template<class F>
+    void submitTo(size_t index, F&& f) {
+        schedulePinned(index, Task(std::forward<F>(f)));
+    }
+
     template<class F, class... Args>
-    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type> {
-        using return_type = typename std::result_of<F(Args...)>::type;
+    auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        using return_type = std::invoke_result_t<F, Args...>;
 
         auto task = std::make_shared<std::packaged_task<return_type()>>(
             std::bind(std::forward<F>(f), std::forward<Args>(args)...)
         );
 
         std::future<return_type> result = task->get_future();
-        
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            
-            if (stop_) {
-                throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
-            }
-            
-            tasks_.emplace([task]() { (*task)(); });
-            totalTasks_++;
-        }
-        
-        condition_.notify_one();
+        schedule(Task([task]() { (*task)(); }));
         return result;
     }
 
+    // Index of the calling thread among this pool's workers, or SIZE_MAX from any other thread
+    size_t currentWorkerIndex() const {
+        const CurrentWorker& current = currentWorker();
+        return current.pool == this ? current.index : SIZE_MAX;
+    }
+
     size_t queueSize() const {
-        std::unique_lock<std::mutex> lock(queueMutex_);
-        return tasks_.size();
+        size_t queued = injection_.sizeApprox() + spillSize_.load(std::memory_order_relaxed);
+        for (const auto& worker : workerState_) {
+            queued += worker->deque.sizeApprox() + worker->pinnedApprox();
+        }
+        return queued;
     }
 
     size_t activeTaskCount() const {
@@ -111,10 +313,22 @@ public:
         return totalTasks_.load();
     }
 
+    size_t stolenTaskCount() const {
+        size_t stolen = 0;
+        for (const auto& worker : workerState_) {
+            stolen += worker->stolen.load(std::memory_order_relaxed);
+        }
+        return stolen;
+    }
+
     std::string getName() const {
         return name_;
     }
 
+    size_t threadCount() const {
+        return workers_.size();
+    }
+
     double getUtilizationPercent() const {
         return (static_cast<double>(activeTasks_) / workers_.size()) * 100.0;
     }
@@ -125,6 +339,7 @@ struct ThreadPoolMetrics {
         size_t queueSize;
         size_t activeTasks;
         size_t totalTasks;
+        size_t stolenTasks;
         double utilizationPercent;
     };
     
@@ -132,6 +347,7 @@ struct ThreadPoolMetrics {
     PoolMetrics parsing;
     PoolMetrics storage;
     PoolMetrics ui;
+    std::vector<ChannelStatistics> channels;
 };
 
 class PacketProcessingThreadPool {
@@ -141,21 +357,50 @@ private:
     ThreadPool storagePool_;
     ThreadPool uiPool_;
 
+    std::vector<std::shared_ptr<PipelineChannelBase>> channels_;
+    mutable std::mutex channelsMutex_;
+
 public:
-    PacketProcessingThreadPool() 
-        : capturePool_(2, "Capture")      // High priority, small pool
-        , parsingPool_(4, "Parsing")      // Main processing
+    // One capture thread per fanout socket; see Core::FanoutCapture. Parsing threads each own
+    // a flow shard when fed through Core::FlowShardedDispatcher.
+    explicit PacketProcessingThreadPool(size_t captureThreads = 2, size_t parsingThreads = 4)
+        : capturePool_(captureThreads, "Capture")  // High priority, small pool
+        , parsingPool_(parsingThreads, "Parsing")  // Main processing
         , storagePool_(2, "Storage")      // I/O operations
         , uiPool_(1, "UI")                // UI updates
     {
         std::cout << "🚀 Packet Processing Thread Pool System initialized" << std::endl;
     }
 
+    // Producers blocked on a full channel would otherwise keep the pools from joining
+    ~PacketProcessingThreadPool() {
+        closeChannels();
+    }
+
     ThreadPool& getCapturePool() { return capturePool_; }
     ThreadPool& getParsingPool() { return parsingPool_; }
     ThreadPool& getStoragePool() { return storagePool_; }
     ThreadPool& getUIPool() { return uiPool_; }
 
+    // Creates a bounded channel between two stages and includes it in the system metrics,
+    // e.g. createChannel<SpscChannel<PacketRecord>>("capture->parsing", config)
+    template<typename Channel>
+    std::shared_ptr<Channel> createChannel(const std::string& name, const ChannelConfig& config = {}) {
+        auto channel = std::make_shared<Channel>(name, config);
+        std::lock_guard<std::mutex> lock(channelsMutex_);
+        channels_.push_back(channel);
+        std::cout << "🔗 Channel '" << name << "' created (capacity " << channel->capacity() << ", "
+                  << overflowPolicyName(config.overflow) << ")" << std::endl;
+        return channel;
+    }
+
+    void closeChannels() {
+        std::lock_guard<std::mutex> lock(channelsMutex_);
+        for (const auto& channel : channels_) {
+            channel->close();
+        }
+    }
+
     ThreadPoolMetrics getSystemMetrics() const {
         ThreadPoolMetrics metrics;
         
@@ -163,6 +408,7 @@ public:
             capturePool_.queueSize(),
             capturePool_.activeTaskCount(),
             capturePool_.totalTaskCount(),
+            capturePool_.stolenTaskCount(),
             capturePool_.getUtilizationPercent()
         };
         
@@ -170,6 +416,7 @@ public:
             parsingPool_.queueSize(),
             parsingPool_.activeTaskCount(),
             parsingPool_.totalTaskCount(),
+            parsingPool_.stolenTaskCount(),
             parsingPool_.getUtilizationPercent()
         };
         
@@ -177,6 +424,7 @@ public:
             storagePool_.queueSize(),
             storagePool_.activeTaskCount(),
             storagePool_.totalTaskCount(),
+            storagePool_.stolenTaskCount(),
             storagePool_.getUtilizationPercent()
         };
         
@@ -184,8 +432,14 @@ public:
             uiPool_.queueSize(),
             uiPool_.activeTaskCount(),
             uiPool_.totalTaskCount(),
+            uiPool_.stolenTaskCount(),
             uiPool_.getUtilizationPercent()
         };
+
+        std::lock_guard<std::mutex> lock(channelsMutex_);
+        for (const auto& channel : channels_) {
+            metrics.channels.push_back(channel->statistics());
+        }
         
         return metrics;
     }
@@ -197,6 +451,11 @@ public:
         std::cout << "   ⚙️ Parsing: " << metrics.parsing.utilizationPercent << "% utilization" << std::endl;
         std::cout << "   💾 Storage: " << metrics.storage.utilizationPercent << "% utilization" << std::endl;
         std::cout << "   🖥️ UI: " << metrics.ui.utilizationPercent << "% utilization" << std::endl;
+        for (const auto& channel : metrics.channels) {
+            std::cout << "   🔗 " << channel.name << ": " << channel.occupancy << "/" << channel.capacity
+                      << " queued (peak " << channel.highWatermark << "), " << channel.dropped() << " dropped, "
+                      << channel.blockedPushes << " blocked pushes" << std::endl;
+        }
     }
 };
 
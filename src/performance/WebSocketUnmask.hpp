@@ -0,0 +1,95 @@
+// WebSocketUnmask.hpp - Vectorized XOR unmasking of WebSocket payloads
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "CpuFeatures.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PA2026_WS_AVX2 1
+#elif defined(PA2026_HAVE_SSE2)
+#include <emmintrin.h>
+#define PA2026_WS_SSE2 1
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define PA2026_WS_NEON 1
+#endif
+
+namespace PacketAnalyzer2026::Performance {
+
+// RFC 6455 5.3: payload byte i is XORed with key[i % 4]. Vector widths are multiples of 4,
+// so the key is rotated once to the starting phase and broadcast as a 32-bit lane. AVX2 is
+// used when the build enables it, otherwise SSE2 or NEON; the scalar path runs 8 bytes at a time.
+class WebSocketUnmask {
+public:
+    // out may equal in for in-place unmasking. phase is the payload offset of in[0], for
+    // payloads processed in pieces; it is 0 for a whole frame.
+    static void apply(const uint8_t* in, uint8_t* out, size_t length, const uint8_t key[4], size_t phase = 0) {
+        uint8_t rotated[8];
+        for (size_t i = 0; i < 8; ++i) {
+            rotated[i] = key[(phase + i) & 3];
+        }
+        uint32_t key32;
+        std::memcpy(&key32, rotated, 4);
+
+        size_t i = 0;
+#if defined(PA2026_WS_AVX2)
+        const __m256i mask256 = _mm256_set1_epi32(static_cast<int>(key32));
+        for (; i + 64 <= length; i += 64) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(a, mask256));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 32), _mm256_xor_si256(b, mask256));
+        }
+        for (; i + 32 <= length; i += 32) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(a, mask256));
+        }
+#elif defined(PA2026_WS_SSE2)
+        const __m128i mask128 = _mm_set1_epi32(static_cast<int>(key32));
+        for (; i + 64 <= length; i += 64) {
+            for (size_t lane = 0; lane < 64; lane += 16) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + lane));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + lane), _mm_xor_si128(a, mask128));
+            }
+        }
+        for (; i + 16 <= length; i += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(a, mask128));
+        }
+#elif defined(PA2026_WS_NEON)
+        const uint8x16_t mask128 = vreinterpretq_u8_u32(vdupq_n_u32(key32));
+        for (; i + 64 <= length; i += 64) {
+            uint8x16x4_t block = vld1q_u8_x4(in + i);
+            block.val[0] = veorq_u8(block.val[0], mask128);
+            block.val[1] = veorq_u8(block.val[1], mask128);
+            block.val[2] = veorq_u8(block.val[2], mask128);
+            block.val[3] = veorq_u8(block.val[3], mask128);
+            vst1q_u8_x4(out + i, block);
+        }
+        for (; i + 16 <= length; i += 16) {
+            vst1q_u8(out + i, veorq_u8(vld1q_u8(in + i), mask128));
+        }
+#endif
+        uint64_t key64;
+        std::memcpy(&key64, rotated, 8);
+        for (; i + 8 <= length; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, in + i, 8);
+            word ^= key64;
+            std::memcpy(out + i, &word, 8);
+        }
+        for (; i < length; ++i) {
+            out[i] = in[i] ^ rotated[i & 3];
+        }
+    }
+
+    static void apply(uint8_t* data, size_t length, const uint8_t key[4], size_t phase = 0) {
+        apply(data, data, length, key, phase);
+    }
+};
+
+} // namespace PacketAnalyzer2026::Performance
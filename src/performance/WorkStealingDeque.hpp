@@ -0,0 +1,117 @@
+// WorkStealingDeque.hpp - Fixed-capacity Chase-Lev deque: owner pushes and pops at the bottom, thieves steal from the top
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace PacketAnalyzer2026::Performance {
+
+// Chase-Lev work-stealing deque (Chase and Lev 2005, with the C11 orderings of Le et al.
+// 2013) over a fixed ring of cells, so it never allocates or resizes after construction.
+// The owning worker pushes and pops at the bottom in LIFO order, which keeps freshly
+// spawned work in cache; other workers steal the oldest entry at the top with one CAS.
+//
+// Values are moved in and out of the cells rather than published as pointers, so each
+// cell has a busy flag: a thief claims an entry by CAS on top and only then moves it out,
+// and the owner will not reuse a cell until that move has finished. push() reports full
+// in that window as it does for a full ring; callers keep an overflow path either way.
+//
+// T must be default-constructible and move-assignable.
+template<typename T>
+class WorkStealingDeque {
+private:
+    struct Cell {
+        std::atomic<bool> busy{false};
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    int64_t mask_;
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+
+    void takeFrom(Cell& cell, T& out) {
+        out = std::move(cell.value);
+        cell.busy.store(false, std::memory_order_release);
+    }
+
+public:
+    explicit WorkStealingDeque(size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("Work-stealing deque capacity must be a power of two of at least 2");
+        }
+        cells_.reset(new Cell[capacity]);
+        mask_ = static_cast<int64_t>(capacity) - 1;
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner thread only. Moves from value only on success.
+    bool push(T& value) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top > mask_) return false;
+
+        Cell& cell = cells_[bottom & mask_];
+        if (cell.busy.load(std::memory_order_acquire)) return false;   // A thief is still moving the last occupant out
+        cell.value = std::move(value);
+        cell.busy.store(true, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner thread only; newest entry first
+    bool pop(T& out) {
+        // Release on every bottom store, so a thief that reads any of them also sees the cells below
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_release);
+            return false;
+        }
+        if (top == bottom) {
+            // Last entry: thieves may be after it too, so claim it the way they do
+            const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_release);
+            if (!won) return false;
+        }
+        takeFrom(cells_[bottom & mask_], out);
+        return true;
+    }
+
+    // Any thread; oldest entry first. Fails on an empty deque or a lost race.
+    bool steal(T& out) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) return false;
+
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        takeFrom(cells_[top & mask_], out);
+        return true;
+    }
+
+    // Racy snapshot, for metrics and idle checks
+    size_t sizeApprox() const {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    bool emptyApprox() const { return sizeApprox() == 0; }
+
+    size_t capacity() const { return static_cast<size_t>(mask_) + 1; }
+};
+
+} // namespace PacketAnalyzer2026::Performance
@@ -0,0 +1,245 @@
+// DissectorRegistry.hpp - Compile-time port/transport dispatch table with ordered heuristic probes
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "../core/ByteView.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::ByteView;
+
+// Application protocol ids; stored in PacketRecord::appProtocol, so they must fit in a byte
+enum class ProtocolId : uint8_t {
+    Unknown = 0,
+    HTTP,
+    HTTP2,
+    GRPC,
+    WebSocket,          // Not probed per packet, set from the flow once an HTTP upgrade is seen
+    TLS,
+    QUIC,
+    DNS,
+    MDNS,
+    DHCP,
+    NTP,
+    SSH,
+    Count
+};
+
+enum class Transport : uint8_t {
+    TCP = 0,
+    UDP = 1
+};
+
+// Heuristic payload probes. Each one is cheap, bounds-checked and allocation-free.
+namespace Probes {
+
+inline uint32_t read24(ByteView data) {
+    return (static_cast<uint32_t>(data[0]) << 16) | (data[1] << 8) | data[2];
+}
+
+inline bool http2Preface(ByteView data) {
+    return data.startsWith("PRI * HTTP/2.0");
+}
+
+// Plausible frame header: length within the default SETTINGS_MAX_FRAME_SIZE and a known type
+inline bool http2Frame(ByteView data) {
+    return data.size >= 9 && read24(data) <= 16384 && data[3] <= 10 && (data[5] & 0x80) == 0;
+}
+
+inline bool http1(ByteView data) {
+    if (data.size < 4) return false;
+    switch (data[0]) {
+        case 'G': return data.startsWith("GET ");
+        case 'P': return data.startsWith("POST ") || data.startsWith("PUT ") || data.startsWith("PATCH ");
+        case 'H': return data.startsWith("HTTP/1.") || data.startsWith("HEAD ");
+        case 'D': return data.startsWith("DELETE ");
+        case 'O': return data.startsWith("OPTIONS ");
+        case 'C': return data.startsWith("CONNECT ");
+        case 'T': return data.startsWith("TRACE ");
+        default:  return false;
+    }
+}
+
+// TLS record header: content type 20-23, major version 3
+inline bool tlsRecord(ByteView data) {
+    return data.size >= 5 && data[0] >= 20 && data[0] <= 23 && data[1] == 3 && data[2] <= 4;
+}
+
+// Long header with the fixed bit set and a non-zero version (zero is version negotiation)
+inline bool quicLongHeader(ByteView data) {
+    return data.size >= 7 && (data[0] & 0xC0) == 0xC0 &&
+           (data[1] | data[2] | data[3] | data[4]) != 0 && data[5] <= 20;
+}
+
+inline bool quicShortHeader(ByteView data) {
+    return data.size >= 2 && (data[0] & 0xC0) == 0x40;
+}
+
+// 12-byte header, at most a handful of questions, opcode 0-2 or 4-5
+inline bool dnsHeader(ByteView data) {
+    if (data.size < 12) return false;
+    const uint8_t opcode = (data[2] >> 3) & 0x0F;
+    const uint16_t questions = static_cast<uint16_t>((data[4] << 8) | data[5]);
+    return (opcode <= 2 || opcode == 4 || opcode == 5) && questions <= 16 && (data[3] & 0x40) == 0;
+}
+
+// DNS over TCP: a two-byte message length (at least a header's worth) precedes the header
+inline bool dnsOverTcp(ByteView data) {
+    return data.size >= 14 && ((data[0] << 8) | data[1]) >= 12 && dnsHeader(data.subview(2));
+}
+
+// BOOTP op 1/2 with Ethernet hardware type and the DHCP magic cookie
+inline bool dhcp(ByteView data) {
+    return data.size >= 240 && (data[0] == 1 || data[0] == 2) && data[1] == 1 &&
+           data[236] == 0x63 && data[237] == 0x82 && data[238] == 0x53 && data[239] == 0x63;
+}
+
+inline bool ntp(ByteView data) {
+    const uint8_t version = (data.size >= 48) ? ((data[0] >> 3) & 0x07) : 0;
+    return version >= 1 && version <= 4;
+}
+
+inline bool sshBanner(ByteView data) {
+    return data.startsWith("SSH-");
+}
+
+} // namespace Probes
+
+namespace Registry {
+
+using ProbeFunction = bool (*)(ByteView);
+
+struct Probe {
+    ProbeFunction matches;
+    ProtocolId result;
+};
+
+constexpr size_t MAX_PROBES = 4;
+
+// Probes tried in order; fallback applies when none matches, e.g. the port's usual protocol
+struct ProbeSet {
+    std::array<Probe, MAX_PROBES> probes;
+    uint8_t count;
+    ProtocolId fallback;
+};
+
+enum ProbeSetId : uint8_t {
+    NoProbes = 0,
+    GenericTcp,
+    GenericUdp,
+    WebTcp,
+    TlsTcp,
+    QuicUdp,
+    DnsPort,
+    DnsTcp,
+    MdnsUdp,
+    DhcpUdp,
+    NtpUdp,
+    SshTcp,
+    ProbeSetCount
+};
+
+struct PortRegistration {
+    uint16_t port;
+    Transport transport;
+    ProbeSetId probeSet;
+};
+
+inline constexpr std::array<ProbeSet, ProbeSetCount> probeSets = {{
+    /* NoProbes   */ { {}, 0, ProtocolId::Unknown },
+    /* GenericTcp */ { {{ { Probes::tlsRecord, ProtocolId::TLS }, { Probes::http1, ProtocolId::HTTP },
+                          { Probes::http2Preface, ProtocolId::HTTP2 }, { Probes::sshBanner, ProtocolId::SSH } }}, 4, ProtocolId::Unknown },
+    /* GenericUdp */ { {{ { Probes::quicLongHeader, ProtocolId::QUIC } }}, 1, ProtocolId::Unknown },
+    /* WebTcp     */ { {{ { Probes::http1, ProtocolId::HTTP }, { Probes::http2Preface, ProtocolId::HTTP2 },
+                          { Probes::http2Frame, ProtocolId::HTTP2 } }}, 3, ProtocolId::HTTP },
+    /* TlsTcp     */ { {{ { Probes::tlsRecord, ProtocolId::TLS }, { Probes::http2Preface, ProtocolId::HTTP2 },
+                          { Probes::http1, ProtocolId::HTTP } }}, 3, ProtocolId::TLS },
+    /* QuicUdp    */ { {{ { Probes::quicLongHeader, ProtocolId::QUIC }, { Probes::quicShortHeader, ProtocolId::QUIC } }}, 2, ProtocolId::Unknown },
+    /* DnsPort    */ { {{ { Probes::dnsHeader, ProtocolId::DNS } }}, 1, ProtocolId::Unknown },
+    /* DnsTcp     */ { {{ { Probes::dnsOverTcp, ProtocolId::DNS } }}, 1, ProtocolId::Unknown },
+    /* MdnsUdp    */ { {{ { Probes::dnsHeader, ProtocolId::MDNS } }}, 1, ProtocolId::Unknown },
+    /* DhcpUdp    */ { {{ { Probes::dhcp, ProtocolId::DHCP } }}, 1, ProtocolId::Unknown },
+    /* NtpUdp     */ { {{ { Probes::ntp, ProtocolId::NTP } }}, 1, ProtocolId::Unknown },
+    /* SshTcp     */ { {{ { Probes::sshBanner, ProtocolId::SSH } }}, 1, ProtocolId::SSH }
+}};
+
+// Adding a protocol: give it a ProtocolId and name, a probe set, and its well-known ports here
+inline constexpr PortRegistration registrations[] = {
+    { 80,   Transport::TCP, WebTcp },
+    { 8080, Transport::TCP, WebTcp },
+    { 8000, Transport::TCP, WebTcp },
+    { 443,  Transport::TCP, TlsTcp },
+    { 8443, Transport::TCP, TlsTcp },
+    { 443,  Transport::UDP, QuicUdp },
+    { 80,   Transport::UDP, QuicUdp },
+    { 53,   Transport::UDP, DnsPort },
+    { 53,   Transport::TCP, DnsTcp },
+    { 5353, Transport::UDP, MdnsUdp },
+    { 67,   Transport::UDP, DhcpUdp },
+    { 68,   Transport::UDP, DhcpUdp },
+    { 123,  Transport::UDP, NtpUdp },
+    { 22,   Transport::TCP, SshTcp }
+};
+
+struct DispatchTable {
+    uint8_t sets[2][65536];
+};
+
+constexpr DispatchTable buildDispatchTable() {
+    DispatchTable table{};
+    for (const PortRegistration& registration : registrations) {
+        table.sets[static_cast<size_t>(registration.transport)][registration.port] = registration.probeSet;
+    }
+    return table;
+}
+
+// 128 KiB of static data; a lookup is a single indexed byte load
+inline constexpr DispatchTable dispatch = buildDispatchTable();
+
+inline constexpr std::string_view names[static_cast<size_t>(ProtocolId::Count)] = {
+    "Unknown", "HTTP", "HTTP/2", "gRPC", "WebSocket", "TLS", "QUIC", "DNS", "mDNS", "DHCP", "NTP", "SSH"
+};
+
+} // namespace Registry
+
+class DissectorRegistry {
+public:
+    static constexpr uint8_t probeSetFor(Transport transport, uint16_t port) {
+        return Registry::dispatch.sets[static_cast<size_t>(transport)][port];
+    }
+
+    // Server port wins: the destination is looked up first, then the source, then the
+    // transport's generic probes. Empty payloads (bare ACKs, SYNs) stay unclassified.
+    static ProtocolId classify(Transport transport, uint16_t sourcePort, uint16_t destPort, ByteView payload) {
+        if (payload.empty()) {
+            return ProtocolId::Unknown;
+        }
+
+        uint8_t setId = probeSetFor(transport, destPort);
+        if (setId == Registry::NoProbes) setId = probeSetFor(transport, sourcePort);
+        if (setId == Registry::NoProbes) setId = transport == Transport::TCP ? Registry::GenericTcp : Registry::GenericUdp;
+
+        const Registry::ProbeSet& set = Registry::probeSets[setId];
+        for (uint8_t i = 0; i < set.count; ++i) {
+            if (set.probes[i].matches(payload)) {
+                return set.probes[i].result;
+            }
+        }
+        return set.fallback;
+    }
+
+    static constexpr std::string_view name(ProtocolId id) {
+        return static_cast<size_t>(id) < static_cast<size_t>(ProtocolId::Count)
+            ? Registry::names[static_cast<size_t>(id)] : Registry::names[0];
+    }
+
+    static constexpr std::string_view name(uint8_t id) {
+        return name(static_cast<ProtocolId>(id));
+    }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
@@ -0,0 +1,142 @@
+// DnsMessage.hpp - DNS header and question parsing with loop-safe compressed name decoding
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../core/ByteView.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::ByteView;
+
+enum class DnsRcode : uint8_t {
+    NoError = 0,
+    FormErr = 1,
+    ServFail = 2,
+    NXDomain = 3,
+    NotImp = 4,
+    Refused = 5
+};
+
+struct DnsHeader {
+    uint16_t id = 0;
+    uint16_t flags = 0;
+    uint16_t questions = 0;
+    uint16_t answers = 0;
+    uint16_t authorities = 0;
+    uint16_t additionals = 0;
+
+    bool isResponse() const { return (flags & 0x8000) != 0; }
+    uint8_t opcode() const { return static_cast<uint8_t>((flags >> 11) & 0x0F); }
+    bool truncated() const { return (flags & 0x0200) != 0; }
+    uint8_t rcode() const { return static_cast<uint8_t>(flags & 0x0F); }
+};
+
+struct DnsQuestion {
+    static constexpr size_t MAX_TEXT = 256;     // 253 characters of dotted name plus the terminator
+
+    char name[MAX_TEXT] = {};                   // Dotted, no trailing dot; "." for the root
+    size_t nameLength = 0;
+    uint16_t type = 0;
+    uint16_t qclass = 0;
+};
+
+// Wire-format DNS (RFC 1035) over a single UDP payload. Nothing allocates: names decode into
+// the caller's fixed buffer.
+//
+// Compression pointers must point strictly before the label sequence that contains them,
+// so every jump moves backward and a loop cannot be built; together with the 255-octet
+// name limit (RFC 1035 3.1) and the pointer cap this bounds the work per name no matter
+// what the packet claims. Label bytes outside printable ASCII, and dots inside a label,
+// are shown as '?'.
+class DnsMessage {
+private:
+    static constexpr size_t HEADER_SIZE = 12;
+    static constexpr size_t MAX_WIRE_NAME = 255;
+    static constexpr int MAX_POINTERS = 127;
+
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+public:
+    static bool parseHeader(ByteView message, DnsHeader& out) {
+        if (message.size < HEADER_SIZE) return false;
+        const uint8_t* p = message.data;
+        out.id = read16(p);
+        out.flags = read16(p + 2);
+        out.questions = read16(p + 4);
+        out.answers = read16(p + 6);
+        out.authorities = read16(p + 8);
+        out.additionals = read16(p + 10);
+        return true;
+    }
+
+    // Decodes the name starting at offset into text; returns the offset just past the name as
+    // it appears at offset (after the first pointer, if any), or 0 when the name is malformed
+    static size_t readName(ByteView message, size_t offset, char (&text)[DnsQuestion::MAX_TEXT], size_t& textLength) {
+        size_t position = offset;
+        size_t sequenceStart = offset;          // Pointers must target bytes before this
+        size_t end = 0;
+        size_t wireLength = 1;                  // Terminating root label
+        size_t written = 0;
+        int pointers = 0;
+
+        while (true) {
+            if (position >= message.size) return 0;
+            const uint8_t length = message[position];
+
+            if ((length & 0xC0) == 0xC0) {
+                if (position + 1 >= message.size || ++pointers > MAX_POINTERS) return 0;
+                const size_t target = (static_cast<size_t>(length & 0x3F) << 8) | message[position + 1];
+                if (target >= sequenceStart) return 0;
+                if (end == 0) end = position + 2;
+                position = target;
+                sequenceStart = target;
+                continue;
+            }
+            if ((length & 0xC0) != 0) return 0;         // 0x40 and 0x80 label types are obsolete
+
+            if (length == 0) {
+                if (end == 0) end = position + 1;
+                break;
+            }
+
+            wireLength += 1 + static_cast<size_t>(length);
+            if (wireLength > MAX_WIRE_NAME || position + 1 + length > message.size) return 0;
+            if (written > 0) text[written++] = '.';
+            for (size_t i = 0; i < length; ++i) {
+                const uint8_t c = message[position + 1 + i];
+                text[written++] = (c > 0x20 && c < 0x7F && c != '.') ? static_cast<char>(c) : '?';
+            }
+            position += 1 + static_cast<size_t>(length);
+        }
+
+        if (written == 0) text[written++] = '.';
+        text[written] = '\0';
+        textLength = written;
+        return end;
+    }
+
+    // First entry of the question section, which is all a query or its response carries in practice
+    static bool parseQuestion(ByteView message, const DnsHeader& header, DnsQuestion& out) {
+        if (header.questions == 0) return false;
+        const size_t nameEnd = readName(message, HEADER_SIZE, out.name, out.nameLength);
+        if (nameEnd == 0 || nameEnd + 4 > message.size) return false;
+        out.type = read16(message.data + nameEnd);
+        out.qclass = read16(message.data + nameEnd + 2);
+        return true;
+    }
+
+    // Case-insensitive FNV-1a (DNS names compare without case, RFC 4343)
+    static uint32_t nameHash(const char* text, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t c = static_cast<uint8_t>(text[i]);
+            if (c >= 'A' && c <= 'Z') c = static_cast<uint8_t>(c + ('a' - 'A'));
+            hash = (hash ^ c) * 16777619u;
+        }
+        return hash;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
@@ -0,0 +1,331 @@
+// DnsTransactionTable.hpp - Query/response matching with per-resolver latency histograms and rcode counts
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/Decapsulator.hpp"
+#include "../core/FlowKey.hpp"
+#include "../core/FlowTable.hpp"
+#include "../core/LatencyHistogram.hpp"
+#include "DnsMessage.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::Decapsulated;
+using Core::Decapsulator;
+using Core::FlowKey;
+using Core::FlowTable;
+
+// One UDP datagram located in a captured frame; message points into the frame
+struct DnsDatagram {
+    FlowKey key;
+    uint8_t direction;
+    ByteView message;
+    uint64_t timestampNs;
+
+    static uint16_t read16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+    // Same framing rules as TcpSegment::fromFrame: IPv4 without fragmentation or IPv6
+    // without extension headers, behind any tunnel the Decapsulator peels
+    static bool fromFrame(ByteView frame, uint64_t timestampNs, DnsDatagram& out) {
+        if (frame.size < 14) return false;
+        const Decapsulated inner = Decapsulator::peel(frame);
+        const uint8_t* l3 = frame.data + inner.l3Offset;
+        const size_t available = frame.size - inner.l3Offset;
+        const uint8_t* source;
+        const uint8_t* dest;
+        uint8_t ipVersion;
+        size_t l4Offset;
+
+        if (inner.etherType == 0x0800 && available >= 20) {
+            const size_t ihl = static_cast<size_t>(l3[0] & 0x0F) * 4;
+            if (l3[9] != 17 || ihl < 20 || ihl > available || (read16(l3 + 6) & 0x3FFF) != 0) return false;
+            source = l3 + 12;
+            dest = l3 + 16;
+            ipVersion = 4;
+            l4Offset = ihl;
+        } else if (inner.etherType == 0x86DD && available >= 40) {
+            if (l3[6] != 17) return false;
+            source = l3 + 8;
+            dest = l3 + 24;
+            ipVersion = 6;
+            l4Offset = 40;
+        } else {
+            return false;
+        }
+
+        if (available < l4Offset + 8) return false;
+        const uint8_t* udp = l3 + l4Offset;
+        const size_t udpLength = read16(udp + 4);
+        if (udpLength < 8) return false;
+        const size_t payloadLength = std::min(udpLength, available - l4Offset) - 8;   // Strips Ethernet padding
+
+        out.direction = FlowKey::make(out.key, ipVersion, 17, source, read16(udp), dest, read16(udp + 2));
+        out.message = ByteView(udp + 8, payloadLength);
+        out.timestampNs = timestampNs;
+        return true;
+    }
+};
+
+struct DnsTransactionConfig {
+    size_t capacity = 1u << 17;                     // Pending query slots, a power of two; 8 MiB
+    uint64_t timeoutNs = 5ull * 1000000000ull;      // Unanswered queries count as timeouts after this
+    size_t maxResolvers = 4096;                     // Queries to further resolvers are matched but not rolled up
+};
+
+struct DnsStatistics {
+    uint64_t queries = 0;
+    uint64_t responses = 0;
+    uint64_t matched = 0;
+    uint64_t retransmits = 0;           // Query repeated with the same id before any answer
+    uint64_t unmatched = 0;             // Responses to no pending query, or a different question
+    uint64_t timeouts = 0;
+    uint64_t dropped = 0;               // Queries not tracked because the table was full
+    uint64_t malformed = 0;
+};
+
+// Rolled up per resolver, the address the queries went to
+struct DnsResolverStats {
+    uint8_t address[16] = {};
+    uint8_t ipVersion = 0;
+    uint64_t queries = 0;
+    uint64_t responses = 0;
+    uint64_t timeouts = 0;
+    uint64_t rcodes[16] = {};           // Indexed by DnsRcode and the other 4-bit codes
+    Core::LatencyHistogram latency;
+};
+
+// Pairs DNS queries with their responses by transaction id and 5-tuple to measure
+// resolution latency, NXDOMAIN and SERVFAIL rates, and timeouts per resolver.
+//
+// Pending queries sit in one cache line each in a fixed open-addressing table, keyed by
+// the canonical FlowKey with the transaction id in its reserved field and hashed like the
+// flow table. Deletion shifts the probe run back instead of leaving tombstones, so the table
+// never needs rebuilding and memory is fixed at construction. A response must come from
+// the other direction and, when it echoes the question, ask the same name and type.
+// Queries beyond 3/4 occupancy are counted as dropped rather than tracked.
+//
+// expire() sweeps the table at most four times per timeout, so an unanswered query is
+// reported between one and 1.25 timeouts after it was sent. Not thread-safe; feed one
+// table per worker.
+class DnsTransactionTable {
+private:
+    static constexpr uint8_t SLOT_EMPTY = 0;
+    static constexpr uint8_t SLOT_OCCUPIED = 1;
+    static constexpr uint32_t NO_RESOLVER = UINT32_MAX;
+
+    struct alignas(64) Slot {
+        FlowKey key;                    // reserved holds the transaction id
+        uint64_t sentNs;
+        uint32_t nameHash;
+        uint32_t resolver;              // Index into resolvers_, or NO_RESOLVER
+        uint16_t type;
+        uint8_t direction;              // Of the query
+        uint8_t state;
+    };
+
+    static_assert(sizeof(Slot) == 64, "Pending query slots must stay one cache line");
+
+    struct ResolverKey {
+        uint8_t address[16];
+        uint8_t ipVersion;
+
+        bool operator==(const ResolverKey& other) const {
+            return ipVersion == other.ipVersion && std::memcmp(address, other.address, 16) == 0;
+        }
+    };
+
+    struct ResolverKeyHash {
+        size_t operator()(const ResolverKey& key) const {
+            uint64_t hash = 1469598103934665603ull ^ key.ipVersion;
+            for (uint8_t byte : key.address) hash = (hash ^ byte) * 1099511628211ull;
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    DnsTransactionConfig config_;
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    size_t size_ = 0;
+    uint64_t lastSweepNs_ = 0;
+    DnsStatistics stats_;
+    std::unordered_map<ResolverKey, uint32_t, ResolverKeyHash> resolverIndex_;
+    std::vector<DnsResolverStats> resolvers_;
+
+    size_t locate(const FlowKey& key, bool& found) const {
+        size_t slot = FlowTable::hash(key) & mask_;
+        while (slots_[slot].state == SLOT_OCCUPIED) {
+            if (slots_[slot].key == key) {
+                found = true;
+                return slot;
+            }
+            slot = (slot + 1) & mask_;
+        }
+        found = false;
+        return slot;
+    }
+
+    // Backward-shift deletion: pulls later members of the probe run into the hole
+    void erase(size_t hole) {
+        size_t next = (hole + 1) & mask_;
+        while (slots_[next].state == SLOT_OCCUPIED) {
+            const size_t home = FlowTable::hash(slots_[next].key) & mask_;
+            // Movable unless its home lies cyclically within (hole, next]
+            if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+            next = (next + 1) & mask_;
+        }
+        slots_[hole].state = SLOT_EMPTY;
+        size_--;
+    }
+
+    uint32_t resolverOf(uint8_t ipVersion, const uint8_t* address) {
+        ResolverKey key{};
+        std::memcpy(key.address, address, ipVersion == 6 ? 16 : 4);
+        key.ipVersion = ipVersion;
+
+        auto it = resolverIndex_.find(key);
+        if (it != resolverIndex_.end()) return it->second;
+        if (resolvers_.size() >= config_.maxResolvers) return NO_RESOLVER;
+
+        const uint32_t index = static_cast<uint32_t>(resolvers_.size());
+        resolvers_.emplace_back();
+        std::memcpy(resolvers_.back().address, key.address, sizeof(key.address));
+        resolvers_.back().ipVersion = ipVersion;
+        resolverIndex_.emplace(key, index);
+        return index;
+    }
+
+    void onQuery(const DnsDatagram& datagram, FlowKey key, const DnsQuestion& question) {
+        stats_.queries++;
+        bool found = false;
+        const size_t slot = locate(key, found);
+        if (found) {
+            stats_.retransmits++;       // Latency stays measured from the first attempt
+            return;
+        }
+        if ((size_ + 1) * 4 > (mask_ + 1) * 3) {
+            stats_.dropped++;
+            return;
+        }
+
+        const uint8_t* resolverAddress = datagram.direction == 0 ? key.addressB : key.addressA;
+        const uint32_t resolver = resolverOf(key.ipVersion, resolverAddress);
+        if (resolver != NO_RESOLVER) resolvers_[resolver].queries++;
+
+        Slot& entry = slots_[slot];
+        entry.key = key;
+        entry.sentNs = datagram.timestampNs;
+        entry.nameHash = DnsMessage::nameHash(question.name, question.nameLength);
+        entry.resolver = resolver;
+        entry.type = question.type;
+        entry.direction = datagram.direction;
+        entry.state = SLOT_OCCUPIED;
+        size_++;
+    }
+
+    void onResponse(const DnsDatagram& datagram, FlowKey key, const DnsHeader& header,
+                    const DnsQuestion& question, bool haveQuestion) {
+        stats_.responses++;
+        bool found = false;
+        const size_t slot = locate(key, found);
+        const Slot& entry = slots_[slot];
+        if (!found || entry.direction == datagram.direction ||
+            (haveQuestion && (entry.type != question.type ||
+                              entry.nameHash != DnsMessage::nameHash(question.name, question.nameLength)))) {
+            stats_.unmatched++;
+            return;
+        }
+
+        stats_.matched++;
+        if (entry.resolver != NO_RESOLVER) {
+            DnsResolverStats& resolver = resolvers_[entry.resolver];
+            const uint64_t latencyNs = datagram.timestampNs > entry.sentNs ? datagram.timestampNs - entry.sentNs : 0;
+            resolver.responses++;
+            resolver.rcodes[header.rcode()]++;
+            resolver.latency.record(latencyNs);
+        }
+        erase(slot);
+    }
+
+public:
+    explicit DnsTransactionTable(const DnsTransactionConfig& config = DnsTransactionConfig{})
+        : config_(config)
+    {
+        if (config_.capacity < 16 || (config_.capacity & (config_.capacity - 1)) != 0) {
+            throw std::invalid_argument("DNS transaction capacity must be a power of two of at least 16");
+        }
+        slots_.reset(new Slot[config_.capacity]());
+        mask_ = config_.capacity - 1;
+        resolvers_.reserve(std::min<size_t>(config_.maxResolvers, 256));
+    }
+
+    DnsTransactionTable(const DnsTransactionTable&) = delete;
+    DnsTransactionTable& operator=(const DnsTransactionTable&) = delete;
+
+    // Standard queries and their responses; other opcodes (NOTIFY, UPDATE) are ignored
+    void onDatagram(const DnsDatagram& datagram) {
+        DnsHeader header;
+        if (!DnsMessage::parseHeader(datagram.message, header)) {
+            stats_.malformed++;
+            return;
+        }
+        if (header.opcode() != 0) return;
+
+        DnsQuestion question;
+        const bool haveQuestion = DnsMessage::parseQuestion(datagram.message, header, question);
+        if (header.questions != 0 && !haveQuestion) {
+            stats_.malformed++;
+            return;
+        }
+
+        FlowKey key = datagram.key;
+        key.reserved = header.id;
+        if (header.isResponse()) {
+            onResponse(datagram, key, header, question, haveQuestion);
+        } else if (haveQuestion) {
+            onQuery(datagram, key, question);
+        } else {
+            stats_.malformed++;
+        }
+    }
+
+    // Counts and frees queries older than the timeout; cheap to call once per batch
+    void expire(uint64_t nowNs) {
+        if (nowNs < lastSweepNs_ + config_.timeoutNs / 4) return;
+        lastSweepNs_ = nowNs;
+
+        for (size_t slot = 0; slot <= mask_; ++slot) {
+            // A shift may pull an unvisited entry into this slot, so look again after erasing
+            while (slots_[slot].state == SLOT_OCCUPIED && slots_[slot].sentNs + config_.timeoutNs < nowNs) {
+                if (slots_[slot].resolver != NO_RESOLVER) resolvers_[slots_[slot].resolver].timeouts++;
+                stats_.timeouts++;
+                erase(slot);
+            }
+        }
+    }
+
+    void clear() {
+        std::fill(slots_.get(), slots_.get() + mask_ + 1, Slot{});
+        size_ = 0;
+        lastSweepNs_ = 0;
+        stats_ = DnsStatistics{};
+        resolverIndex_.clear();
+        resolvers_.clear();
+    }
+
+    size_t pending() const { return size_; }
+    const DnsStatistics& statistics() const { return stats_; }
+    const std::vector<DnsResolverStats>& resolvers() const { return resolvers_; }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
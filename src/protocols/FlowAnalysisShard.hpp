@@ -0,0 +1,343 @@
+// FlowAnalysisShard.hpp - Per-worker flow, TLS, DNS and HTTP state for FlowShardedDispatcher, with mergeable reports
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/FlowKey.hpp"
+#include "../core/FlowTable.hpp"
+#include "../core/PacketRecord.hpp"
+#include "../core/TcpReassembler.hpp"
+#include "DissectorRegistry.hpp"
+#include "DnsTransactionTable.hpp"
+#include "Http1Transactions.hpp"
+#include "TlsFlowTracker.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::FlowEntry;
+using Core::FlowKey;
+using Core::FlowKeyHash;
+
+struct HostAddress {
+    uint8_t ipVersion = 0;
+    uint8_t address[16] = {};
+
+    bool operator==(const HostAddress& other) const {
+        return ipVersion == other.ipVersion && std::memcmp(address, other.address, sizeof(address)) == 0;
+    }
+};
+
+// The two endpoints of a canonical FlowKey, A first
+struct HostPair {
+    HostAddress a;
+    HostAddress b;
+
+    bool operator==(const HostPair& other) const { return a == other.a && b == other.b; }
+};
+
+struct HostAddressHash {
+    size_t operator()(const HostAddress& host) const {
+        uint64_t hash = 1469598103934665603ull ^ host.ipVersion;
+        for (uint8_t byte : host.address) hash = (hash ^ byte) * 1099511628211ull;
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct HostPairHash {
+    size_t operator()(const HostPair& pair) const {
+        const size_t a = HostAddressHash{}(pair.a);
+        return a ^ (HostAddressHash{}(pair.b) + 0x9E3779B97F4A7C15ull + (a << 6) + (a >> 2));
+    }
+};
+
+struct HostTraffic {
+    uint64_t bytes = 0;
+    uint64_t packets = 0;
+    uint64_t flows = 0;
+
+    void add(const HostTraffic& other) {
+        bytes += other.bytes;
+        packets += other.packets;
+        flows += other.flows;
+    }
+};
+
+// What the reports read, rolled up per shard and merged across shards. Flows are split
+// between shards by 5-tuple, so host and link totals add up; resolvers and HTTP endpoints
+// can appear in several shards and are combined by address and by method, host and path.
+struct FlowAnalysisSummary {
+    uint64_t activeFlows = 0;
+    uint64_t flowTableBytes = 0;
+    Core::FlowTableStatistics flows;
+    uint64_t badChecksums = 0;          // PACKET_BAD_CHECKSUM, only set when validation is enabled
+    uint64_t offloadedChecksums = 0;
+
+    std::unordered_map<HostAddress, HostTraffic, HostAddressHash> hosts;
+    std::unordered_map<HostPair, HostTraffic, HostPairHash> links;
+
+    std::vector<std::pair<FlowKey, TlsFlowInfo>> tlsSessions;   // At most MAX_TLS_SESSIONS per shard
+
+    DnsStatistics dns;
+    uint64_t dnsPending = 0;
+    std::vector<DnsResolverStats> resolvers;
+
+    Http1TransactionStatistics http;
+    uint64_t httpConnections = 0;
+    uint64_t reassemblyGaps = 0;
+    std::vector<Http1EndpointStats> endpoints;
+    StreamActivityStatistics streams;
+
+    void merge(const FlowAnalysisSummary& other) {
+        activeFlows += other.activeFlows;
+        flowTableBytes += other.flowTableBytes;
+        flows.created += other.flows.created;
+        flows.expired += other.flows.expired;
+        flows.rejected += other.flows.rejected;
+        flows.rehashes += other.flows.rehashes;
+        badChecksums += other.badChecksums;
+        offloadedChecksums += other.offloadedChecksums;
+
+        for (const auto& host : other.hosts) hosts[host.first].add(host.second);
+        for (const auto& link : other.links) links[link.first].add(link.second);
+        tlsSessions.insert(tlsSessions.end(), other.tlsSessions.begin(), other.tlsSessions.end());
+
+        mergeDns(other);
+        mergeHttp(other);
+    }
+
+private:
+    void mergeDns(const FlowAnalysisSummary& other) {
+        dns.queries += other.dns.queries;
+        dns.responses += other.dns.responses;
+        dns.matched += other.dns.matched;
+        dns.retransmits += other.dns.retransmits;
+        dns.unmatched += other.dns.unmatched;
+        dns.timeouts += other.dns.timeouts;
+        dns.dropped += other.dns.dropped;
+        dns.malformed += other.dns.malformed;
+        dnsPending += other.dnsPending;
+
+        std::unordered_map<HostAddress, size_t, HostAddressHash> index;
+        for (size_t i = 0; i < resolvers.size(); ++i) index.emplace(addressOf(resolvers[i]), i);
+        for (const DnsResolverStats& resolver : other.resolvers) {
+            auto it = index.find(addressOf(resolver));
+            if (it == index.end()) {
+                index.emplace(addressOf(resolver), resolvers.size());
+                resolvers.push_back(resolver);
+                continue;
+            }
+            DnsResolverStats& known = resolvers[it->second];
+            known.queries += resolver.queries;
+            known.responses += resolver.responses;
+            known.timeouts += resolver.timeouts;
+            for (size_t i = 0; i < 16; ++i) known.rcodes[i] += resolver.rcodes[i];
+            known.latency.merge(resolver.latency);
+        }
+    }
+
+    void mergeHttp(const FlowAnalysisSummary& other) {
+        http.requests += other.http.requests;
+        http.responses += other.http.responses;
+        http.matched += other.http.matched;
+        http.unmatched += other.http.unmatched;
+        http.pipelineOverflows += other.http.pipelineOverflows;
+        http.untrackedEndpoints += other.http.untrackedEndpoints;
+        http.rejectedConnections += other.http.rejectedConnections;
+        httpConnections += other.httpConnections;
+        reassemblyGaps += other.reassemblyGaps;
+
+        streams.webSocketMessages += other.streams.webSocketMessages;
+        streams.webSocketBytes += other.streams.webSocketBytes;
+        streams.truncatedWebSocketMessages += other.streams.truncatedWebSocketMessages;
+        streams.webSocketControlFrames += other.streams.webSocketControlFrames;
+        streams.http2HeaderBlocks += other.streams.http2HeaderBlocks;
+        streams.grpcHeaderBlocks += other.streams.grpcHeaderBlocks;
+
+        std::unordered_map<std::string, size_t> index;
+        for (size_t i = 0; i < endpoints.size(); ++i) index.emplace(endpointKey(endpoints[i]), i);
+        for (const Http1EndpointStats& endpoint : other.endpoints) {
+            std::string key = endpointKey(endpoint);
+            auto it = index.find(key);
+            if (it == index.end()) {
+                index.emplace(std::move(key), endpoints.size());
+                endpoints.push_back(endpoint);
+                continue;
+            }
+            Http1EndpointStats& known = endpoints[it->second];
+            known.requests += endpoint.requests;
+            known.responses += endpoint.responses;
+            known.unanswered += endpoint.unanswered;
+            for (size_t i = 0; i < 6; ++i) known.statusClasses[i] += endpoint.statusClasses[i];
+            known.latency.merge(endpoint.latency);
+        }
+    }
+
+    static HostAddress addressOf(const DnsResolverStats& resolver) {
+        HostAddress host;
+        host.ipVersion = resolver.ipVersion;
+        std::memcpy(host.address, resolver.address, sizeof(host.address));
+        return host;
+    }
+
+    static std::string endpointKey(const Http1EndpointStats& endpoint) {
+        std::string key;
+        key.reserve(endpoint.method.size() + endpoint.host.size() + endpoint.path.size() + 2);
+        key.append(endpoint.method).append(1, '\0').append(endpoint.host).append(1, '\0').append(endpoint.path);
+        return key;
+    }
+};
+
+// Everything the model tracks per flow, for one parsing worker: the flow table, TLS
+// handshakes, DNS transactions and HTTP/1, HTTP/2 and WebSocket streams. Buffer budgets are
+// divided by the shard count so the whole pool stays within the single-table limits.
+class FlowAnalysisShard {
+private:
+    static constexpr size_t MAX_TLS_SESSIONS = 1024;
+
+    Core::FlowTable flowTable_;
+    TlsFlowTracker tlsFlows_;
+    DnsTransactionTable dnsTransactions_;
+    Http1LatencyMonitor httpLatency_;
+    uint64_t badChecksums_ = 0;
+    uint64_t offloadedChecksums_ = 0;
+
+    static DnsTransactionConfig dnsConfig(size_t shards) {
+        DnsTransactionConfig config;
+        size_t capacity = config.capacity / std::max<size_t>(shards, 1);
+        size_t rounded = 16;
+        while (rounded < capacity) rounded <<= 1;
+        config.capacity = rounded;
+        return config;
+    }
+
+    static Core::ReassemblyConfig reassemblyConfig(size_t shards) {
+        Core::ReassemblyConfig config = Http1LatencyMonitor::defaultConfig();
+        shards = std::max<size_t>(shards, 1);
+        config.bufferBudget = std::max<size_t>(config.bufferBudget / shards, config.maxStreamBuffer * 4);
+        config.maxFlows = std::max<size_t>(config.maxFlows / shards, 1024);
+        return config;
+    }
+
+    static HostAddress hostOf(uint8_t ipVersion, const uint8_t* address) {
+        HostAddress host;
+        host.ipVersion = ipVersion;
+        std::memcpy(host.address, address, ipVersion == 6 ? 16 : 4);
+        return host;
+    }
+
+public:
+    using Aggregate = FlowAnalysisSummary;
+
+    explicit FlowAnalysisShard(size_t shards = 1)
+        : tlsFlows_(std::max<size_t>((1u << 16) / std::max<size_t>(shards, 1), 1024))
+        , dnsTransactions_(dnsConfig(shards))
+        , httpLatency_(reassemblyConfig(shards)) {}
+
+    void onPackets(const Core::PacketBatch& batch, const std::vector<uint32_t>& records) {
+        using Core::ByteView;
+        using Core::TcpSegment;
+
+        uint64_t latest = 0;
+        for (uint32_t index : records) {
+            const Core::PacketRecord& record = batch.records[index];
+            if (record.ipVersion == 0) continue;
+            if (record.flags & Core::PACKET_BAD_CHECKSUM) {
+                badChecksums_++;
+            } else if (record.flags & Core::PACKET_CHECKSUM_OFFLOADED) {
+                offloadedChecksums_++;
+            }
+
+            FlowKey key;
+            const uint8_t direction = FlowKey::make(key, record.ipVersion, record.ipProtocol,
+                                                    record.sourceAddress, record.sourcePort,
+                                                    record.destAddress, record.destPort);
+            FlowEntry* flow = flowTable_.update(key, direction, record.wireLength, record.timestampNs,
+                                                record.tcpFlags, record.appProtocol);
+            latest = std::max(latest, record.timestampNs);
+            const ByteView frame(batch.data(record), record.capturedLength);
+
+            // Only handshake packets are parsed: the tracker marks the flow once it has both hellos
+            if (flow && flow->appProtocol == static_cast<uint8_t>(ProtocolId::TLS) && !(flow->flags & Core::FLOW_INSPECTED)) {
+                TcpSegment segment;
+                if (TcpSegment::fromFrame(frame, record.timestampNs, segment) && tlsFlows_.onSegment(segment)) {
+                    flow->flags |= Core::FLOW_INSPECTED;
+                }
+            }
+
+            // HTTP flows are reassembled whole so every request and response header is seen; gRPC
+            // is told apart from other HTTP/2 by the content-type of the decoded headers
+            const bool http2 = flow && (flow->appProtocol == static_cast<uint8_t>(ProtocolId::HTTP2) ||
+                                        flow->appProtocol == static_cast<uint8_t>(ProtocolId::GRPC));
+            if (flow && (flow->appProtocol == static_cast<uint8_t>(ProtocolId::HTTP) || http2) && record.ipProtocol == 6) {
+                TcpSegment segment;
+                if (TcpSegment::fromFrame(frame, record.timestampNs, segment)) {
+                    const uint64_t grpcBlocks = httpLatency_.activity().grpcHeaderBlocks;
+                    httpLatency_.onSegment(segment);
+                    if (http2 && httpLatency_.activity().grpcHeaderBlocks != grpcBlocks) {
+                        flow->appProtocol = static_cast<uint8_t>(ProtocolId::GRPC);
+                    }
+                }
+            }
+
+            // Every DNS packet is parsed: each one is a query or the response that closes it
+            if (record.appProtocol == static_cast<uint8_t>(ProtocolId::DNS) && record.ipProtocol == 17) {
+                DnsDatagram datagram;
+                if (DnsDatagram::fromFrame(frame, record.timestampNs, datagram)) {
+                    dnsTransactions_.onDatagram(datagram);
+                }
+            }
+        }
+
+        dnsTransactions_.expire(latest);
+        httpLatency_.expire(latest);
+        flowTable_.advance(latest, [this](const FlowEntry& flow) {
+            if (flow.appProtocol == static_cast<uint8_t>(ProtocolId::TLS)) {
+                tlsFlows_.erase(flow.key);
+            }
+        });
+    }
+
+    Aggregate snapshot() const {
+        Aggregate summary;
+        summary.activeFlows = flowTable_.size();
+        summary.flowTableBytes = flowTable_.memoryBytes();
+        summary.flows = flowTable_.statistics();
+        summary.badChecksums = badChecksums_;
+        summary.offloadedChecksums = offloadedChecksums_;
+
+        // A host's traffic is everything on the flows it takes part in, in either direction
+        flowTable_.forEach([&](const FlowEntry& flow) {
+            const HostTraffic traffic{ flow.bytes, flow.packets, 1 };
+            const HostAddress a = hostOf(flow.key.ipVersion, flow.key.addressA);
+            const HostAddress b = hostOf(flow.key.ipVersion, flow.key.addressB);
+            summary.hosts[a].add(traffic);
+            summary.hosts[b].add(traffic);
+            summary.links[HostPair{ a, b }].add(traffic);
+        });
+
+        summary.tlsSessions.reserve(std::min(tlsFlows_.size(), MAX_TLS_SESSIONS));
+        tlsFlows_.forEach([&](const FlowKey& key, const TlsFlowInfo& info) {
+            if (summary.tlsSessions.size() < MAX_TLS_SESSIONS) summary.tlsSessions.emplace_back(key, info);
+        });
+
+        summary.dns = dnsTransactions_.statistics();
+        summary.dnsPending = dnsTransactions_.pending();
+        summary.resolvers = dnsTransactions_.resolvers();
+
+        const auto& transactions = httpLatency_.transactions();
+        summary.http = transactions.statistics();
+        summary.httpConnections = transactions.connectionCount();
+        summary.reassemblyGaps = httpLatency_.reassembly().gaps;
+        summary.endpoints = transactions.endpoints();
+        summary.streams = httpLatency_.activity();
+        return summary;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
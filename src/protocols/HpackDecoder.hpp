@@ -0,0 +1,507 @@
+// HpackDecoder.hpp - HPACK (RFC 7541) header block decoding with table-driven Huffman
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "../core/ByteView.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::ByteView;
+
+namespace Hpack {
+
+struct StaticEntry {
+    std::string_view name;
+    std::string_view value;
+};
+
+// RFC 7541 Appendix A; index 1 is the first entry
+inline constexpr StaticEntry staticTable[61] = {
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" },
+};
+
+constexpr size_t STATIC_ENTRIES = 61;
+constexpr size_t ENTRY_OVERHEAD = 32;
+
+} // namespace Hpack
+
+namespace Huffman {
+
+struct Code {
+    uint32_t bits;
+    uint8_t length;
+};
+
+// RFC 7541 Appendix B, indexed by symbol
+inline constexpr Code codes[257] = {
+    { 0x00001ff8, 13 }, { 0x007fffd8, 23 }, { 0x0fffffe2, 28 }, { 0x0fffffe3, 28 },
+    { 0x0fffffe4, 28 }, { 0x0fffffe5, 28 }, { 0x0fffffe6, 28 }, { 0x0fffffe7, 28 },
+    { 0x0fffffe8, 28 }, { 0x00ffffea, 24 }, { 0x3ffffffc, 30 }, { 0x0fffffe9, 28 },
+    { 0x0fffffea, 28 }, { 0x3ffffffd, 30 }, { 0x0fffffeb, 28 }, { 0x0fffffec, 28 },
+    { 0x0fffffed, 28 }, { 0x0fffffee, 28 }, { 0x0fffffef, 28 }, { 0x0ffffff0, 28 },
+    { 0x0ffffff1, 28 }, { 0x0ffffff2, 28 }, { 0x3ffffffe, 30 }, { 0x0ffffff3, 28 },
+    { 0x0ffffff4, 28 }, { 0x0ffffff5, 28 }, { 0x0ffffff6, 28 }, { 0x0ffffff7, 28 },
+    { 0x0ffffff8, 28 }, { 0x0ffffff9, 28 }, { 0x0ffffffa, 28 }, { 0x0ffffffb, 28 },
+    { 0x00000014,  6 }, { 0x000003f8, 10 }, { 0x000003f9, 10 }, { 0x00000ffa, 12 },
+    { 0x00001ff9, 13 }, { 0x00000015,  6 }, { 0x000000f8,  8 }, { 0x000007fa, 11 },
+    { 0x000003fa, 10 }, { 0x000003fb, 10 }, { 0x000000f9,  8 }, { 0x000007fb, 11 },
+    { 0x000000fa,  8 }, { 0x00000016,  6 }, { 0x00000017,  6 }, { 0x00000018,  6 },
+    { 0x00000000,  5 }, { 0x00000001,  5 }, { 0x00000002,  5 }, { 0x00000019,  6 },
+    { 0x0000001a,  6 }, { 0x0000001b,  6 }, { 0x0000001c,  6 }, { 0x0000001d,  6 },
+    { 0x0000001e,  6 }, { 0x0000001f,  6 }, { 0x0000005c,  7 }, { 0x000000fb,  8 },
+    { 0x00007ffc, 15 }, { 0x00000020,  6 }, { 0x00000ffb, 12 }, { 0x000003fc, 10 },
+    { 0x00001ffa, 13 }, { 0x00000021,  6 }, { 0x0000005d,  7 }, { 0x0000005e,  7 },
+    { 0x0000005f,  7 }, { 0x00000060,  7 }, { 0x00000061,  7 }, { 0x00000062,  7 },
+    { 0x00000063,  7 }, { 0x00000064,  7 }, { 0x00000065,  7 }, { 0x00000066,  7 },
+    { 0x00000067,  7 }, { 0x00000068,  7 }, { 0x00000069,  7 }, { 0x0000006a,  7 },
+    { 0x0000006b,  7 }, { 0x0000006c,  7 }, { 0x0000006d,  7 }, { 0x0000006e,  7 },
+    { 0x0000006f,  7 }, { 0x00000070,  7 }, { 0x00000071,  7 }, { 0x00000072,  7 },
+    { 0x000000fc,  8 }, { 0x00000073,  7 }, { 0x000000fd,  8 }, { 0x00001ffb, 13 },
+    { 0x0007fff0, 19 }, { 0x00001ffc, 13 }, { 0x00003ffc, 14 }, { 0x00000022,  6 },
+    { 0x00007ffd, 15 }, { 0x00000003,  5 }, { 0x00000023,  6 }, { 0x00000004,  5 },
+    { 0x00000024,  6 }, { 0x00000005,  5 }, { 0x00000025,  6 }, { 0x00000026,  6 },
+    { 0x00000027,  6 }, { 0x00000006,  5 }, { 0x00000074,  7 }, { 0x00000075,  7 },
+    { 0x00000028,  6 }, { 0x00000029,  6 }, { 0x0000002a,  6 }, { 0x00000007,  5 },
+    { 0x0000002b,  6 }, { 0x00000076,  7 }, { 0x0000002c,  6 }, { 0x00000008,  5 },
+    { 0x00000009,  5 }, { 0x0000002d,  6 }, { 0x00000077,  7 }, { 0x00000078,  7 },
+    { 0x00000079,  7 }, { 0x0000007a,  7 }, { 0x0000007b,  7 }, { 0x00007ffe, 15 },
+    { 0x000007fc, 11 }, { 0x00003ffd, 14 }, { 0x00001ffd, 13 }, { 0x0ffffffc, 28 },
+    { 0x000fffe6, 20 }, { 0x003fffd2, 22 }, { 0x000fffe7, 20 }, { 0x000fffe8, 20 },
+    { 0x003fffd3, 22 }, { 0x003fffd4, 22 }, { 0x003fffd5, 22 }, { 0x007fffd9, 23 },
+    { 0x003fffd6, 22 }, { 0x007fffda, 23 }, { 0x007fffdb, 23 }, { 0x007fffdc, 23 },
+    { 0x007fffdd, 23 }, { 0x007fffde, 23 }, { 0x00ffffeb, 24 }, { 0x007fffdf, 23 },
+    { 0x00ffffec, 24 }, { 0x00ffffed, 24 }, { 0x003fffd7, 22 }, { 0x007fffe0, 23 },
+    { 0x00ffffee, 24 }, { 0x007fffe1, 23 }, { 0x007fffe2, 23 }, { 0x007fffe3, 23 },
+    { 0x007fffe4, 23 }, { 0x001fffdc, 21 }, { 0x003fffd8, 22 }, { 0x007fffe5, 23 },
+    { 0x003fffd9, 22 }, { 0x007fffe6, 23 }, { 0x007fffe7, 23 }, { 0x00ffffef, 24 },
+    { 0x003fffda, 22 }, { 0x001fffdd, 21 }, { 0x000fffe9, 20 }, { 0x003fffdb, 22 },
+    { 0x003fffdc, 22 }, { 0x007fffe8, 23 }, { 0x007fffe9, 23 }, { 0x001fffde, 21 },
+    { 0x007fffea, 23 }, { 0x003fffdd, 22 }, { 0x003fffde, 22 }, { 0x00fffff0, 24 },
+    { 0x001fffdf, 21 }, { 0x003fffdf, 22 }, { 0x007fffeb, 23 }, { 0x007fffec, 23 },
+    { 0x001fffe0, 21 }, { 0x001fffe1, 21 }, { 0x003fffe0, 22 }, { 0x001fffe2, 21 },
+    { 0x007fffed, 23 }, { 0x003fffe1, 22 }, { 0x007fffee, 23 }, { 0x007fffef, 23 },
+    { 0x000fffea, 20 }, { 0x003fffe2, 22 }, { 0x003fffe3, 22 }, { 0x003fffe4, 22 },
+    { 0x007ffff0, 23 }, { 0x003fffe5, 22 }, { 0x003fffe6, 22 }, { 0x007ffff1, 23 },
+    { 0x03ffffe0, 26 }, { 0x03ffffe1, 26 }, { 0x000fffeb, 20 }, { 0x0007fff1, 19 },
+    { 0x003fffe7, 22 }, { 0x007ffff2, 23 }, { 0x003fffe8, 22 }, { 0x01ffffec, 25 },
+    { 0x03ffffe2, 26 }, { 0x03ffffe3, 26 }, { 0x03ffffe4, 26 }, { 0x07ffffde, 27 },
+    { 0x07ffffdf, 27 }, { 0x03ffffe5, 26 }, { 0x00fffff1, 24 }, { 0x01ffffed, 25 },
+    { 0x0007fff2, 19 }, { 0x001fffe3, 21 }, { 0x03ffffe6, 26 }, { 0x07ffffe0, 27 },
+    { 0x07ffffe1, 27 }, { 0x03ffffe7, 26 }, { 0x07ffffe2, 27 }, { 0x00fffff2, 24 },
+    { 0x001fffe4, 21 }, { 0x001fffe5, 21 }, { 0x03ffffe8, 26 }, { 0x03ffffe9, 26 },
+    { 0x0ffffffd, 28 }, { 0x07ffffe3, 27 }, { 0x07ffffe4, 27 }, { 0x07ffffe5, 27 },
+    { 0x000fffec, 20 }, { 0x00fffff3, 24 }, { 0x000fffed, 20 }, { 0x001fffe6, 21 },
+    { 0x003fffe9, 22 }, { 0x001fffe7, 21 }, { 0x001fffe8, 21 }, { 0x007ffff3, 23 },
+    { 0x003fffea, 22 }, { 0x003fffeb, 22 }, { 0x01ffffee, 25 }, { 0x01ffffef, 25 },
+    { 0x00fffff4, 24 }, { 0x00fffff5, 24 }, { 0x03ffffea, 26 }, { 0x007ffff4, 23 },
+    { 0x03ffffeb, 26 }, { 0x07ffffe6, 27 }, { 0x03ffffec, 26 }, { 0x03ffffed, 26 },
+    { 0x07ffffe7, 27 }, { 0x07ffffe8, 27 }, { 0x07ffffe9, 27 }, { 0x07ffffea, 27 },
+    { 0x07ffffeb, 27 }, { 0x0ffffffe, 28 }, { 0x07ffffec, 27 }, { 0x07ffffed, 27 },
+    { 0x07ffffee, 27 }, { 0x07ffffef, 27 }, { 0x07fffff0, 27 }, { 0x03ffffee, 26 },
+    { 0x3fffffff, 30 }   // EOS
+};
+
+enum TransitionFlags : uint8_t {
+    EMIT = 1 << 0,          // Transition completes a symbol
+    FAIL = 1 << 1,          // EOS decoded: the string is malformed
+    ACCEPT = 1 << 2         // Ending here leaves valid padding (fewer than 8 one bits)
+};
+
+struct Transition {
+    uint8_t state;
+    uint8_t flags;
+    uint8_t symbol;
+};
+
+// Decoder automaton over 4-bit input: a state is an internal node of the code tree (257 leaves,
+// so 256 internal nodes), and every code is at least 5 bits, so a nibble emits at most one symbol
+struct DecodeTable {
+    Transition next[256][16];
+};
+
+constexpr DecodeTable buildDecodeTable() {
+    uint16_t child[256][2] = {};    // Internal node index, or 256 + symbol for a leaf; 0 is unset
+    uint8_t depth[256] = {};
+    bool allOnes[256] = {};
+    uint16_t nodes = 1;
+    allOnes[0] = true;
+
+    for (uint16_t symbol = 0; symbol < 257; ++symbol) {
+        const Code code = codes[symbol];
+        uint16_t node = 0;
+        for (int bit = code.length - 1; bit > 0; --bit) {
+            const uint8_t value = (code.bits >> bit) & 1;
+            if (child[node][value] == 0) {
+                child[node][value] = nodes;
+                depth[nodes] = static_cast<uint8_t>(depth[node] + 1);
+                allOnes[nodes] = allOnes[node] && value == 1;
+                ++nodes;
+            }
+            node = child[node][value];
+        }
+        child[node][code.bits & 1] = static_cast<uint16_t>(256 + symbol);
+    }
+
+    DecodeTable table{};
+    for (uint16_t state = 0; state < 256; ++state) {
+        for (uint8_t nibble = 0; nibble < 16; ++nibble) {
+            Transition transition{};
+            uint16_t node = state;
+            for (int bit = 3; bit >= 0; --bit) {
+                const uint16_t next = child[node][(nibble >> bit) & 1];
+                if (next >= 256) {
+                    if (next == 256 + 256) {
+                        transition.flags = FAIL;
+                        break;
+                    }
+                    transition.flags |= EMIT;
+                    transition.symbol = static_cast<uint8_t>(next - 256);
+                    node = 0;
+                } else {
+                    node = next;
+                }
+            }
+            if (!(transition.flags & FAIL)) {
+                transition.state = static_cast<uint8_t>(node);
+                if (depth[node] < 8 && allOnes[node]) transition.flags |= ACCEPT;
+            }
+            table.next[state][nibble] = transition;
+        }
+    }
+    return table;
+}
+
+// 12 KiB, built at compile time
+inline constexpr DecodeTable decodeTable = buildDecodeTable();
+
+// Appends the decoded string to out; false on EOS in the data or invalid padding
+inline bool decode(ByteView input, std::vector<uint8_t>& out) {
+    const size_t start = out.size();
+    out.resize(start + input.size * 2);         // At most one symbol per nibble
+    uint8_t* write = out.data() + start;
+
+    uint8_t state = 0;
+    uint8_t flags = ACCEPT;
+    for (uint8_t byte : input) {
+        Transition high = decodeTable.next[state][byte >> 4];
+        if (high.flags & FAIL) return false;
+        if (high.flags & EMIT) *write++ = high.symbol;
+
+        Transition low = decodeTable.next[high.state][byte & 0x0F];
+        if (low.flags & FAIL) return false;
+        if (low.flags & EMIT) *write++ = low.symbol;
+
+        state = low.state;
+        flags = low.flags;
+    }
+
+    out.resize(static_cast<size_t>(write - out.data()));
+    return (flags & ACCEPT) != 0;
+}
+
+} // namespace Huffman
+
+enum class HpackError : uint8_t {
+    None = 0,
+    Truncated,
+    IntegerOverflow,
+    BadIndex,
+    BadHuffman,
+    BadTableSizeUpdate
+};
+
+// One decoder per direction of an HTTP/2 connection: the dynamic table is connection state
+// and every HEADERS block must be decoded, in order, for it to stay in sync.
+//
+// The dynamic table keeps its bytes in one buffer that only grows to twice the table size;
+// entries are appended and evicted from the front, and the buffer is compacted when the
+// append point reaches the end. Steady-state decoding does not allocate.
+class HpackDecoder {
+private:
+    struct Entry {
+        uint32_t offset;
+        uint32_t nameLength;
+        uint32_t valueLength;
+    };
+
+    std::vector<uint8_t> storage_;
+    uint32_t storageStart_ = 0;         // Oldest live byte
+    uint32_t storageEnd_ = 0;
+
+    std::vector<Entry> entries_;        // Ring, newest at entryHead_ - 1
+    size_t entryHead_ = 0;
+    size_t entryCount_ = 0;
+
+    size_t tableSize_ = 0;              // Per RFC 7541 4.1: name + value + 32 per entry
+    size_t maxTableSize_ = 4096;        // Current limit, set by size updates in the stream
+    size_t allowedTableSize_ = 4096;    // SETTINGS_HEADER_TABLE_SIZE of the receiving side
+
+    std::vector<uint8_t> nameScratch_;
+    std::vector<uint8_t> valueScratch_;
+
+    const Entry& dynamicEntry(size_t index) const {
+        // index 0 is the newest entry
+        return entries_[(entryHead_ + entries_.size() - 1 - index) % entries_.size()];
+    }
+
+    std::string_view storageText(uint32_t offset, uint32_t length) const {
+        return std::string_view(reinterpret_cast<const char*>(storage_.data()) + offset, length);
+    }
+
+    void evictOldest() {
+        const Entry& oldest = dynamicEntry(entryCount_ - 1);
+        tableSize_ -= oldest.nameLength + oldest.valueLength + Hpack::ENTRY_OVERHEAD;
+        storageStart_ = oldest.offset + oldest.nameLength + oldest.valueLength;
+        entryCount_--;
+        if (entryCount_ == 0) storageStart_ = storageEnd_ = 0;
+    }
+
+    void evictTo(size_t limit) {
+        while (tableSize_ > limit && entryCount_ > 0) {
+            evictOldest();
+        }
+    }
+
+    void insert(std::string_view name, std::string_view value) {
+        const size_t size = name.size() + value.size() + Hpack::ENTRY_OVERHEAD;
+        if (size > maxTableSize_) {
+            // RFC 7541 4.4: an entry larger than the table empties it and is not added
+            evictTo(0);
+            return;
+        }
+        evictTo(maxTableSize_ - size);
+
+        const size_t bytes = name.size() + value.size();
+        if (storageEnd_ + bytes > storage_.size()) {
+            const size_t live = storageEnd_ - storageStart_;
+            if (live + bytes > storage_.size() / 2 || storage_.empty()) {
+                storage_.resize(std::max<size_t>(2 * maxTableSize_, 2 * (live + bytes)));
+            }
+            std::memmove(storage_.data(), storage_.data() + storageStart_, live);
+            for (size_t i = 0; i < entryCount_; ++i) {
+                entries_[(entryHead_ + entries_.size() - 1 - i) % entries_.size()].offset -= storageStart_;
+            }
+            storageStart_ = 0;
+            storageEnd_ = static_cast<uint32_t>(live);
+        }
+
+        std::memcpy(storage_.data() + storageEnd_, name.data(), name.size());
+        std::memcpy(storage_.data() + storageEnd_ + name.size(), value.data(), value.size());
+
+        // Every entry costs at least 32 bytes, so the ring never needs more than this
+        const size_t capacity = maxTableSize_ / Hpack::ENTRY_OVERHEAD + 1;
+        if (entries_.size() < capacity) {
+            std::vector<Entry> resized(capacity);
+            for (size_t i = 0; i < entryCount_; ++i) {
+                resized[entryCount_ - 1 - i] = dynamicEntry(i);
+            }
+            entries_.swap(resized);
+            entryHead_ = entryCount_;
+        }
+
+        entries_[entryHead_ % entries_.size()] = Entry{ storageEnd_, static_cast<uint32_t>(name.size()),
+                                                        static_cast<uint32_t>(value.size()) };
+        entryHead_ = (entryHead_ + 1) % entries_.size();
+        entryCount_++;
+        storageEnd_ += static_cast<uint32_t>(bytes);
+        tableSize_ += size;
+    }
+
+    // RFC 7541 5.1 prefix integer; values past 32 bits are rejected
+    static HpackError readInteger(ByteView block, size_t& offset, uint8_t prefixBits, uint32_t& value) {
+        if (offset >= block.size) return HpackError::Truncated;
+        const uint32_t mask = (1u << prefixBits) - 1;
+        value = block[offset++] & mask;
+        if (value < mask) return HpackError::None;
+
+        for (uint32_t shift = 0; shift <= 28; shift += 7) {
+            if (offset >= block.size) return HpackError::Truncated;
+            const uint8_t byte = block[offset++];
+            const uint64_t next = value + (static_cast<uint64_t>(byte & 0x7F) << shift);
+            if (next > UINT32_MAX) return HpackError::IntegerOverflow;
+            value = static_cast<uint32_t>(next);
+            if ((byte & 0x80) == 0) return HpackError::None;
+        }
+        return HpackError::IntegerOverflow;
+    }
+
+    // Raw strings are returned as views into the block; Huffman strings are decoded into scratch
+    static HpackError readString(ByteView block, size_t& offset, std::vector<uint8_t>& scratch, std::string_view& text) {
+        if (offset >= block.size) return HpackError::Truncated;
+        const bool huffman = (block[offset] & 0x80) != 0;
+        uint32_t length = 0;
+        HpackError error = readInteger(block, offset, 7, length);
+        if (error != HpackError::None) return error;
+        if (length > block.size - offset) return HpackError::Truncated;
+
+        ByteView raw = block.subview(offset, length);
+        offset += length;
+        if (!huffman) {
+            text = raw.asText();
+            return HpackError::None;
+        }
+
+        scratch.clear();
+        if (!Huffman::decode(raw, scratch)) return HpackError::BadHuffman;
+        text = std::string_view(reinterpret_cast<const char*>(scratch.data()), scratch.size());
+        return HpackError::None;
+    }
+
+    HpackError lookup(uint32_t index, std::string_view& name, std::string_view& value) const {
+        if (index == 0) return HpackError::BadIndex;
+        if (index <= Hpack::STATIC_ENTRIES) {
+            name = Hpack::staticTable[index - 1].name;
+            value = Hpack::staticTable[index - 1].value;
+            return HpackError::None;
+        }
+        const size_t dynamicIndex = index - Hpack::STATIC_ENTRIES - 1;
+        if (dynamicIndex >= entryCount_) return HpackError::BadIndex;
+        const Entry& entry = dynamicEntry(dynamicIndex);
+        name = storageText(entry.offset, entry.nameLength);
+        value = storageText(entry.offset + entry.nameLength, entry.valueLength);
+        return HpackError::None;
+    }
+
+public:
+    // Limit announced in the peer's SETTINGS_HEADER_TABLE_SIZE, from the moment the encoder's
+    // side acknowledges that SETTINGS frame. The encoder confirms it with a size update, but a
+    // smaller limit binds it already.
+    void setAllowedTableSize(size_t size) {
+        allowedTableSize_ = size;
+        if (maxTableSize_ > size) {
+            maxTableSize_ = size;
+            evictTo(size);
+        }
+    }
+
+    size_t tableSize() const { return tableSize_; }
+    size_t maxTableSize() const { return maxTableSize_; }
+    size_t entryCount() const { return entryCount_; }
+
+    // Decodes one complete header block (HEADERS plus CONTINUATION fragments, padding removed).
+    // onField(std::string_view name, std::string_view value) gets views that are only valid
+    // during the call. On error the dynamic table is out of sync and the connection's
+    // remaining header blocks cannot be trusted.
+    template<typename FieldHandler>
+    HpackError decodeBlock(ByteView block, FieldHandler&& onField) {
+        size_t offset = 0;
+        bool fieldSeen = false;
+
+        while (offset < block.size) {
+            const uint8_t first = block[offset];
+            std::string_view name;
+            std::string_view value;
+            uint32_t index = 0;
+            HpackError error = HpackError::None;
+
+            if (first & 0x80) {
+                // Indexed header field
+                if ((error = readInteger(block, offset, 7, index)) != HpackError::None) return error;
+                if ((error = lookup(index, name, value)) != HpackError::None) return error;
+                onField(name, value);
+                fieldSeen = true;
+                continue;
+            }
+
+            if ((first & 0xE0) == 0x20) {
+                // Dynamic table size update, only allowed before the first field of a block
+                if (fieldSeen) return HpackError::BadTableSizeUpdate;
+                if ((error = readInteger(block, offset, 5, index)) != HpackError::None) return error;
+                if (index > allowedTableSize_) return HpackError::BadTableSizeUpdate;
+                maxTableSize_ = index;
+                evictTo(maxTableSize_);
+                continue;
+            }
+
+            // Literal: with incremental indexing (01), without indexing (0000) or never indexed (0001)
+            const bool indexing = (first & 0xC0) == 0x40;
+            if ((error = readInteger(block, offset, indexing ? 6 : 4, index)) != HpackError::None) return error;
+
+            if (index == 0) {
+                if ((error = readString(block, offset, nameScratch_, name)) != HpackError::None) return error;
+            } else {
+                std::string_view unused;
+                if ((error = lookup(index, name, unused)) != HpackError::None) return error;
+                if (indexing && index > Hpack::STATIC_ENTRIES) {
+                    // Inserting may evict or move the entry the name refers to
+                    nameScratch_.assign(name.begin(), name.end());
+                    name = std::string_view(reinterpret_cast<const char*>(nameScratch_.data()), nameScratch_.size());
+                }
+            }
+            if ((error = readString(block, offset, valueScratch_, value)) != HpackError::None) return error;
+
+            onField(name, value);
+            fieldSeen = true;
+            if (indexing) insert(name, value);
+        }
+        return HpackError::None;
+    }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
@@ -0,0 +1,317 @@
+// Http1Parser.hpp - HTTP/1.x request and response header parsing with a vectorized delimiter scan
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../core/ByteView.hpp"
+#include "../performance/CpuFeatures.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PA2026_HTTP1_AVX2 1
+#elif defined(PA2026_HAVE_SSE2)
+#include <emmintrin.h>
+#define PA2026_HTTP1_SSE2 1
+#endif
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::ByteView;
+
+enum class Http1ParseResult : uint8_t {
+    Ok,
+    Incomplete,         // The header block has not ended yet
+    Invalid
+};
+
+enum class Http1Body : uint8_t {
+    None,
+    Length,             // bodyLength bytes follow the header
+    Chunked,
+    UntilClose          // Response without framing, or a tunnel after CONNECT
+};
+
+// One parsed header block. Views point into the parsed buffer.
+struct Http1Message {
+    bool response = false;
+    uint8_t versionMinor = 1;
+    ByteView method;                // Requests
+    ByteView target;
+    uint16_t status = 0;            // Responses
+    ByteView host;
+    ByteView upgrade;
+    bool connectionClose = false;
+    Http1Body body = Http1Body::None;
+    uint64_t bodyLength = 0;
+    size_t headerLength = 0;        // Through the blank line that ends the header block
+};
+
+// Header blocks in the picohttpparser style: one vectorized scan per line finds the first
+// control byte, which ends the line or rejects it. Lines may end in CRLF or a bare LF.
+// Only the fields needed for framing and transaction metadata are kept; the rest of the
+// header block is validated and skipped without copies or allocation.
+class Http1Parser {
+private:
+    static constexpr size_t MAX_HEADERS = 128;
+
+    static bool isControl(uint8_t c) {
+        return (c < 0x20 && c != '\t') || c == 0x7F;
+    }
+
+    static bool equalsIgnoreCase(ByteView text, const char* lower, size_t length) {
+        if (text.size != length) return false;
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t c = text[i];
+            if (c >= 'A' && c <= 'Z') c = static_cast<uint8_t>(c + ('a' - 'A'));
+            if (c != static_cast<uint8_t>(lower[i])) return false;
+        }
+        return true;
+    }
+
+    static bool containsTokenIgnoreCase(ByteView list, const char* lower, size_t length) {
+        // Comma-separated values such as "keep-alive, Upgrade" or "gzip, chunked"
+        size_t start = 0;
+        while (start <= list.size) {
+            size_t end = start;
+            while (end < list.size && list[end] != ',') end++;
+            if (equalsIgnoreCase(trim(list.subview(start, end - start)), lower, length)) return true;
+            start = end + 1;
+        }
+        return false;
+    }
+
+    static ByteView trim(ByteView text) {
+        size_t begin = 0;
+        size_t end = text.size;
+        while (begin < end && (text[begin] == ' ' || text[begin] == '\t')) begin++;
+        while (end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t')) end--;
+        return text.subview(begin, end - begin);
+    }
+
+    // Reads one line from position; returns its length without the terminator, sets next to
+    // the following line, or returns SIZE_MAX with result set to Incomplete or Invalid
+    static size_t readLine(ByteView data, size_t position, size_t& next, Http1ParseResult& result) {
+        const size_t end = findControl(data.data, position, data.size);
+        if (end == data.size) {
+            result = Http1ParseResult::Incomplete;
+            return SIZE_MAX;
+        }
+        if (data[end] == '\n') {
+            next = end + 1;
+            return end - position;
+        }
+        if (data[end] != '\r') {
+            result = Http1ParseResult::Invalid;
+            return SIZE_MAX;
+        }
+        if (end + 1 == data.size) {
+            result = Http1ParseResult::Incomplete;
+            return SIZE_MAX;
+        }
+        if (data[end + 1] != '\n') {
+            result = Http1ParseResult::Invalid;
+            return SIZE_MAX;
+        }
+        next = end + 2;
+        return end - position;
+    }
+
+    // "HTTP/1.x", leaving the minor version
+    static bool parseVersion(ByteView text, uint8_t& minor) {
+        if (text.size != 8 || !text.startsWith("HTTP/1.") || text[7] < '0' || text[7] > '9') return false;
+        minor = static_cast<uint8_t>(text[7] - '0');
+        return true;
+    }
+
+    static bool parseDecimal(ByteView text, uint64_t& value) {
+        if (text.empty() || text.size > 19) return false;
+        value = 0;
+        for (uint8_t c : text) {
+            if (c < '0' || c > '9') return false;
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    }
+
+    static bool parseRequestLine(ByteView line, Http1Message& out) {
+        const uint8_t* firstSpace = static_cast<const uint8_t*>(std::memchr(line.data, ' ', line.size));
+        if (!firstSpace || firstSpace == line.data) return false;
+        const size_t methodLength = static_cast<size_t>(firstSpace - line.data);
+        const ByteView rest = line.subview(methodLength + 1);
+        const uint8_t* secondSpace = static_cast<const uint8_t*>(std::memchr(rest.data, ' ', rest.size));
+        if (!secondSpace || secondSpace == rest.data) return false;
+
+        out.method = line.subview(0, methodLength);
+        out.target = rest.subview(0, static_cast<size_t>(secondSpace - rest.data));
+        return parseVersion(rest.subview(out.target.size + 1), out.versionMinor);
+    }
+
+    static bool parseStatusLine(ByteView line, Http1Message& out) {
+        // "HTTP/1.1 200 OK"; the reason phrase may be empty or missing
+        if (line.size < 12 || !parseVersion(line.subview(0, 8), out.versionMinor) || line[8] != ' ') return false;
+        uint64_t status = 0;
+        if (!parseDecimal(line.subview(9, 3), status) || status < 100) return false;
+        if (line.size > 12 && line[12] != ' ') return false;
+        out.status = static_cast<uint16_t>(status);
+        return true;
+    }
+
+    static bool onHeader(ByteView line, Http1Message& out, bool& haveLength, bool& chunked) {
+        const uint8_t* colon = static_cast<const uint8_t*>(std::memchr(line.data, ':', line.size));
+        if (!colon || colon == line.data) return false;
+        const ByteView name = line.subview(0, static_cast<size_t>(colon - line.data));
+        const ByteView value = trim(line.subview(name.size + 1));
+
+        switch (name.size) {
+            case 4:
+                if (equalsIgnoreCase(name, "host", 4)) out.host = value;
+                break;
+            case 7:
+                if (equalsIgnoreCase(name, "upgrade", 7)) out.upgrade = value;
+                break;
+            case 10:
+                if (equalsIgnoreCase(name, "connection", 10)) {
+                    out.connectionClose = containsTokenIgnoreCase(value, "close", 5);
+                }
+                break;
+            case 14:
+                if (equalsIgnoreCase(name, "content-length", 14)) {
+                    uint64_t length = 0;
+                    // Differing repeated lengths are a smuggling vector (RFC 9112 6.3)
+                    if (!parseDecimal(value, length) || (haveLength && length != out.bodyLength)) return false;
+                    out.bodyLength = length;
+                    haveLength = true;
+                }
+                break;
+            case 17:
+                if (equalsIgnoreCase(name, "transfer-encoding", 17)) {
+                    chunked = containsTokenIgnoreCase(value, "chunked", 7);
+                }
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+public:
+    // Offset of the first control byte other than tab at or after from, or size if none
+    static size_t findControl(const uint8_t* data, size_t from, size_t size) {
+        size_t i = from;
+#if defined(PA2026_HTTP1_AVX2)
+        const __m256i limit = _mm256_set1_epi8(0x1F);
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i del = _mm256_set1_epi8(0x7F);
+        for (; i + 32 <= size; i += 32) {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, limit), limit);
+            const __m256i stop = _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(bytes, tab), control),
+                                                 _mm256_cmpeq_epi8(bytes, del));
+            const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(stop));
+            if (mask != 0) return i + static_cast<size_t>(Performance::countTrailingZeros(mask));
+        }
+#elif defined(PA2026_HTTP1_SSE2)
+        const __m128i limit = _mm_set1_epi8(0x1F);
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i del = _mm_set1_epi8(0x7F);
+        for (; i + 16 <= size; i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(bytes, limit), limit);
+            const __m128i stop = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(bytes, tab), control),
+                                              _mm_cmpeq_epi8(bytes, del));
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(stop));
+            if (mask != 0) return i + static_cast<size_t>(Performance::countTrailingZeros(mask));
+        }
+#endif
+        for (; i < size; ++i) {
+            if (isControl(data[i])) return i;
+        }
+        return size;
+    }
+
+    // Parses a request or response header block from the start of data. Body framing follows
+    // RFC 9112 6.3 as far as the message alone decides it: a response to HEAD or a successful
+    // CONNECT has no body either, which only the caller pairing it with its request knows.
+    static Http1ParseResult parse(ByteView data, Http1Message& out) {
+        out = Http1Message{};
+        Http1ParseResult result = Http1ParseResult::Ok;
+        size_t next = 0;
+
+        const size_t firstLength = readLine(data, 0, next, result);
+        if (firstLength == SIZE_MAX) return result;
+        const ByteView first = data.subview(0, firstLength);
+        out.response = first.startsWith("HTTP/");
+        if (!(out.response ? parseStatusLine(first, out) : parseRequestLine(first, out))) {
+            return Http1ParseResult::Invalid;
+        }
+
+        bool haveLength = false;
+        bool chunked = false;
+        for (size_t headers = 0;; ++headers) {
+            const size_t position = next;
+            const size_t length = readLine(data, position, next, result);
+            if (length == SIZE_MAX) return result;
+            if (length == 0) break;
+            if (headers == MAX_HEADERS || data[position] == ' ' || data[position] == '\t') {
+                return Http1ParseResult::Invalid;       // Too many headers, or obsolete line folding
+            }
+            if (!onHeader(data.subview(position, length), out, haveLength, chunked)) return Http1ParseResult::Invalid;
+        }
+        out.headerLength = next;
+
+        if (out.response && (out.status < 200 || out.status == 204 || out.status == 304)) {
+            out.body = Http1Body::None;
+        } else if (chunked) {
+            out.body = Http1Body::Chunked;          // Takes precedence over Content-Length
+            out.bodyLength = 0;
+        } else if (haveLength) {
+            out.body = out.bodyLength > 0 ? Http1Body::Length : Http1Body::None;
+        } else {
+            // Requests without framing have no body; responses run until the connection closes
+            out.body = out.response ? Http1Body::UntilClose : Http1Body::None;
+        }
+        return Http1ParseResult::Ok;
+    }
+
+    // Chunk-size line of a chunked body: hex size, optional extensions. Returns the line length
+    // including its terminator, 0 while incomplete, SIZE_MAX when invalid.
+    static size_t parseChunkSize(ByteView data, uint64_t& size) {
+        Http1ParseResult result = Http1ParseResult::Ok;
+        size_t next = 0;
+        const size_t length = readLine(data, 0, next, result);
+        if (length == SIZE_MAX) return result == Http1ParseResult::Incomplete ? 0 : SIZE_MAX;
+
+        size = 0;
+        size_t digits = 0;
+        for (; digits < length; ++digits) {
+            const uint8_t c = data[digits];
+            uint8_t value;
+            if (c >= '0' && c <= '9') value = static_cast<uint8_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value = static_cast<uint8_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value = static_cast<uint8_t>(c - 'A' + 10);
+            else break;
+            if (digits == 15) return SIZE_MAX;
+            size = (size << 4) | value;
+        }
+        if (digits == 0 || (digits < length && data[digits] != ';' && data[digits] != ' ' && data[digits] != '\t')) {
+            return SIZE_MAX;
+        }
+        return next;
+    }
+
+    // Trailer section after the last chunk, up to and including its blank line. Same return
+    // convention as parseChunkSize.
+    static size_t skipTrailers(ByteView data) {
+        Http1ParseResult result = Http1ParseResult::Ok;
+        size_t next = 0;
+        while (true) {
+            const size_t length = readLine(data, next, next, result);
+            if (length == SIZE_MAX) return result == Http1ParseResult::Incomplete ? 0 : SIZE_MAX;
+            if (length == 0) return next;
+        }
+    }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
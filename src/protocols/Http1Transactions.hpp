@@ -0,0 +1,425 @@
+// Http1Transactions.hpp - Pairs HTTP/1.x requests with responses for per-endpoint server response time
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/FlowKey.hpp"
+#include "../core/LatencyHistogram.hpp"
+#include "../core/TcpReassembler.hpp"
+#include "Http1Parser.hpp"
+#include "Http2Session.hpp"
+#include "StreamParsers.hpp"
+#include "WebSocketMessages.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::FlowKey;
+using Core::FlowKeyHash;
+using Core::StreamContext;
+
+// Requests are grouped by method, host and path. The query string is dropped and path
+// segments that look like identifiers (all digits, or 16+ hex digits) become "{id}", so
+// /users/1234?x=1 and /users/5678 are one endpoint.
+struct Http1EndpointStats {
+    std::string method;
+    std::string host;
+    std::string path;
+    uint64_t requests = 0;
+    uint64_t responses = 0;
+    uint64_t unanswered = 0;            // Still pending when the connection closed
+    uint64_t statusClasses[6] = {};     // Indexed by status / 100; 0 for anything outside 1xx-5xx
+    Core::LatencyHistogram latency;     // Request header to response header
+};
+
+struct Http1TransactionStatistics {
+    uint64_t requests = 0;
+    uint64_t responses = 0;
+    uint64_t matched = 0;
+    uint64_t unmatched = 0;             // Responses with no request pending on the connection
+    uint64_t pipelineOverflows = 0;     // Oldest pending request dropped for a new one
+    uint64_t untrackedEndpoints = 0;    // Requests past the endpoint limit, timed but not rolled up
+    uint64_t rejectedConnections = 0;
+};
+
+// Sink adapter for ApplicationStreamHandler that matches every HTTP/1.x response to the
+// oldest outstanding request on its connection (pipelined requests are answered in order,
+// RFC 9112 9.3.2) and records the server response time per endpoint. Everything is
+// forwarded to Sink, which additionally receives
+//
+//   void onHttp1Transaction(const StreamContext&, const Http1EndpointStats&, uint64_t latencyNs, uint16_t status)
+//
+// Responses to HEAD are marked bodiless and successful CONNECTs as tunnels, so the stream
+// handler frames them correctly. Interim 1xx responses other than 101 leave the request
+// pending. Single-threaded like the reassembler that drives it.
+template<typename Sink>
+class Http1TransactionTracker {
+private:
+    static constexpr size_t MAX_PIPELINE = 16;
+    static constexpr size_t MAX_PATH = 255;
+    static constexpr uint32_t NO_ENDPOINT = UINT32_MAX;
+
+    struct Pending {
+        uint64_t sentNs;
+        uint32_t endpoint;
+        bool head;
+        bool connect;
+    };
+
+    struct Connection {
+        Pending pending[MAX_PIPELINE];
+        uint8_t first = 0;
+        uint8_t count = 0;
+        uint8_t clientDirection = 0;        // Of the first request
+    };
+
+    Sink& sink_;
+    size_t maxConnections_;
+    size_t maxEndpoints_;
+    std::unordered_map<FlowKey, Connection, FlowKeyHash> connections_;
+    std::unordered_map<uint64_t, uint32_t> endpointIndex_;
+    std::vector<Http1EndpointStats> endpoints_;
+    Http1EndpointStats untracked_;
+    Http1TransactionStatistics stats_;
+
+    static bool isIdentifier(const char* segment, size_t length) {
+        if (length == 0) return false;
+        bool digits = true;
+        bool hex = true;
+        for (size_t i = 0; i < length; ++i) {
+            const char c = segment[i];
+            const bool digit = c >= '0' && c <= '9';
+            digits = digits && digit;
+            hex = hex && (digit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F') || c == '-');
+        }
+        return digits || (hex && length >= 16);
+    }
+
+    // Origin-form path of the request target without query and with identifiers collapsed;
+    // absolute-form targets (proxies) also yield their authority when Host is missing
+    static size_t normalizePath(ByteView target, char (&out)[MAX_PATH + 1], ByteView& authority) {
+        if (target.startsWith("http://") || target.startsWith("https://")) {
+            const size_t start = target.find("://") + 3;
+            const ByteView rest = target.subview(start);
+            size_t slash = 0;
+            while (slash < rest.size && rest[slash] != '/' && rest[slash] != '?') slash++;
+            authority = rest.subview(0, slash);
+            target = rest.subview(slash);
+        }
+
+        size_t written = 0;
+        size_t position = 0;
+        while (position < target.size && target[position] != '?' && target[position] != '#') {
+            size_t end = position + 1;
+            while (end < target.size && target[end] != '/' && target[end] != '?' && target[end] != '#') end++;
+            // Segment including its leading slash, if any
+            const size_t skip = target[position] == '/' ? 1 : 0;
+            const char* segment = reinterpret_cast<const char*>(target.data + position + skip);
+            const size_t length = end - position - skip;
+            const char* text = isIdentifier(segment, length) ? "{id}" : segment;
+            const size_t textLength = text == segment ? length : 4;
+
+            if (written + skip + textLength > MAX_PATH) break;
+            if (skip) out[written++] = '/';
+            std::memcpy(out + written, text, textLength);
+            written += textLength;
+            position = end;
+        }
+        if (written == 0) out[written++] = target.startsWith("*") ? '*' : '/';
+        out[written] = '\0';
+        return written;
+    }
+
+    static uint64_t hashText(uint64_t hash, const char* text, size_t length, bool fold) {
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t c = static_cast<uint8_t>(text[i]);
+            if (fold && c >= 'A' && c <= 'Z') c = static_cast<uint8_t>(c + ('a' - 'A'));
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        return (hash ^ 0xFF) * 1099511628211ull;        // Separator, so fields cannot run together
+    }
+
+    static bool sameText(const std::string& stored, const char* text, size_t length, bool fold) {
+        if (stored.size() != length) return false;
+        for (size_t i = 0; i < length; ++i) {
+            char c = text[i];
+            if (fold && c >= 'A' && c <= 'Z') c = static_cast<char>(c + ('a' - 'A'));
+            if (stored[i] != c) return false;
+        }
+        return true;
+    }
+
+    // Allocates only the first time an endpoint is seen
+    uint32_t endpointOf(const Http1Message& request) {
+        char path[MAX_PATH + 1];
+        ByteView authority;
+        const size_t pathLength = normalizePath(request.target, path, authority);
+        ByteView host = request.host.empty() ? authority : request.host;
+        host = host.subview(0, 253 + 6);                // Name plus ":port"
+
+        const char* method = reinterpret_cast<const char*>(request.method.data);
+        const char* hostText = reinterpret_cast<const char*>(host.data);
+        uint64_t hash = 1469598103934665603ull;
+        hash = hashText(hash, method, request.method.size, false);
+        hash = hashText(hash, hostText, host.size, true);
+        hash = hashText(hash, path, pathLength, false);
+
+        auto it = endpointIndex_.find(hash);
+        if (it != endpointIndex_.end()) {
+            const Http1EndpointStats& known = endpoints_[it->second];
+            const bool same = sameText(known.method, method, request.method.size, false) &&
+                              sameText(known.host, hostText, host.size, true) &&
+                              sameText(known.path, path, pathLength, false);
+            return same ? it->second : NO_ENDPOINT;
+        }
+        if (endpoints_.size() >= maxEndpoints_) return NO_ENDPOINT;
+
+        Http1EndpointStats endpoint;
+        endpoint.method.assign(method, request.method.size);
+        endpoint.host.assign(hostText, host.size);
+        std::transform(endpoint.host.begin(), endpoint.host.end(), endpoint.host.begin(),
+                       [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c; });
+        endpoint.path.assign(path, pathLength);
+
+        const uint32_t index = static_cast<uint32_t>(endpoints_.size());
+        endpoints_.push_back(std::move(endpoint));
+        endpointIndex_.emplace(hash, index);
+        return index;
+    }
+
+    Http1EndpointStats& endpoint(uint32_t index) {
+        return index == NO_ENDPOINT ? untracked_ : endpoints_[index];
+    }
+
+    void onRequest(const StreamContext& ctx, const Http1Message& request) {
+        stats_.requests++;
+        auto it = connections_.find(ctx.key);
+        if (it == connections_.end()) {
+            if (connections_.size() >= maxConnections_) {
+                stats_.rejectedConnections++;
+                return;
+            }
+            it = connections_.emplace(ctx.key, Connection{}).first;
+            it->second.clientDirection = ctx.direction;
+        }
+        Connection& connection = it->second;
+
+        const uint32_t index = endpointOf(request);
+        if (index == NO_ENDPOINT) stats_.untrackedEndpoints++;
+        endpoint(index).requests++;
+
+        if (connection.count == MAX_PIPELINE) {
+            stats_.pipelineOverflows++;
+            endpoint(connection.pending[connection.first].endpoint).unanswered++;
+            connection.first = static_cast<uint8_t>((connection.first + 1) % MAX_PIPELINE);
+            connection.count--;
+        }
+        Pending& pending = connection.pending[(connection.first + connection.count) % MAX_PIPELINE];
+        pending.sentNs = ctx.timestampNs;
+        pending.endpoint = index;
+        pending.head = request.method.size == 4 && std::memcmp(request.method.data, "HEAD", 4) == 0;
+        pending.connect = request.method.size == 7 && std::memcmp(request.method.data, "CONNECT", 7) == 0;
+        connection.count++;
+    }
+
+    void onResponse(const StreamContext& ctx, Http1Message& response) {
+        stats_.responses++;
+        auto it = connections_.find(ctx.key);
+        if (it == connections_.end() || it->second.count == 0 || it->second.clientDirection == ctx.direction) {
+            stats_.unmatched++;
+            return;
+        }
+        if (response.status < 200 && response.status != 101) return;
+
+        Connection& connection = it->second;
+        const Pending pending = connection.pending[connection.first];
+        connection.first = static_cast<uint8_t>((connection.first + 1) % MAX_PIPELINE);
+        connection.count--;
+
+        if (pending.head) {
+            response.body = Http1Body::None;
+        } else if (pending.connect && response.status < 300) {
+            response.body = Http1Body::UntilClose;
+        }
+
+        const uint64_t latencyNs = ctx.timestampNs > pending.sentNs ? ctx.timestampNs - pending.sentNs : 0;
+        Http1EndpointStats& stats = endpoint(pending.endpoint);
+        stats.responses++;
+        stats.statusClasses[response.status < 600 ? response.status / 100 : 0]++;
+        stats.latency.record(latencyNs);
+        stats_.matched++;
+        sink_.onHttp1Transaction(ctx, stats, latencyNs, response.status);
+    }
+
+public:
+    explicit Http1TransactionTracker(Sink& sink, size_t maxConnections = 1u << 16, size_t maxEndpoints = 4096)
+        : sink_(sink)
+        , maxConnections_(maxConnections)
+        , maxEndpoints_(maxEndpoints)
+    {
+        untracked_.method = "*";
+        untracked_.path = "*";
+    }
+
+    void onHttp1Message(const StreamContext& ctx, Http1Message& message) {
+        if (message.response) {
+            onResponse(ctx, message);
+        } else {
+            onRequest(ctx, message);
+        }
+        sink_.onHttp1Message(ctx, message);
+    }
+
+    void onHttp2Frame(const StreamContext& ctx, const HTTP2Frame& frame) {
+        sink_.onHttp2Frame(ctx, frame);
+    }
+
+    void onWebSocketFrame(const StreamContext& ctx, const WebSocketFrame& frame) {
+        sink_.onWebSocketFrame(ctx, frame);
+    }
+
+    void onWebSocketPayload(const StreamContext& ctx, ByteView piece, uint64_t remaining) {
+        sink_.onWebSocketPayload(ctx, piece, remaining);
+    }
+
+    void onStreamClosed(const FlowKey& key) {
+        auto it = connections_.find(key);
+        if (it != connections_.end()) {
+            const Connection& connection = it->second;
+            for (uint8_t i = 0; i < connection.count; ++i) {
+                endpoint(connection.pending[(connection.first + i) % MAX_PIPELINE].endpoint).unanswered++;
+            }
+            connections_.erase(it);
+        }
+        sink_.onStreamClosed(key);
+    }
+
+    void clear() {
+        connections_.clear();
+        endpointIndex_.clear();
+        endpoints_.clear();
+        untracked_ = Http1EndpointStats{};
+        untracked_.method = "*";
+        untracked_.path = "*";
+        stats_ = Http1TransactionStatistics{};
+    }
+
+    const std::vector<Http1EndpointStats>& endpoints() const { return endpoints_; }
+    const Http1EndpointStats& untracked() const { return untracked_; }
+    const Http1TransactionStatistics& statistics() const { return stats_; }
+    size_t connectionCount() const { return connections_.size(); }
+};
+
+// Terminal sink for adapter chains whose results are read from the adapters themselves
+struct DiscardingStreamSink {
+    template<typename Message>
+    void onHttp1Message(const StreamContext&, Message&) {}
+    template<typename Endpoint>
+    void onHttp1Transaction(const StreamContext&, const Endpoint&, uint64_t, uint16_t) {}
+    void onHttp2Frame(const StreamContext&, const HTTP2Frame&) {}
+    template<typename Headers>
+    void onHttp2Headers(const StreamContext&, const Headers&) {}
+    void onWebSocketFrame(const StreamContext&, const WebSocketFrame&) {}
+    void onWebSocketPayload(const StreamContext&, ByteView, uint64_t) {}
+    template<typename Message>
+    void onWebSocketMessage(const StreamContext&, const Message&) {}
+    void onStreamClosed(const FlowKey&) {}
+};
+
+struct StreamActivityStatistics {
+    uint64_t webSocketMessages = 0;
+    uint64_t webSocketBytes = 0;            // Unmasked payload of those messages
+    uint64_t truncatedWebSocketMessages = 0;
+    uint64_t webSocketControlFrames = 0;
+    uint64_t http2HeaderBlocks = 0;
+    uint64_t grpcHeaderBlocks = 0;          // By the decoded content-type
+};
+
+// Terminal sink that counts the messages the adapters in front of it assemble
+class StreamActivityCounter : public DiscardingStreamSink {
+private:
+    StreamActivityStatistics stats_;
+
+public:
+    void onWebSocketMessage(const StreamContext&, const WebSocketMessage& message) {
+        if (message.opcode >= WS_CLOSE) {
+            stats_.webSocketControlFrames++;
+            return;
+        }
+        stats_.webSocketMessages++;
+        stats_.webSocketBytes += message.payload.size;
+        if (message.truncated) stats_.truncatedWebSocketMessages++;
+    }
+
+    void onHttp2Headers(const StreamContext&, const Http2StreamHeaders& headers) {
+        stats_.http2HeaderBlocks++;
+        if (headers.grpc) stats_.grpcHeaderBlocks++;
+    }
+
+    void clear() { stats_ = StreamActivityStatistics{}; }
+
+    const StreamActivityStatistics& statistics() const { return stats_; }
+};
+
+// Reassembly, stream framing, transaction matching, HTTP/2 header decoding and WebSocket
+// message assembly for one capture worker: feed it the TCP segments of HTTP and HTTP/2
+// flows and read the endpoint table
+class Http1LatencyMonitor {
+private:
+    using Messages = WebSocketMessageTracker<StreamActivityCounter>;
+    using Headers = Http2HeaderTracker<Messages>;
+    using Tracker = Http1TransactionTracker<Headers>;
+    using Handler = ApplicationStreamHandler<Tracker>;
+
+    static constexpr uint64_t EXPIRY_INTERVAL_NS = 1000000000ull;
+
+    StreamActivityCounter activity_;
+    Messages messages_;
+    Headers headers_;
+    Tracker transactions_;
+    Handler streams_;
+    Core::TcpReassembler<Handler> reassembler_;
+    uint64_t lastExpiryNs_ = 0;
+
+public:
+    static Core::ReassemblyConfig defaultConfig() {
+        Core::ReassemblyConfig config;
+        config.bufferBudget = 32u << 20;            // Only headers and the odd out-of-order segment are held
+        config.maxStreamBuffer = 64u << 10;
+        config.maxFlows = 1u << 18;
+        return config;
+    }
+
+    explicit Http1LatencyMonitor(const Core::ReassemblyConfig& config = defaultConfig())
+        : messages_(activity_)
+        , headers_(messages_)
+        , transactions_(headers_)
+        , streams_(transactions_)
+        , reassembler_(streams_, config) {}
+
+    void onSegment(const Core::TcpSegment& segment) { reassembler_.process(segment); }
+
+    // Closes idle connections, counting their open requests as unanswered; at most once a second
+    void expire(uint64_t nowNs) {
+        if (nowNs < lastExpiryNs_ + EXPIRY_INTERVAL_NS) return;
+        lastExpiryNs_ = nowNs;
+        reassembler_.expireIdle(nowNs);
+    }
+
+    void clear() {
+        reassembler_.clear();
+        transactions_.clear();
+        activity_.clear();
+        lastExpiryNs_ = 0;
+    }
+
+    const Tracker& transactions() const { return transactions_; }
+    const StreamActivityStatistics& activity() const { return activity_.statistics(); }
+    Core::ReassemblyStatistics reassembly() const { return reassembler_.statistics(); }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
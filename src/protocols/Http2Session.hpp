@@ -0,0 +1,274 @@
+// Http2Session.hpp - Per-connection HTTP/2 header state: HPACK tables and per-stream request/response fields
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/TcpReassembler.hpp"
+#include "HpackDecoder.hpp"
+#include "ModernProtocolParser.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::FlowKey;
+using Core::FlowKeyHash;
+using Core::StreamContext;
+
+struct Http2StreamHeaders {
+    uint32_t streamId = 0;
+    std::string method;
+    std::string path;
+    std::string authority;
+    std::string contentType;
+    uint16_t status = 0;
+    bool grpc = false;
+    uint8_t endStream = 0;          // Bit per direction that has sent END_STREAM
+};
+
+// Both directions of one HTTP/2 connection. Header blocks are reassembled from HEADERS,
+// PUSH_PROMISE and CONTINUATION frames and decoded in order, which keeps the dynamic tables
+// in sync; fields that are not tracked are decoded and dropped without allocating.
+class Http2Connection {
+private:
+    enum FrameType : uint8_t {
+        FRAME_DATA = 0x0,
+        FRAME_HEADERS = 0x1,
+        FRAME_RST_STREAM = 0x3,
+        FRAME_SETTINGS = 0x4,
+        FRAME_PUSH_PROMISE = 0x5,
+        FRAME_CONTINUATION = 0x9
+    };
+
+    enum FrameFlags : uint8_t {
+        FLAG_END_STREAM = 0x01,
+        FLAG_ACK = 0x01,
+        FLAG_END_HEADERS = 0x04,
+        FLAG_PADDED = 0x08,
+        FLAG_PRIORITY = 0x20
+    };
+
+    static constexpr uint16_t SETTINGS_HEADER_TABLE_SIZE = 0x1;
+    static constexpr size_t MAX_HEADER_BLOCK = 256u << 10;
+    static constexpr size_t MAX_OPEN_STREAMS = 1024;
+    static constexpr size_t MAX_UNACKED_SETTINGS = 8;
+    static constexpr int64_t NO_TABLE_SIZE = -1;
+
+    HpackDecoder decoders_[2];
+    std::vector<uint8_t> pendingBlock_[2];      // Fragments waiting for END_HEADERS
+    uint32_t pendingStream_[2] = { 0, 0 };
+    bool pendingEndStream_[2] = { false, false };
+    bool failed_[2] = { false, false };
+    std::deque<int64_t> unackedTableSize_[2];   // Per SETTINGS frame sent, oldest first; NO_TABLE_SIZE if absent
+    std::unordered_map<uint32_t, Http2StreamHeaders> streams_;
+
+    static uint32_t read32(ByteView data) {
+        return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+    }
+
+    // Header block fragment of a HEADERS or PUSH_PROMISE frame, without padding and prefix fields
+    static bool fragment(const HTTP2Frame& frame, ByteView& out) {
+        ByteView payload = frame.payload;
+        size_t padding = 0;
+        if (frame.flags & FLAG_PADDED) {
+            if (payload.empty()) return false;
+            padding = payload[0];
+            payload = payload.subview(1);
+        }
+        size_t prefix = 0;
+        if (frame.type == FRAME_HEADERS && (frame.flags & FLAG_PRIORITY)) prefix = 5;
+        if (frame.type == FRAME_PUSH_PROMISE) prefix = 4;
+        if (payload.size < prefix + padding) return false;
+        out = payload.subview(prefix, payload.size - prefix - padding);
+        return true;
+    }
+
+    void recordField(Http2StreamHeaders& stream, std::string_view name, std::string_view value) {
+        if (name.empty()) return;
+        if (name[0] == ':') {
+            if (name == ":path") stream.path.assign(value);
+            else if (name == ":method") stream.method.assign(value);
+            else if (name == ":authority") stream.authority.assign(value);
+            else if (name == ":status" && value.size() == 3) {
+                stream.status = static_cast<uint16_t>((value[0] - '0') * 100 + (value[1] - '0') * 10 + (value[2] - '0'));
+            }
+        } else if (name == "content-type") {
+            stream.contentType.assign(value);
+            stream.grpc = value.substr(0, 16) == "application/grpc";
+        }
+    }
+
+    const Http2StreamHeaders* decodePending(uint8_t direction, ByteView block) {
+        const uint32_t streamId = pendingStream_[direction];
+        if (streams_.size() >= MAX_OPEN_STREAMS && streams_.find(streamId) == streams_.end()) {
+            // Streams whose END_STREAM was never seen; drop them rather than grow without bound
+            streams_.clear();
+        }
+        Http2StreamHeaders& stream = streams_[streamId];
+        stream.streamId = streamId;
+
+        HpackError error = decoders_[direction].decodeBlock(block, [&](std::string_view name, std::string_view value) {
+            recordField(stream, name, value);
+        });
+        if (error != HpackError::None) {
+            failed_[direction] = true;
+            if (ModernProtocolParser::traceEnabled()) {
+                std::cout << "⚠️ HPACK decoding failed on stream " << streamId
+                          << " (error " << static_cast<int>(error) << ")" << std::endl;
+            }
+            return nullptr;
+        }
+
+        if (pendingEndStream_[direction]) stream.endStream |= static_cast<uint8_t>(1 << direction);
+        return &stream;
+    }
+
+    void endStream(uint8_t direction, uint32_t streamId) {
+        auto it = streams_.find(streamId);
+        if (it == streams_.end()) return;
+        it->second.endStream |= static_cast<uint8_t>(1 << direction);
+        if (it->second.endStream == 0x3) streams_.erase(it);
+    }
+
+public:
+    // Returns the stream whose header block this frame completed, or nullptr. The pointer is
+    // valid until the next call.
+    const Http2StreamHeaders* onFrame(uint8_t direction, const HTTP2Frame& frame) {
+        direction &= 1;
+
+        switch (frame.type) {
+            case FRAME_HEADERS:
+            case FRAME_PUSH_PROMISE: {
+                if (failed_[direction]) return nullptr;
+                ByteView block;
+                if (!fragment(frame, block)) {
+                    failed_[direction] = true;
+                    return nullptr;
+                }
+                pendingStream_[direction] = frame.type == FRAME_PUSH_PROMISE && frame.payload.size >= 4
+                    ? read32(frame.payload.subview((frame.flags & FLAG_PADDED) ? 1 : 0)) & 0x7FFFFFFF
+                    : frame.streamId;
+                pendingEndStream_[direction] = frame.type == FRAME_HEADERS && (frame.flags & FLAG_END_STREAM);
+
+                if (frame.flags & FLAG_END_HEADERS) {
+                    // Common case: the whole block is in this frame, decode it in place
+                    pendingBlock_[direction].clear();
+                    return decodePending(direction, block);
+                }
+                pendingBlock_[direction].assign(block.begin(), block.end());
+                return nullptr;
+            }
+
+            case FRAME_CONTINUATION: {
+                if (failed_[direction]) return nullptr;
+                std::vector<uint8_t>& pending = pendingBlock_[direction];
+                if (pending.size() + frame.payload.size > MAX_HEADER_BLOCK) {
+                    failed_[direction] = true;
+                    return nullptr;
+                }
+                pending.insert(pending.end(), frame.payload.begin(), frame.payload.end());
+                if (!(frame.flags & FLAG_END_HEADERS)) return nullptr;
+
+                const Http2StreamHeaders* stream = decodePending(direction, ByteView(pending.data(), pending.size()));
+                pending.clear();
+                return stream;
+            }
+
+            case FRAME_DATA:
+                if (frame.flags & FLAG_END_STREAM) endStream(direction, frame.streamId);
+                return nullptr;
+
+            case FRAME_RST_STREAM:
+                streams_.erase(frame.streamId);
+                return nullptr;
+
+            case FRAME_SETTINGS: {
+                if (frame.flags & FLAG_ACK) {
+                    // Acknowledges the peer's oldest outstanding SETTINGS (RFC 9113 6.5.3); only now
+                    // does its header table limit bind the encoder of this direction
+                    std::deque<int64_t>& unacked = unackedTableSize_[direction ^ 1];
+                    if (unacked.empty()) return nullptr;     // Sent before the capture started
+                    if (unacked.front() != NO_TABLE_SIZE) {
+                        decoders_[direction].setAllowedTableSize(static_cast<size_t>(unacked.front()));
+                    }
+                    unacked.pop_front();
+                    return nullptr;
+                }
+                int64_t tableSize = NO_TABLE_SIZE;
+                for (size_t offset = 0; offset + 6 <= frame.payload.size; offset += 6) {
+                    ByteView setting = frame.payload.subview(offset, 6);
+                    if (((setting[0] << 8) | setting[1]) == SETTINGS_HEADER_TABLE_SIZE) {
+                        tableSize = read32(setting.subview(2));
+                    }
+                }
+                std::deque<int64_t>& unacked = unackedTableSize_[direction];
+                if (unacked.size() == MAX_UNACKED_SETTINGS) unacked.pop_front();
+                unacked.push_back(tableSize);
+                return nullptr;
+            }
+
+            default:
+                return nullptr;
+        }
+    }
+
+    // A decoding error leaves that direction's dynamic table unusable for the rest of the connection
+    bool failed(uint8_t direction) const { return failed_[direction & 1]; }
+    size_t openStreams() const { return streams_.size(); }
+    const HpackDecoder& decoder(uint8_t direction) const { return decoders_[direction & 1]; }
+};
+
+// Sink adapter for ApplicationStreamHandler that decodes HTTP/2 headers per connection and
+// forwards everything to Sink, which additionally receives
+//
+//   void onHttp2Headers(const StreamContext&, const Http2StreamHeaders&)
+//
+// once per completed header block. Streams carrying gRPC are relabelled ProtocolId::GRPC.
+template<typename Sink>
+class Http2HeaderTracker {
+private:
+    Sink& sink_;
+    std::unordered_map<FlowKey, Http2Connection, FlowKeyHash> connections_;
+
+public:
+    explicit Http2HeaderTracker(Sink& sink) : sink_(sink) {}
+
+    void onHttp2Frame(const StreamContext& ctx, const HTTP2Frame& frame) {
+        Http2Connection& connection = connections_[ctx.key];
+        if (const Http2StreamHeaders* headers = connection.onFrame(ctx.direction, frame)) {
+            if (headers->grpc) ctx.protocol = static_cast<uint8_t>(ProtocolId::GRPC);
+            sink_.onHttp2Headers(ctx, *headers);
+        }
+        sink_.onHttp2Frame(ctx, frame);
+    }
+
+    void onWebSocketFrame(const StreamContext& ctx, const WebSocketFrame& frame) {
+        sink_.onWebSocketFrame(ctx, frame);
+    }
+
+    void onWebSocketPayload(const StreamContext& ctx, ByteView piece, uint64_t remaining) {
+        sink_.onWebSocketPayload(ctx, piece, remaining);
+    }
+
+    template<typename Message>
+    void onHttp1Message(const StreamContext& ctx, Message& message) {
+        sink_.onHttp1Message(ctx, message);
+    }
+
+    template<typename Endpoint>
+    void onHttp1Transaction(const StreamContext& ctx, const Endpoint& endpoint, uint64_t latencyNs, uint16_t status) {
+        sink_.onHttp1Transaction(ctx, endpoint, latencyNs, status);
+    }
+
+    void onStreamClosed(const FlowKey& key) {
+        connections_.erase(key);
+        sink_.onStreamClosed(key);
+    }
+
+    size_t connectionCount() const { return connections_.size(); }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
@@ -1,136 +1,152 @@
 // ModernProtocolParser.hpp - Parse modern protocols (HTTP/2, QUIC, WebSocket)
 #pragma once
 
+#include <atomic>
 #include <cstdint>
-#include <string>
-#include <vector>
+#include <string_view>
 #include <iostream>
 
+#include "../core/ByteView.hpp"
+#include "DissectorRegistry.hpp"
+
 namespace PacketAnalyzer2026::Protocols {
 
+using Core::ByteView;
+
+// Parsed frames are views into the buffer that was parsed; nothing is copied or allocated.
+// Payload views are clamped to the bytes actually available, so complete tells whether
+// the whole frame was present or it continues in a later segment.
+
 struct HTTP2Frame {
+    bool valid;
+    bool complete;
     uint32_t length;
     uint8_t type;
     uint8_t flags;
     uint32_t streamId;
-    std::vector<uint8_t> payload;
+    ByteView payload;
 };
 
 struct QUICPacket {
-    uint32_t version;
+    bool valid;
     bool isLongHeader;
+    uint32_t version;
     uint8_t packetType;
-    std::vector<uint8_t> payload;
+    ByteView destConnectionId;      // Empty for short headers, the length is connection state
+    ByteView sourceConnectionId;
+    ByteView payload;
 };
 
 struct WebSocketFrame {
+    bool valid;
+    bool complete;
     bool fin;
     uint8_t opcode;
     bool masked;
+    uint8_t maskingKey[4];
     uint64_t payloadLength;
-    std::vector<uint8_t> payload;
+    size_t headerLength;
+    ByteView payload;               // Still masked when masked is set
 };
 
 class ModernProtocolParser {
 public:
-    static std::string detectModernProtocol(const uint8_t* data, size_t size, uint16_t port) {
-        if (!data || size < 4) return "Unknown";
-
-        // HTTP/2 detection (port 80/443 with HTTP/2 magic)
-        if ((port == 80 || port == 443) && size >= 24) {
-            // HTTP/2 connection preface: "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
-            const char* http2_preface = "PRI * HTTP/2.0";
-            if (std::memcmp(data, http2_preface, 14) == 0) {
-                return "HTTP/2";
-            }
-            
-            // HTTP/2 frame format detection
-            if (isHTTP2Frame(data, size)) {
-                return "HTTP/2";
-            }
-        }
+    // Per-frame logging for debugging dissectors; off by default, one relaxed load per call when off
+    static void setTraceEnabled(bool enabled) {
+        trace_.store(enabled, std::memory_order_relaxed);
+    }
 
-        // QUIC detection (UDP, specific patterns)
-        if (port == 443 || port == 80) {
-            if (isQUICPacket(data, size)) {
-                return "QUIC";
-            }
-        }
+    static bool traceEnabled() {
+        return trace_.load(std::memory_order_relaxed);
+    }
 
-        // WebSocket detection (after HTTP upgrade)
-        if ((port == 80 || port == 443) && isWebSocketFrame(data, size)) {
-            return "WebSocket";
-        }
+    // Label lookup through the dissector registry; classifiers should use DissectorRegistry::classify
+    // directly and keep the ProtocolId instead of a string
+    static std::string_view detectModernProtocol(ByteView data, uint16_t port, Transport transport = Transport::TCP) {
+        if (data.size < 4) return "Unknown";
 
-        // gRPC detection (HTTP/2 with specific content-type)
-        if ((port == 80 || port == 443) && size > 20) {
-            // Look for gRPC content-type in HTTP/2 headers
-            std::string dataStr(reinterpret_cast<const char*>(data), std::min(size, size_t(100)));
-            if (dataStr.find("application/grpc") != std::string::npos) {
-                return "gRPC";
-            }
-        }
+        ProtocolId id = DissectorRegistry::classify(transport, port, port, data);
+        return id == ProtocolId::Unknown ? std::string_view("Standard") : DissectorRegistry::name(id);
+    }
 
-        return "Standard";
+    static std::string_view detectModernProtocol(const uint8_t* data, size_t size, uint16_t port) {
+        return data ? detectModernProtocol(ByteView(data, size), port) : "Unknown";
     }
 
-    static HTTP2Frame parseHTTP2Frame(const uint8_t* data, size_t size) {
+    static HTTP2Frame parseHTTP2Frame(ByteView data) {
         HTTP2Frame frame{};
-        
-        if (size < 9) return frame; // Minimum frame size
+
+        if (data.size < 9) return frame; // Minimum frame size
 
         // Parse frame header (9 bytes)
-        frame.length = (data[0] << 16) | (data[1] << 8) | data[2];
+        frame.length = (static_cast<uint32_t>(data[0]) << 16) | (data[1] << 8) | data[2];
         frame.type = data[3];
         frame.flags = data[4];
-        frame.streamId = ((data[5] & 0x7F) << 24) | (data[6] << 16) | (data[7] << 8) | data[8];
-
-        // Parse payload if available
-        if (size > 9 && frame.length > 0) {
-            size_t payloadSize = std::min(static_cast<size_t>(frame.length), size - 9);
-            frame.payload.assign(data + 9, data + 9 + payloadSize);
+        frame.streamId = (static_cast<uint32_t>(data[5] & 0x7F) << 24) | (data[6] << 16) | (data[7] << 8) | data[8];
+        frame.payload = data.subview(9, frame.length);
+        frame.complete = frame.payload.size == frame.length;
+        frame.valid = true;
+
+        if (traceEnabled()) {
+            std::cout << "📦 HTTP/2 Frame parsed - Type: " << static_cast<int>(frame.type)
+                      << ", Length: " << frame.length << ", Stream: " << frame.streamId << std::endl;
         }
 
-        std::cout << "📦 HTTP/2 Frame parsed - Type: " << static_cast<int>(frame.type) 
-                  << ", Length: " << frame.length << ", Stream: " << frame.streamId << std::endl;
-
         return frame;
     }
 
-    static QUICPacket parseQUIC(const uint8_t* data, size_t size) {
+    static HTTP2Frame parseHTTP2Frame(const uint8_t* data, size_t size) {
+        return parseHTTP2Frame(ByteView(data, data ? size : 0));
+    }
+
+    static QUICPacket parseQUIC(ByteView data) {
         QUICPacket packet{};
-        
-        if (size < 1) return packet;
+
+        if (data.size < 1) return packet;
 
         uint8_t firstByte = data[0];
         packet.isLongHeader = (firstByte & 0x80) != 0;
 
-        if (packet.isLongHeader && size >= 5) {
-            // Long header format
-            packet.version = (data[1] << 24) | (data[2] << 16) | (data[3] << 8) | data[4];
+        if (packet.isLongHeader) {
+            // Long header: version, then length-prefixed destination and source connection IDs
+            if (data.size < 7) return packet;
+            packet.version = (static_cast<uint32_t>(data[1]) << 24) | (data[2] << 16) | (data[3] << 8) | data[4];
             packet.packetType = (firstByte & 0x30) >> 4;
+
+            size_t offset = 5;
+            const uint8_t dcidLength = data[offset++];
+            if (dcidLength > 20 || offset + dcidLength >= data.size) return packet;
+            packet.destConnectionId = data.subview(offset, dcidLength);
+            offset += dcidLength;
+
+            const uint8_t scidLength = data[offset++];
+            if (scidLength > 20 || offset + scidLength > data.size) return packet;
+            packet.sourceConnectionId = data.subview(offset, scidLength);
+            offset += scidLength;
+
+            packet.payload = data.subview(offset);
         } else {
-            // Short header format
-            packet.version = 0; // Version not present in short header
-            packet.packetType = 0;
+            // Short header: version and connection ID length are not on the wire
+            packet.payload = data.subview(1);
         }
+        packet.valid = true;
 
-        // Parse payload (simplified)
-        if (size > (packet.isLongHeader ? 5 : 1)) {
-            size_t payloadStart = packet.isLongHeader ? 5 : 1;
-            packet.payload.assign(data + payloadStart, data + size);
+        if (traceEnabled()) {
+            std::cout << "🚀 QUIC Packet parsed - Version: 0x" << std::hex << packet.version
+                      << ", Long Header: " << packet.isLongHeader << std::dec << std::endl;
         }
 
-        std::cout << "🚀 QUIC Packet parsed - Version: 0x" << std::hex << packet.version 
-                  << ", Long Header: " << packet.isLongHeader << std::dec << std::endl;
-
         return packet;
     }
 
-    static WebSocketFrame parseWebSocket(const uint8_t* data, size_t size) {
+    static QUICPacket parseQUIC(const uint8_t* data, size_t size) {
+        return parseQUIC(ByteView(data, data ? size : 0));
+    }
+
+    static WebSocketFrame parseWebSocket(ByteView data) {
         WebSocketFrame frame{};
-        
-        if (size < 2) return frame;
+
+        if (data.size < 2) return frame;
 
         uint8_t firstByte = data[0];
         uint8_t secondByte = data[1];
@@ -142,10 +158,12 @@ public:
         uint8_t payloadLen = secondByte & 0x7F;
         size_t headerSize = 2;
 
-        if (payloadLen == 126 && size >= 4) {
+        if (payloadLen == 126) {
+            if (data.size < 4) return frame;
             frame.payloadLength = (data[2] << 8) | data[3];
             headerSize = 4;
-        } else if (payloadLen == 127 && size >= 10) {
+        } else if (payloadLen == 127) {
+            if (data.size < 10) return frame;
             frame.payloadLength = 0;
             for (int i = 0; i < 8; i++) {
                 frame.payloadLength = (frame.payloadLength << 8) | data[2 + i];
@@ -156,62 +174,32 @@ public:
         }
 
         if (frame.masked) {
-            headerSize += 4; // Masking key
+            if (data.size < headerSize + 4) return frame;
+            for (int i = 0; i < 4; i++) {
+                frame.maskingKey[i] = data[headerSize + i];
+            }
+            headerSize += 4;
         }
 
-        // Parse payload if available
-        if (size > headerSize && frame.payloadLength > 0) {
-            size_t payloadSize = std::min(static_cast<size_t>(frame.payloadLength), size - headerSize);
-            frame.payload.assign(data + headerSize, data + headerSize + payloadSize);
-        }
+        frame.headerLength = headerSize;
+        frame.payload = data.subview(headerSize, static_cast<size_t>(std::min<uint64_t>(frame.payloadLength, SIZE_MAX)));
+        frame.complete = frame.payload.size == frame.payloadLength;
+        frame.valid = true;
 
-        std::cout << "🌐 WebSocket Frame parsed - Opcode: " << static_cast<int>(frame.opcode) 
-                  << ", Masked: " << frame.masked << ", Length: " << frame.payloadLength << std::endl;
+        if (traceEnabled()) {
+            std::cout << "🌐 WebSocket Frame parsed - Opcode: " << static_cast<int>(frame.opcode)
+                      << ", Masked: " << frame.masked << ", Length: " << frame.payloadLength << std::endl;
+        }
 
         return frame;
     }
 
-private:
-    static bool isHTTP2Frame(const uint8_t* data, size_t size) {
-        if (size < 9) return false;
-        
-        // Check if it looks like an HTTP/2 frame
-        uint32_t length = (data[0] << 16) | (data[1] << 8) | data[2];
-        uint8_t type = data[3];
-        
-        // Valid frame types: 0-10 in HTTP/2 spec
-        return length <= 16384 && type <= 10; // Max frame size and valid type
-    }
-
-    static bool isQUICPacket(const uint8_t* data, size_t size) {
-        if (size < 1) return false;
-        
-        uint8_t firstByte = data[0];
-        
-        // QUIC packets have specific bit patterns
-        if ((firstByte & 0x80) != 0) {
-            // Long header - check version
-            if (size >= 5) {
-                uint32_t version = (data[1] << 24) | (data[2] << 16) | (data[3] << 8) | data[4];
-                return version != 0; // Version 0 is version negotiation
-            }
-        } else {
-            // Short header - less reliable detection
-            return (firstByte & 0x40) != 0; // Fixed bit must be set
-        }
-        
-        return false;
+    static WebSocketFrame parseWebSocket(const uint8_t* data, size_t size) {
+        return parseWebSocket(ByteView(data, data ? size : 0));
     }
 
-    static bool isWebSocketFrame(const uint8_t* data, size_t size) {
-        if (size < 2) return false;
-        
-        uint8_t firstByte = data[0];
-        uint8_t opcode = firstByte & 0x0F;
-        
-        // Valid WebSocket opcodes: 0-2, 8-10
-        return (opcode <= 2) || (opcode >= 8 && opcode <= 10);
-    }
+private:
+    static inline std::atomic<bool> trace_{false};
 };
 
-} // namespace PacketAnalyzer2026::Protocols
\ No newline at end of file
+} // namespace PacketAnalyzer2026::Protocols
@@ -0,0 +1,274 @@
+// QuicConnectionTable.hpp - Connection-ID index that ties QUIC short-header packets to their connection
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/ByteView.hpp"
+#include "../core/FlowKey.hpp"
+#include "../performance/CpuFeatures.hpp"
+#include "ModernProtocolParser.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::FlowKey;
+using Core::FlowKeyHash;
+
+struct ConnectionIdKey {
+    uint8_t length;
+    uint8_t bytes[20];
+
+    ConnectionIdKey() : length(0), bytes{} {}
+    explicit ConnectionIdKey(ByteView id) : length(static_cast<uint8_t>(std::min<size_t>(id.size, 20))), bytes{} {
+        std::memcpy(bytes, id.data, length);
+    }
+
+    bool operator==(const ConnectionIdKey& other) const {
+        return length == other.length && std::memcmp(bytes, other.bytes, length) == 0;
+    }
+};
+
+struct ConnectionIdHash {
+    size_t operator()(const ConnectionIdKey& key) const {
+        // CIDs are chosen to be unpredictable, but not by us; mix them anyway
+        uint64_t hash = 1469598103934665603ull ^ key.length;
+        for (uint8_t i = 0; i < key.length; ++i) {
+            hash = (hash ^ key.bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct QuicTableStatistics {
+    uint64_t connectionsCreated = 0;
+    uint64_t connectionsExpired = 0;
+    uint64_t connectionsRejected = 0;
+    uint64_t connectionIdChanges = 0;       // New CID seen on a known path
+    uint64_t migrations = 0;                // Known CID seen on a new path
+    uint64_t unmatchedShortHeaders = 0;
+};
+
+// Groups QUIC packets into connections by connection ID rather than by 5-tuple.
+//
+// Long headers carry both CIDs with their lengths, so they create connections and teach
+// the table each endpoint's CID and its length. Short headers only carry the receiver's
+// CID with no length on the wire; the path (5-tuple) tells which connection and length to
+// expect, and a short header whose CID is unknown on a known path is a CID the endpoint
+// issued in an (encrypted) NEW_CONNECTION_ID frame. Packets from an unknown path are tried
+// against the CID lengths seen so far, which follows migration and NAT rebinding.
+//
+// Lookups are hash lookups keyed by path or CID; there is no per-packet scan. Single-threaded:
+// each capture worker owns a table, like the rest of the per-flow state.
+class QuicConnectionTable {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr size_t MAX_CONNECTION_IDS = 8;
+
+    struct Connection {
+        uint32_t flowHash = 0;              // Stable across migration; hash of the first path
+        uint64_t firstSeenNs = 0;
+        uint64_t lastSeenNs = 0;
+        uint64_t packets = 0;
+        FlowKey path{};
+        uint8_t shortCidLength[2] = { 0, 0 };   // DCID length of short headers sent in each direction
+        uint8_t cidCount = 0;
+        uint8_t oldestCid = 0;
+        bool active = false;
+        ConnectionIdKey cids[MAX_CONNECTION_IDS];
+    };
+
+private:
+    std::vector<Connection> connections_;
+    std::vector<uint32_t> freeSlots_;
+    std::unordered_map<ConnectionIdKey, uint32_t, ConnectionIdHash> byConnectionId_;
+    std::unordered_map<FlowKey, uint32_t, FlowKeyHash> byPath_;
+    uint32_t shortCidLengths_ = 0;          // Bit n set when some connection uses n-byte CIDs
+    size_t maxConnections_;
+    uint64_t idleTimeoutNs_;
+    QuicTableStatistics stats_;
+
+    uint32_t findConnectionId(ByteView id) const {
+        if (id.empty()) return NONE;
+        auto it = byConnectionId_.find(ConnectionIdKey(id));
+        return it == byConnectionId_.end() ? NONE : it->second;
+    }
+
+    uint32_t findPath(const FlowKey& path) const {
+        auto it = byPath_.find(path);
+        return it == byPath_.end() ? NONE : it->second;
+    }
+
+    // Zero-length CIDs identify nothing and are only matched by path
+    void learnConnectionId(uint32_t index, ByteView id) {
+        if (id.empty() || id.size > 20) return;
+        ConnectionIdKey key(id);
+        auto inserted = byConnectionId_.emplace(key, index);
+        if (!inserted.second) {
+            inserted.first->second = index;
+            for (uint8_t i = 0; i < connections_[index].cidCount; ++i) {
+                if (connections_[index].cids[i] == key) return;
+            }
+        }
+
+        Connection& connection = connections_[index];
+        if (connection.cidCount < MAX_CONNECTION_IDS) {
+            connection.cids[connection.cidCount++] = key;
+            return;
+        }
+        // Endpoints retire old CIDs as they issue new ones; forget the oldest we know
+        ConnectionIdKey& retired = connection.cids[connection.oldestCid];
+        auto it = byConnectionId_.find(retired);
+        if (it != byConnectionId_.end() && it->second == index) byConnectionId_.erase(it);
+        retired = key;
+        connection.oldestCid = static_cast<uint8_t>((connection.oldestCid + 1) % MAX_CONNECTION_IDS);
+    }
+
+    void bindPath(uint32_t index, const FlowKey& path) {
+        Connection& connection = connections_[index];
+        if (connection.path == path) return;
+
+        auto it = byPath_.find(connection.path);
+        if (it != byPath_.end() && it->second == index) byPath_.erase(it);
+        connection.path = path;
+        byPath_[path] = index;
+        stats_.migrations++;
+    }
+
+    uint32_t create(const FlowKey& path, uint64_t timestampNs) {
+        if (activeConnections() >= maxConnections_) {
+            stats_.connectionsRejected++;
+            return NONE;
+        }
+
+        uint32_t index;
+        if (!freeSlots_.empty()) {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+            connections_[index] = Connection{};
+        } else {
+            index = static_cast<uint32_t>(connections_.size());
+            connections_.emplace_back();
+        }
+
+        Connection& connection = connections_[index];
+        connection.active = true;
+        connection.path = path;
+        connection.flowHash = static_cast<uint32_t>(FlowKeyHash{}(path));
+        connection.firstSeenNs = timestampNs;
+        byPath_[path] = index;
+        stats_.connectionsCreated++;
+        return index;
+    }
+
+    void release(uint32_t index) {
+        Connection& connection = connections_[index];
+        for (uint8_t i = 0; i < connection.cidCount; ++i) {
+            auto it = byConnectionId_.find(connection.cids[i]);
+            if (it != byConnectionId_.end() && it->second == index) byConnectionId_.erase(it);
+        }
+        auto it = byPath_.find(connection.path);
+        if (it != byPath_.end() && it->second == index) byPath_.erase(it);
+        connection.active = false;
+        freeSlots_.push_back(index);
+    }
+
+    uint32_t trackLongHeader(const QUICPacket& packet, const FlowKey& path, uint8_t direction, uint64_t timestampNs) {
+        uint32_t index = findConnectionId(packet.destConnectionId);
+        if (index == NONE) index = findConnectionId(packet.sourceConnectionId);
+        if (index == NONE) index = findPath(path);
+        if (index == NONE) index = create(path, timestampNs);
+        if (index == NONE) return NONE;
+
+        // The sender's CID is what the peer will put in the short headers it sends back
+        Connection& connection = connections_[index];
+        connection.shortCidLength[direction ^ 1] = static_cast<uint8_t>(packet.sourceConnectionId.size);
+        shortCidLengths_ |= 1u << packet.sourceConnectionId.size;
+
+        // The client's first DCID is random and later replaced, but Initial retransmissions
+        // and 0-RTT packets keep using it
+        learnConnectionId(index, packet.destConnectionId);
+        learnConnectionId(index, packet.sourceConnectionId);
+        bindPath(index, path);
+        return index;
+    }
+
+    uint32_t trackShortHeader(ByteView payload, const FlowKey& path, uint8_t direction) {
+        // payload starts right after the first byte, i.e. with the destination CID
+        uint32_t index = findPath(path);
+        if (index != NONE) {
+            const uint8_t length = connections_[index].shortCidLength[direction];
+            if (length > 0 && payload.size >= length) {
+                ByteView id = payload.subview(0, length);
+                if (findConnectionId(id) != index) {
+                    learnConnectionId(index, id);
+                    stats_.connectionIdChanges++;
+                }
+            }
+            return index;
+        }
+
+        for (uint32_t lengths = shortCidLengths_ & ~1u; lengths != 0; lengths &= lengths - 1) {
+            const uint32_t length = Performance::countTrailingZeros(lengths);
+            if (payload.size < length) break;
+            index = findConnectionId(payload.subview(0, length));
+            if (index != NONE && connections_[index].shortCidLength[direction] == length) {
+                bindPath(index, path);
+                return index;
+            }
+        }
+
+        stats_.unmatchedShortHeaders++;
+        return NONE;
+    }
+
+public:
+    explicit QuicConnectionTable(size_t maxConnections = 1u << 20,
+                                 uint64_t idleTimeoutNs = 30ull * 1000000000ull)
+        : maxConnections_(maxConnections)
+        , idleTimeoutNs_(idleTimeoutNs)
+    {
+        byPath_.reserve(1024);
+        byConnectionId_.reserve(4096);
+    }
+
+    // Returns the connection index for a QUIC datagram (UDP payload), or NONE when it cannot
+    // be tied to a connection. direction is the one FlowKey::make returned for the packet.
+    uint32_t track(const FlowKey& path, uint8_t direction, ByteView datagram, uint64_t timestampNs) {
+        QUICPacket packet = ModernProtocolParser::parseQUIC(datagram);
+        if (!packet.valid) return NONE;
+
+        const uint32_t index = packet.isLongHeader
+            ? trackLongHeader(packet, path, direction & 1, timestampNs)
+            : trackShortHeader(packet.payload, path, direction & 1);
+        if (index != NONE) {
+            connections_[index].lastSeenNs = timestampNs;
+            connections_[index].packets++;
+        }
+        return index;
+    }
+
+    bool knowsPath(const FlowKey& path) const { return findPath(path) != NONE; }
+
+    const Connection& connection(uint32_t index) const { return connections_[index]; }
+
+    // Drops connections idle for longer than the timeout; call periodically from the owning worker
+    size_t expireIdle(uint64_t nowNs) {
+        size_t expired = 0;
+        for (uint32_t index = 0; index < connections_.size(); ++index) {
+            const Connection& connection = connections_[index];
+            if (connection.active && nowNs - connection.lastSeenNs > idleTimeoutNs_) {
+                release(index);
+                expired++;
+            }
+        }
+        stats_.connectionsExpired += expired;
+        return expired;
+    }
+
+    size_t activeConnections() const { return connections_.size() - freeSlots_.size(); }
+    const QuicTableStatistics& statistics() const { return stats_; }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
@@ -0,0 +1,302 @@
+// StreamParsers.hpp - Feeds reassembled TCP streams to the HTTP/1.x, HTTP/2 and WebSocket parsers
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "../core/TcpReassembler.hpp"
+#include "DissectorRegistry.hpp"
+#include "Http1Parser.hpp"
+#include "ModernProtocolParser.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::FlowKey;
+using Core::StreamContext;
+
+// TcpReassembler handler that frames HTTP/1.x, HTTP/2 and WebSocket streams and passes every
+// complete header block or frame to Sink:
+//
+//   void onHttp1Message(const StreamContext&, Http1Message&)
+//   void onHttp2Frame(const StreamContext&, const HTTP2Frame&)
+//   void onWebSocketFrame(const StreamContext&, const WebSocketFrame&)
+//   void onWebSocketPayload(const StreamContext&, ByteView piece, uint64_t remaining)
+//   void onStreamClosed(const FlowKey&)
+//
+// Views are into the reassembly input and are only valid during the call. A sink may set
+// Http1Message::body for a response whose framing depends on its request (HEAD, CONNECT).
+// HTTP/1 bodies are skipped by Content-Length or chunk sizes without being buffered, so a
+// keep-alive connection is followed message by message. HTTP/2 DATA frames are skipped the
+// same way: one that is not complete reaches the sink with only the start of its payload
+// (HTTP2Frame::complete unset) and the rest is never delivered. A WebSocket frame with more
+// than 16 KiB of payload is streamed: onWebSocketFrame gets the header and the bytes at hand,
+// onWebSocketPayload the rest piece by piece (still masked) with the number of payload bytes
+// still to come; a gap lowers that number without a call. Any other partial header or frame
+// is left unconsumed so the reassembler offers it again with more bytes. Other streams are
+// consumed as they arrive and never buffered.
+template<typename Sink>
+class ApplicationStreamHandler {
+private:
+    // Stream stage in StreamContext::handlerState
+    enum Stage : uint16_t {
+        STAGE_UNDECIDED = 0,
+        STAGE_HTTP1_HEADER,         // HTTP/1.x header that may request or accept a WebSocket upgrade
+        STAGE_FRAMED,               // Frames of ctx.protocol
+        STAGE_OPAQUE,               // Anything else: pass through
+        STAGE_HTTP1_BODY,           // handlerBytes of a Content-Length body left
+        STAGE_HTTP1_CHUNK_SIZE,
+        STAGE_HTTP1_CHUNK_DATA,     // handlerBytes of chunk data and its CRLF left
+        STAGE_HTTP1_TRAILERS,
+        STAGE_HTTP2_DATA,           // handlerBytes of a DATA frame payload left
+        STAGE_WEBSOCKET_PAYLOAD     // handlerBytes of a streamed WebSocket frame payload left
+    };
+
+    static constexpr size_t HTTP2_PREFACE_LENGTH = 24;
+    static constexpr uint32_t HTTP2_MAX_FRAME_LENGTH = (1u << 24) - 1;
+    static constexpr uint8_t HTTP2_FRAME_DATA = 0x0;
+    static constexpr size_t MAX_HTTP1_HEADER = 16384;
+    static constexpr size_t MAX_CHUNK_LINE = 1024;
+    static constexpr uint64_t MAX_BUFFERED_WEBSOCKET_PAYLOAD = 16384;
+
+    Sink& sink_;
+
+    static uint16_t serverPort(const StreamContext& ctx) {
+        // Direction 0 travels from endpoint A to endpoint B
+        return ctx.direction == 0 ? ctx.key.portB : ctx.key.portA;
+    }
+
+    static uint16_t clientPort(const StreamContext& ctx) {
+        return ctx.direction == 0 ? ctx.key.portA : ctx.key.portB;
+    }
+
+    size_t decide(StreamContext& ctx, ByteView data) {
+        if (Probes::http2Preface(data)) {
+            if (data.size < HTTP2_PREFACE_LENGTH) return 0;
+            ctx.protocol = static_cast<uint8_t>(ProtocolId::HTTP2);
+            ctx.handlerState = STAGE_FRAMED;
+            return HTTP2_PREFACE_LENGTH;
+        }
+
+        const ProtocolId id = DissectorRegistry::classify(Transport::TCP, clientPort(ctx), serverPort(ctx), data);
+        ctx.protocol = static_cast<uint8_t>(id);
+        if (id == ProtocolId::HTTP) {
+            ctx.handlerState = STAGE_HTTP1_HEADER;
+        } else if (id == ProtocolId::HTTP2 && Probes::http2Frame(data)) {
+            // Picked up mid-connection, or the server side of a connection whose preface we saw
+            ctx.handlerState = STAGE_FRAMED;
+        } else {
+            ctx.handlerState = STAGE_OPAQUE;
+        }
+        return 0;
+    }
+
+    static bool isWebSocket(ByteView upgrade) {
+        static constexpr char name[] = "websocket";
+        if (upgrade.size != sizeof(name) - 1) return false;
+        for (size_t i = 0; i < upgrade.size; ++i) {
+            if ((upgrade[i] | 0x20) != name[i]) return false;
+        }
+        return true;
+    }
+
+    size_t http1Header(StreamContext& ctx, ByteView data) {
+        Http1Message message;
+        const Http1ParseResult result = Http1Parser::parse(data, message);
+        if (result == Http1ParseResult::Incomplete && data.size < MAX_HTTP1_HEADER) return 0;
+        if (result != Http1ParseResult::Ok) {
+            ctx.handlerState = STAGE_OPAQUE;
+            return data.size;
+        }
+
+        sink_.onHttp1Message(ctx, message);
+
+        // The client may send frames right after its upgrade request; the server only after 101
+        if (isWebSocket(message.upgrade) && (!message.response || message.status == 101)) {
+            ctx.protocol = static_cast<uint8_t>(ProtocolId::WebSocket);
+            ctx.handlerState = STAGE_FRAMED;
+            return message.headerLength;
+        }
+
+        switch (message.body) {
+            case Http1Body::Length:
+                ctx.handlerBytes = message.bodyLength;
+                ctx.handlerState = STAGE_HTTP1_BODY;
+                break;
+            case Http1Body::Chunked:
+                ctx.handlerState = STAGE_HTTP1_CHUNK_SIZE;
+                break;
+            case Http1Body::UntilClose:
+                ctx.handlerState = STAGE_OPAQUE;
+                break;
+            default:
+                break;                  // The next message follows directly
+        }
+        return message.headerLength;
+    }
+
+    size_t skip(StreamContext& ctx, ByteView data, uint16_t next) {
+        const size_t take = static_cast<size_t>(std::min<uint64_t>(ctx.handlerBytes, data.size));
+        ctx.handlerBytes -= take;
+        if (ctx.handlerBytes == 0) ctx.handlerState = next;
+        return take;
+    }
+
+    size_t http1ChunkSize(StreamContext& ctx, ByteView data) {
+        uint64_t size = 0;
+        const size_t used = Http1Parser::parseChunkSize(data, size);
+        if (used == 0 && data.size < MAX_CHUNK_LINE) return 0;
+        if (used == 0 || used == SIZE_MAX) {
+            ctx.handlerState = STAGE_OPAQUE;
+            return data.size;
+        }
+        if (size == 0) {
+            ctx.handlerState = STAGE_HTTP1_TRAILERS;
+        } else {
+            ctx.handlerBytes = size + 2;
+            ctx.handlerState = STAGE_HTTP1_CHUNK_DATA;
+        }
+        return used;
+    }
+
+    size_t http1Trailers(StreamContext& ctx, ByteView data) {
+        const size_t used = Http1Parser::skipTrailers(data);
+        if (used == 0 && data.size < MAX_HTTP1_HEADER) return 0;
+        if (used == 0 || used == SIZE_MAX) {
+            ctx.handlerState = STAGE_OPAQUE;
+            return data.size;
+        }
+        ctx.handlerState = STAGE_HTTP1_HEADER;
+        return used;
+    }
+
+    size_t http2Frames(StreamContext& ctx, ByteView data) {
+        size_t offset = 0;
+        while (offset < data.size) {
+            HTTP2Frame frame = ModernProtocolParser::parseHTTP2Frame(data.subview(offset));
+            if (!frame.valid) break;
+            if (frame.length > HTTP2_MAX_FRAME_LENGTH || frame.type > 10) {
+                ctx.handlerState = STAGE_OPAQUE;
+                return data.size;
+            }
+            if (frame.type == HTTP2_FRAME_DATA && !frame.complete) {
+                // Bodies are not buffered: pass on the header and what has arrived, skip the rest
+                sink_.onHttp2Frame(ctx, frame);
+                ctx.handlerBytes = frame.length - frame.payload.size;
+                ctx.handlerState = STAGE_HTTP2_DATA;
+                return data.size;
+            }
+            if (!frame.complete) break;
+
+            sink_.onHttp2Frame(ctx, frame);
+            offset += 9 + frame.length;
+        }
+        return offset;
+    }
+
+    size_t webSocketFrames(StreamContext& ctx, ByteView data) {
+        size_t offset = 0;
+        while (offset < data.size) {
+            WebSocketFrame frame = ModernProtocolParser::parseWebSocket(data.subview(offset));
+            if (!frame.valid) break;
+            if (!frame.complete) {
+                if (frame.payloadLength <= MAX_BUFFERED_WEBSOCKET_PAYLOAD) break;
+                // Too large to wait for: the header and first bytes now, the rest as it arrives
+                sink_.onWebSocketFrame(ctx, frame);
+                ctx.handlerBytes = frame.payloadLength - frame.payload.size;
+                ctx.handlerState = STAGE_WEBSOCKET_PAYLOAD;
+                return data.size;
+            }
+
+            sink_.onWebSocketFrame(ctx, frame);
+            offset += frame.headerLength + static_cast<size_t>(frame.payloadLength);
+        }
+        return offset;
+    }
+
+    size_t webSocketPayload(StreamContext& ctx, ByteView data) {
+        const size_t take = static_cast<size_t>(std::min<uint64_t>(ctx.handlerBytes, data.size));
+        ctx.handlerBytes -= take;
+        if (ctx.handlerBytes == 0) ctx.handlerState = STAGE_FRAMED;
+        sink_.onWebSocketPayload(ctx, data.subview(0, take), ctx.handlerBytes);
+        return take;
+    }
+
+public:
+    explicit ApplicationStreamHandler(Sink& sink) : sink_(sink) {}
+
+    size_t onData(StreamContext& ctx, ByteView data) {
+        size_t consumed = 0;
+        while (consumed < data.size) {
+            const ByteView rest = data.subview(consumed);
+            const uint16_t stage = ctx.handlerState;
+            size_t used = 0;
+
+            switch (stage) {
+                case STAGE_UNDECIDED:
+                    used = decide(ctx, rest);
+                    break;
+                case STAGE_HTTP1_HEADER:
+                    used = http1Header(ctx, rest);
+                    break;
+                case STAGE_FRAMED:
+                    used = ctx.protocol == static_cast<uint8_t>(ProtocolId::WebSocket)
+                        ? webSocketFrames(ctx, rest) : http2Frames(ctx, rest);
+                    break;
+                case STAGE_HTTP1_BODY:
+                    used = skip(ctx, rest, STAGE_HTTP1_HEADER);
+                    break;
+                case STAGE_HTTP1_CHUNK_SIZE:
+                    used = http1ChunkSize(ctx, rest);
+                    break;
+                case STAGE_HTTP1_CHUNK_DATA:
+                    used = skip(ctx, rest, STAGE_HTTP1_CHUNK_SIZE);
+                    break;
+                case STAGE_HTTP1_TRAILERS:
+                    used = http1Trailers(ctx, rest);
+                    break;
+                case STAGE_HTTP2_DATA:
+                    used = skip(ctx, rest, STAGE_FRAMED);
+                    break;
+                case STAGE_WEBSOCKET_PAYLOAD:
+                    used = webSocketPayload(ctx, rest);
+                    break;
+                default:
+                    // Opaque, but a later HTTP/1 message on the same connection may still upgrade
+                    if (ctx.protocol == static_cast<uint8_t>(ProtocolId::HTTP) && Probes::http1(rest)) {
+                        ctx.handlerState = STAGE_HTTP1_HEADER;
+                        continue;
+                    }
+                    used = rest.size;
+                    break;
+            }
+
+            consumed += used;
+            // No progress and no stage change: wait for more bytes
+            if (used == 0 && ctx.handlerState == stage) break;
+        }
+        return consumed;
+    }
+
+    void onGap(StreamContext& ctx, uint32_t missing) {
+        // A hole inside a body of known length only shortens the skip; one that ends exactly
+        // at the end of the body leaves the stream at the next header, chunk size or frame
+        const uint16_t stage = ctx.handlerState;
+        if ((stage == STAGE_HTTP1_BODY || stage == STAGE_HTTP1_CHUNK_DATA || stage == STAGE_HTTP2_DATA ||
+             stage == STAGE_WEBSOCKET_PAYLOAD) && missing <= ctx.handlerBytes) {
+            ctx.handlerBytes -= missing;
+            if (ctx.handlerBytes == 0) {
+                ctx.handlerState = stage == STAGE_HTTP1_BODY ? STAGE_HTTP1_HEADER
+                                 : stage == STAGE_HTTP1_CHUNK_DATA ? STAGE_HTTP1_CHUNK_SIZE : STAGE_FRAMED;
+            }
+            return;
+        }
+        // Framing is lost; only a fresh HTTP/1 message can be recognized again
+        ctx.handlerState = STAGE_OPAQUE;
+    }
+
+    void onClose(const FlowKey& key) {
+        sink_.onStreamClosed(key);
+    }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
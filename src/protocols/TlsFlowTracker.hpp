@@ -0,0 +1,173 @@
+// TlsFlowTracker.hpp - Per-flow TLS handshake summary (SNI, ALPN, JA3/JA3S/JA4) from the first segments
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/FlowKey.hpp"
+#include "../core/TcpReassembler.hpp"
+#include "TlsHandshake.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::FlowKey;
+using Core::FlowKeyHash;
+using Core::TcpSegment;
+
+struct TlsFlowInfo {
+    char serverName[256] = {};
+    char alpn[32] = {};                     // Offered first by the client, replaced by the server's choice
+    char ja3[TlsFingerprint::JA3_SIZE] = {};
+    char ja3s[TlsFingerprint::JA3_SIZE] = {};
+    char ja4[TlsFingerprint::JA4_SIZE] = {};
+    uint16_t version = 0;                   // Negotiated, from the ServerHello
+    uint16_t cipher = 0;
+    uint8_t clientDirection = 0;            // FlowKey direction of the ClientHello (0: A to B)
+    bool haveClientHello = false;
+    bool haveServerHello = false;
+};
+
+// Runs the handshake parser over the first payload segments of TLS flows and keeps one
+// TlsFlowInfo per flow. onSegment() reports when a flow needs no more packets, so the caller
+// can stop feeding it: after both hellos, or after MAX_SEGMENTS segments without them.
+//
+// A hello that fits its segment is parsed in place. One that spans segments (post-quantum
+// key shares push ClientHellos past one MSS) is collected in a per-direction buffer of at
+// most one TLS record, in sequence order; anything out of order abandons that direction.
+class TlsFlowTracker {
+private:
+    static constexpr uint8_t MAX_SEGMENTS = 16;
+    static constexpr size_t MAX_PENDING = 16384 + 2048 + 5;
+
+    struct Direction {
+        std::vector<uint8_t> pending;
+        uint32_t nextSequence = 0;
+        bool failed = false;
+    };
+
+    struct Flow {
+        TlsFlowInfo info;
+        Direction directions[2];
+        uint8_t segments = 0;
+    };
+
+    std::unordered_map<FlowKey, Flow, FlowKeyHash> flows_;
+    size_t maxFlows_;
+    uint64_t rejected_ = 0;
+
+    static void copyText(char* out, size_t capacity, ByteView text) {
+        const size_t length = std::min(text.size, capacity - 1);
+        if (length > 0) std::memcpy(out, text.data, length);
+        out[length] = '\0';
+    }
+
+    bool done(const Flow& flow) const {
+        return (flow.info.haveClientHello && flow.info.haveServerHello) || flow.segments >= MAX_SEGMENTS ||
+               (flow.directions[0].failed && flow.directions[1].failed);
+    }
+
+    // Parses one direction's stream start; returns Incomplete with `needed` when more bytes are due
+    TlsParseResult parse(Flow& flow, ByteView stream, uint8_t direction, size_t& needed) {
+        TlsClientHello client;
+        TlsParseResult result = TlsHandshake::parseClientHello(stream, client, &needed);
+        if (result == TlsParseResult::Ok) {
+            copyText(flow.info.serverName, sizeof(flow.info.serverName), client.serverName);
+            if (!flow.info.haveServerHello) copyText(flow.info.alpn, sizeof(flow.info.alpn), client.alpn);
+            TlsFingerprint::ja3(client, flow.info.ja3);
+            TlsFingerprint::ja4(client, flow.info.ja4);
+            flow.info.clientDirection = direction;
+            flow.info.haveClientHello = true;
+            return result;
+        }
+        if (result == TlsParseResult::Incomplete) return result;
+
+        TlsServerHello server;
+        result = TlsHandshake::parseServerHello(stream, server, &needed);
+        if (result == TlsParseResult::Ok) {
+            if (!server.alpn.empty()) copyText(flow.info.alpn, sizeof(flow.info.alpn), server.alpn);
+            TlsFingerprint::ja3s(server, flow.info.ja3s);
+            flow.info.version = server.version;
+            flow.info.cipher = server.cipher;
+            flow.info.haveServerHello = true;
+        }
+        return result;
+    }
+
+public:
+    explicit TlsFlowTracker(size_t maxFlows = 1u << 16)
+        : maxFlows_(maxFlows) {}
+
+    // Returns true once the flow needs no further segments
+    bool onSegment(const TcpSegment& segment) {
+        if (segment.payload.empty()) return false;
+
+        auto it = flows_.find(segment.key);
+        if (it == flows_.end()) {
+            if (flows_.size() >= maxFlows_) {
+                rejected_++;
+                return true;
+            }
+            it = flows_.emplace(segment.key, Flow{}).first;
+        }
+        Flow& flow = it->second;
+        Direction& direction = flow.directions[segment.direction & 1];
+        flow.segments++;
+
+        const bool seen = (flow.info.haveClientHello && flow.info.clientDirection == segment.direction) ||
+                          (flow.info.haveServerHello && flow.info.clientDirection != segment.direction);
+        if (direction.failed || seen) return done(flow);
+
+        size_t needed = 0;
+        if (direction.pending.empty()) {
+            const TlsParseResult result = parse(flow, segment.payload, segment.direction, needed);
+            if (result == TlsParseResult::Incomplete && needed <= MAX_PENDING) {
+                direction.pending.reserve(needed);
+                direction.pending.assign(segment.payload.begin(), segment.payload.end());
+                direction.nextSequence = segment.sequence + static_cast<uint32_t>(segment.payload.size);
+            } else if (result != TlsParseResult::Ok) {
+                direction.failed = true;
+            }
+            return done(flow);
+        }
+
+        if (segment.sequence != direction.nextSequence ||
+            direction.pending.size() + segment.payload.size > MAX_PENDING) {
+            direction.failed = true;
+            std::vector<uint8_t>().swap(direction.pending);
+            return done(flow);
+        }
+        direction.pending.insert(direction.pending.end(), segment.payload.begin(), segment.payload.end());
+        direction.nextSequence += static_cast<uint32_t>(segment.payload.size);
+
+        const TlsParseResult result = parse(flow, ByteView(direction.pending.data(), direction.pending.size()),
+                                            segment.direction, needed);
+        if (result != TlsParseResult::Incomplete) {
+            if (result == TlsParseResult::Invalid) direction.failed = true;
+            std::vector<uint8_t>().swap(direction.pending);
+        }
+        return done(flow);
+    }
+
+    const TlsFlowInfo* find(const FlowKey& key) const {
+        auto it = flows_.find(key);
+        return it != flows_.end() && it->second.info.haveClientHello ? &it->second.info : nullptr;
+    }
+
+    // Visits flows with a parsed ClientHello as visit(const FlowKey&, const TlsFlowInfo&)
+    template<typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (const auto& entry : flows_) {
+            if (entry.second.info.haveClientHello) visit(entry.first, entry.second.info);
+        }
+    }
+
+    void erase(const FlowKey& key) { flows_.erase(key); }
+    void clear() { flows_.clear(); }
+    size_t size() const { return flows_.size(); }
+    uint64_t rejected() const { return rejected_; }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
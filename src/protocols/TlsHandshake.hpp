@@ -0,0 +1,444 @@
+// TlsHandshake.hpp - Bounds-checked ClientHello/ServerHello parsing with SNI, ALPN and JA3/JA4 fingerprints
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../core/ByteView.hpp"
+#include "../core/Digest.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::ByteView;
+
+enum class TlsParseResult : uint8_t {
+    Ok,
+    Incomplete,         // The record continues past the data given; `needed` says how far
+    Invalid             // Not a handshake record of the expected type, or inconsistent lengths
+};
+
+// Lists are kept in wire order, GREASE values included (fingerprints skip them). Entries
+// beyond MAX_LIST are dropped; real hellos stay far below it. Views point into the packet.
+struct TlsClientHello {
+    static constexpr size_t MAX_LIST = 128;
+
+    uint16_t legacyVersion = 0;
+    uint16_t highestVersion = 0;        // From supported_versions, else legacyVersion
+    uint16_t cipherCount = 0;
+    uint16_t extensionCount = 0;
+    uint16_t groupCount = 0;
+    uint16_t pointFormatCount = 0;
+    uint16_t signatureAlgorithmCount = 0;
+    bool hasServerName = false;
+    ByteView serverName;                // First host_name entry
+    ByteView alpn;                      // First protocol offered
+    uint16_t ciphers[MAX_LIST];
+    uint16_t extensions[MAX_LIST];
+    uint16_t groups[MAX_LIST];
+    uint8_t pointFormats[MAX_LIST];
+    uint16_t signatureAlgorithms[MAX_LIST];
+};
+
+struct TlsServerHello {
+    static constexpr size_t MAX_LIST = 64;
+
+    uint16_t legacyVersion = 0;
+    uint16_t version = 0;               // Negotiated: supported_versions if present
+    uint16_t cipher = 0;
+    uint16_t extensionCount = 0;
+    ByteView alpn;                      // Selected protocol
+    uint16_t extensions[MAX_LIST];
+};
+
+// Parses the first handshake message of a TLS record straight from the packet bytes, with
+// no allocation. Every length field is checked against the bytes that enclose it.
+class TlsHandshake {
+private:
+    static constexpr uint8_t CONTENT_HANDSHAKE = 22;
+    static constexpr uint8_t CLIENT_HELLO = 1;
+    static constexpr uint8_t SERVER_HELLO = 2;
+    static constexpr size_t MAX_RECORD = 16384 + 2048;
+
+    static constexpr uint16_t EXT_SERVER_NAME = 0x0000;
+    static constexpr uint16_t EXT_SUPPORTED_GROUPS = 0x000A;
+    static constexpr uint16_t EXT_EC_POINT_FORMATS = 0x000B;
+    static constexpr uint16_t EXT_SIGNATURE_ALGORITHMS = 0x000D;
+    static constexpr uint16_t EXT_ALPN = 0x0010;
+    static constexpr uint16_t EXT_SUPPORTED_VERSIONS = 0x002B;
+
+    // Sequential reader that turns every overrun into a sticky failure
+    class Reader {
+    private:
+        ByteView data_;
+        size_t offset_ = 0;
+        bool ok_ = true;
+
+    public:
+        explicit Reader(ByteView data) : data_(data) {}
+
+        bool ok() const { return ok_; }
+        bool atEnd() const { return offset_ >= data_.size; }
+
+        uint8_t u8() {
+            if (offset_ + 1 > data_.size) { ok_ = false; return 0; }
+            return data_[offset_++];
+        }
+
+        uint16_t u16() {
+            if (offset_ + 2 > data_.size) { ok_ = false; return 0; }
+            const uint16_t value = static_cast<uint16_t>((data_[offset_] << 8) | data_[offset_ + 1]);
+            offset_ += 2;
+            return value;
+        }
+
+        uint32_t u24() {
+            if (offset_ + 3 > data_.size) { ok_ = false; return 0; }
+            const uint32_t value = (static_cast<uint32_t>(data_[offset_]) << 16) | (data_[offset_ + 1] << 8) | data_[offset_ + 2];
+            offset_ += 3;
+            return value;
+        }
+
+        ByteView bytes(size_t length) {
+            if (offset_ + length > data_.size) { ok_ = false; return ByteView(); }
+            const ByteView view = data_.subview(offset_, length);
+            offset_ += length;
+            return view;
+        }
+
+        ByteView vector8() { return bytes(u8()); }
+        ByteView vector16() { return bytes(u16()); }
+    };
+
+    static void readList16(ByteView list, uint16_t* out, uint16_t& count, size_t capacity) {
+        Reader reader(list);
+        while (!reader.atEnd()) {
+            const uint16_t value = reader.u16();
+            if (!reader.ok()) break;
+            if (count < capacity) out[count++] = value;
+        }
+    }
+
+    // Finds the handshake body of the expected type at the start of a record
+    static TlsParseResult message(ByteView stream, uint8_t type, ByteView& body, size_t* needed) {
+        if (stream.size < 5) {
+            if (needed) *needed = 5;
+            return TlsParseResult::Incomplete;
+        }
+        if (stream[0] != CONTENT_HANDSHAKE || stream[1] != 3) return TlsParseResult::Invalid;
+        const size_t recordLength = static_cast<size_t>((stream[3] << 8) | stream[4]);
+        if (recordLength < 4 || recordLength > MAX_RECORD) return TlsParseResult::Invalid;
+        if (stream.size < 5 + recordLength) {
+            if (needed) *needed = 5 + recordLength;
+            return TlsParseResult::Incomplete;
+        }
+
+        Reader reader(stream.subview(5, recordLength));
+        if (reader.u8() != type) return TlsParseResult::Invalid;
+        const uint32_t length = reader.u24();
+        body = reader.bytes(length);
+        // A hello split across records is legal but never seen in practice
+        return reader.ok() ? TlsParseResult::Ok : TlsParseResult::Invalid;
+    }
+
+    static void clientExtension(uint16_t type, ByteView data, TlsClientHello& out) {
+        Reader reader(data);
+        switch (type) {
+            case EXT_SERVER_NAME: {
+                out.hasServerName = true;
+                Reader names(reader.vector16());
+                while (names.ok() && !names.atEnd()) {
+                    const uint8_t nameType = names.u8();
+                    const ByteView name = names.vector16();
+                    if (names.ok() && nameType == 0) {
+                        out.serverName = name;
+                        break;
+                    }
+                }
+                break;
+            }
+            case EXT_SUPPORTED_GROUPS:
+                readList16(reader.vector16(), out.groups, out.groupCount, TlsClientHello::MAX_LIST);
+                break;
+            case EXT_EC_POINT_FORMATS: {
+                const ByteView formats = reader.vector8();
+                for (size_t i = 0; i < formats.size && out.pointFormatCount < TlsClientHello::MAX_LIST; ++i) {
+                    out.pointFormats[out.pointFormatCount++] = formats[i];
+                }
+                break;
+            }
+            case EXT_SIGNATURE_ALGORITHMS:
+                readList16(reader.vector16(), out.signatureAlgorithms, out.signatureAlgorithmCount, TlsClientHello::MAX_LIST);
+                break;
+            case EXT_ALPN: {
+                Reader protocols(reader.vector16());
+                const ByteView first = protocols.vector8();
+                if (protocols.ok()) out.alpn = first;
+                break;
+            }
+            case EXT_SUPPORTED_VERSIONS: {
+                const ByteView versions = reader.vector8();
+                for (size_t i = 0; i + 1 < versions.size; i += 2) {
+                    const uint16_t version = static_cast<uint16_t>((versions[i] << 8) | versions[i + 1]);
+                    if (!isGrease(version) && version > out.highestVersion) out.highestVersion = version;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+public:
+    // RFC 8701 reserved values, 0x?A?A with equal bytes
+    static constexpr bool isGrease(uint16_t value) {
+        return (value & 0x0F0F) == 0x0A0A && (value >> 8) == (value & 0xFF);
+    }
+
+    // stream starts at a TLS record header
+    static TlsParseResult parseClientHello(ByteView stream, TlsClientHello& out, size_t* needed = nullptr) {
+        ByteView body;
+        const TlsParseResult found = message(stream, CLIENT_HELLO, body, needed);
+        if (found != TlsParseResult::Ok) return found;
+
+        Reader reader(body);
+        out.legacyVersion = reader.u16();
+        out.highestVersion = 0;
+        reader.bytes(32);                               // random
+        reader.vector8();                               // legacy_session_id
+        readList16(reader.vector16(), out.ciphers, out.cipherCount, TlsClientHello::MAX_LIST);
+        reader.vector8();                               // compression methods
+        if (!reader.ok()) return TlsParseResult::Invalid;
+
+        if (!reader.atEnd()) {
+            Reader extensions(reader.vector16());
+            while (extensions.ok() && !extensions.atEnd()) {
+                const uint16_t type = extensions.u16();
+                const ByteView data = extensions.vector16();
+                if (!extensions.ok()) return TlsParseResult::Invalid;
+                if (out.extensionCount < TlsClientHello::MAX_LIST) out.extensions[out.extensionCount++] = type;
+                clientExtension(type, data, out);
+            }
+            if (!reader.ok()) return TlsParseResult::Invalid;
+        }
+        if (out.highestVersion == 0) out.highestVersion = out.legacyVersion;
+        return TlsParseResult::Ok;
+    }
+
+    static TlsParseResult parseServerHello(ByteView stream, TlsServerHello& out, size_t* needed = nullptr) {
+        ByteView body;
+        const TlsParseResult found = message(stream, SERVER_HELLO, body, needed);
+        if (found != TlsParseResult::Ok) return found;
+
+        Reader reader(body);
+        out.legacyVersion = reader.u16();
+        out.version = out.legacyVersion;
+        reader.bytes(32);
+        reader.vector8();
+        out.cipher = reader.u16();
+        reader.u8();                                    // compression method
+        if (!reader.ok()) return TlsParseResult::Invalid;
+
+        if (!reader.atEnd()) {
+            Reader extensions(reader.vector16());
+            while (extensions.ok() && !extensions.atEnd()) {
+                const uint16_t type = extensions.u16();
+                const ByteView data = extensions.vector16();
+                if (!extensions.ok()) return TlsParseResult::Invalid;
+                if (out.extensionCount < TlsServerHello::MAX_LIST) out.extensions[out.extensionCount++] = type;
+
+                Reader value(data);
+                if (type == EXT_SUPPORTED_VERSIONS) {
+                    const uint16_t selected = value.u16();
+                    if (value.ok()) out.version = selected;
+                } else if (type == EXT_ALPN) {
+                    Reader protocols(value.vector16());
+                    const ByteView selected = protocols.vector8();
+                    if (protocols.ok()) out.alpn = selected;
+                }
+            }
+            if (!reader.ok()) return TlsParseResult::Invalid;
+        }
+        return TlsParseResult::Ok;
+    }
+};
+
+// JA3/JA3S (Salesforce) and JA4 (FoxIO) fingerprints, built in fixed stack buffers
+class TlsFingerprint {
+private:
+    // Bounded text builder; output past the capacity is dropped
+    template<size_t N>
+    class Text {
+    private:
+        char data_[N];
+        size_t size_ = 0;
+
+    public:
+        void append(char c) {
+            if (size_ + 1 < N) data_[size_++] = c;
+        }
+        void append(const char* text, size_t length) {
+            for (size_t i = 0; i < length; ++i) append(text[i]);
+        }
+        void appendDecimal(uint32_t value) {
+            char digits[10];
+            size_t count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (count > 0) append(digits[--count]);
+        }
+        void appendHex4(uint16_t value) {
+            static constexpr char hex[] = "0123456789abcdef";
+            for (int shift = 12; shift >= 0; shift -= 4) append(hex[(value >> shift) & 0x0F]);
+        }
+        const char* data() const { return data_; }
+        size_t size() const { return size_; }
+    };
+
+    template<size_t N, typename T>
+    static void appendDecimalList(Text<N>& text, const T* values, size_t count) {
+        bool first = true;
+        for (size_t i = 0; i < count; ++i) {
+            if (TlsHandshake::isGrease(values[i])) continue;
+            if (!first) text.append('-');
+            text.appendDecimal(values[i]);
+            first = false;
+        }
+    }
+
+    // Sorted (or wire-order) 4-digit hex list, comma separated, GREASE removed
+    template<size_t N>
+    static size_t appendHexList(Text<N>& text, const uint16_t* values, size_t count, bool sorted,
+                                bool skipSniAlpn = false) {
+        uint16_t filtered[TlsClientHello::MAX_LIST];
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint16_t value = values[i];
+            if (TlsHandshake::isGrease(value) || (skipSniAlpn && (value == 0x0000 || value == 0x0010))) continue;
+            filtered[kept++] = value;
+        }
+        if (sorted) std::sort(filtered, filtered + kept);
+        for (size_t i = 0; i < kept; ++i) {
+            if (i > 0) text.append(',');
+            text.appendHex4(filtered[i]);
+        }
+        return kept;
+    }
+
+    static size_t countNonGrease(const uint16_t* values, size_t count) {
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) kept += TlsHandshake::isGrease(values[i]) ? 0 : 1;
+        return kept;
+    }
+
+    static const char* versionCode(uint16_t version) {
+        switch (version) {
+            case 0x0304: return "13";
+            case 0x0303: return "12";
+            case 0x0302: return "11";
+            case 0x0301: return "10";
+            case 0x0300: return "s3";
+            case 0x0002: return "s2";
+            case 0xFEFF: return "d1";
+            case 0xFEFD: return "d2";
+            case 0xFEFC: return "d3";
+            default:     return "00";
+        }
+    }
+
+    static bool alphanumeric(uint8_t c) {
+        return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+
+public:
+    static constexpr size_t JA3_SIZE = 33;          // 32 hex digits plus the terminator
+    static constexpr size_t JA4_SIZE = 37;          // "t13d1516h2_8daaf6152771_e5627efa2ab1"
+
+    // MD5 of "version,ciphers,extensions,groups,pointFormats"
+    static void ja3(const TlsClientHello& hello, char out[JA3_SIZE]) {
+        Text<4096> text;
+        text.appendDecimal(hello.legacyVersion);
+        text.append(',');
+        appendDecimalList(text, hello.ciphers, hello.cipherCount);
+        text.append(',');
+        appendDecimalList(text, hello.extensions, hello.extensionCount);
+        text.append(',');
+        appendDecimalList(text, hello.groups, hello.groupCount);
+        text.append(',');
+        appendDecimalList(text, hello.pointFormats, hello.pointFormatCount);
+        Core::Md5::hex(text.data(), text.size(), out);
+    }
+
+    // MD5 of "version,cipher,extensions"
+    static void ja3s(const TlsServerHello& hello, char out[JA3_SIZE]) {
+        Text<1024> text;
+        text.appendDecimal(hello.legacyVersion);
+        text.append(',');
+        text.appendDecimal(hello.cipher);
+        text.append(',');
+        appendDecimalList(text, hello.extensions, hello.extensionCount);
+        Core::Md5::hex(text.data(), text.size(), out);
+    }
+
+    // JA4 for TLS over TCP: readable prefix, then truncated SHA-256 of the sorted cipher list
+    // and of the sorted extensions (without SNI and ALPN) followed by the signature algorithms
+    static void ja4(const TlsClientHello& hello, char out[JA4_SIZE]) {
+        Text<JA4_SIZE> result;
+        result.append('t');
+        result.append(versionCode(hello.highestVersion), 2);
+        result.append(hello.hasServerName ? 'd' : 'i');
+
+        const size_t ciphers = std::min<size_t>(countNonGrease(hello.ciphers, hello.cipherCount), 99);
+        const size_t extensions = std::min<size_t>(countNonGrease(hello.extensions, hello.extensionCount), 99);
+        result.append(static_cast<char>('0' + ciphers / 10));
+        result.append(static_cast<char>('0' + ciphers % 10));
+        result.append(static_cast<char>('0' + extensions / 10));
+        result.append(static_cast<char>('0' + extensions % 10));
+
+        if (hello.alpn.empty()) {
+            result.append("00", 2);
+        } else {
+            const uint8_t first = hello.alpn[0];
+            const uint8_t last = hello.alpn[hello.alpn.size - 1];
+            if (alphanumeric(first) && alphanumeric(last)) {
+                result.append(static_cast<char>(first));
+                result.append(static_cast<char>(last));
+            } else {
+                static constexpr char hex[] = "0123456789abcdef";
+                result.append(hex[first >> 4]);
+                result.append(hex[last & 0x0F]);
+            }
+        }
+
+        char hash[13];
+        Text<TlsClientHello::MAX_LIST * 5> list;
+        if (appendHexList(list, hello.ciphers, hello.cipherCount, true) > 0) {
+            Core::Sha256::hexPrefix(list.data(), list.size(), 12, hash);
+        } else {
+            std::memcpy(hash, "000000000000", 13);
+        }
+        result.append('_');
+        result.append(hash, 12);
+
+        Text<TlsClientHello::MAX_LIST * 10 + 1> extensionList;
+        if (appendHexList(extensionList, hello.extensions, hello.extensionCount, true, true) > 0) {
+            if (hello.signatureAlgorithmCount > 0) {
+                extensionList.append('_');
+                appendHexList(extensionList, hello.signatureAlgorithms, hello.signatureAlgorithmCount, false);
+            }
+            Core::Sha256::hexPrefix(extensionList.data(), extensionList.size(), 12, hash);
+        } else {
+            std::memcpy(hash, "000000000000", 13);
+        }
+        result.append('_');
+        result.append(hash, 12);
+
+        std::memcpy(out, result.data(), result.size());
+        out[result.size()] = '\0';
+    }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
@@ -0,0 +1,254 @@
+// WebSocketMessages.hpp - Unmasks WebSocket frames and joins continuation frames into messages
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/FlowKey.hpp"
+#include "../core/TcpReassembler.hpp"
+#include "../performance/WebSocketUnmask.hpp"
+#include "ModernProtocolParser.hpp"
+
+namespace PacketAnalyzer2026::Protocols {
+
+using Core::FlowKey;
+using Core::FlowKeyHash;
+using Core::StreamContext;
+
+enum WebSocketOpcode : uint8_t {
+    WS_CONTINUATION = 0x0,
+    WS_TEXT = 0x1,
+    WS_BINARY = 0x2,
+    WS_CLOSE = 0x8,
+    WS_PING = 0x9,
+    WS_PONG = 0xA
+};
+
+struct WebSocketMessage {
+    uint8_t opcode;                 // Of the first frame; never WS_CONTINUATION
+    uint32_t frames;
+    bool truncated;                 // Longer than the assembler limit; payload holds the first part
+    ByteView payload;               // Unmasked, valid only during the callback
+};
+
+// Message state for one direction of one WebSocket connection. Unmasked single-frame
+// messages are handed over as views into the frame, without copying; masked payloads are
+// unmasked while being copied into the message buffer, which is reused between messages.
+// Streamed frames are appended piece by piece, unmasked from their offset in the payload.
+class WebSocketMessageAssembler {
+private:
+    // The frame whose payload is still arriving through onPayload
+    struct StreamedFrame {
+        uint64_t length;
+        uint64_t received;          // Payload offset the next piece should start at
+        uint8_t maskingKey[4];
+        bool masked;
+        bool fin;
+        bool kept;                  // Part of the message being assembled
+    };
+
+    std::vector<uint8_t> buffer_;
+    std::vector<uint8_t> control_;      // Masked control frames that arrive mid-message
+    uint8_t opcode_ = 0;
+    uint32_t frames_ = 0;
+    bool truncated_ = false;
+    bool inMessage_ = false;
+    bool inFrame_ = false;
+    StreamedFrame frame_{};
+    size_t maxMessageSize_;
+
+    void append(ByteView piece, bool masked, const uint8_t maskingKey[4], uint64_t offset) {
+        const size_t room = maxMessageSize_ - std::min(maxMessageSize_, buffer_.size());
+        const size_t length = std::min(room, piece.size);
+        if (length < piece.size) truncated_ = true;
+
+        const size_t start = buffer_.size();
+        buffer_.resize(start + length);
+        if (masked) {
+            Performance::WebSocketUnmask::apply(piece.data, buffer_.data() + start, length, maskingKey,
+                                                static_cast<size_t>(offset & 3));
+        } else if (length > 0) {
+            std::memcpy(buffer_.data() + start, piece.data, length);
+        }
+    }
+
+    template<typename MessageHandler>
+    void deliverMessage(MessageHandler& onMessage) {
+        WebSocketMessage message{ opcode_, frames_, truncated_, ByteView(buffer_.data(), buffer_.size()) };
+        inMessage_ = false;
+        onMessage(message);
+    }
+
+    // Ends the streamed frame; one cut short by a gap still counts, with the message truncated
+    template<typename MessageHandler>
+    void endFrame(MessageHandler& onMessage) {
+        inFrame_ = false;
+        if (!frame_.kept) return;
+        if (frame_.received != frame_.length) truncated_ = true;
+        frames_++;
+        if (frame_.fin) deliverMessage(onMessage);
+    }
+
+    template<typename MessageHandler>
+    void deliverSingle(const WebSocketFrame& frame, MessageHandler& onMessage) {
+        if (!frame.masked) {
+            onMessage(WebSocketMessage{ frame.opcode, 1, false, frame.payload });
+            return;
+        }
+
+        std::vector<uint8_t>& target = inMessage_ ? control_ : buffer_;
+        const size_t length = std::min(frame.payload.size, maxMessageSize_);
+        target.resize(length);
+        Performance::WebSocketUnmask::apply(frame.payload.data, target.data(), length, frame.maskingKey);
+        onMessage(WebSocketMessage{ frame.opcode, 1, length < frame.payload.size, ByteView(target.data(), length) });
+    }
+
+public:
+    explicit WebSocketMessageAssembler(size_t maxMessageSize = 16u << 20)
+        : maxMessageSize_(maxMessageSize) {}
+
+    // onMessage(const WebSocketMessage&) runs for every complete message and control frame.
+    // Frames come as ApplicationStreamHandler delivers them: complete, or for a streamed frame
+    // the header and first bytes here and the rest through onPayload.
+    template<typename MessageHandler>
+    void onFrame(const WebSocketFrame& frame, MessageHandler&& onMessage) {
+        if (!frame.valid) return;
+        if (inFrame_) endFrame(onMessage);
+
+        // Control frames are never fragmented and may arrive between the pieces of a message;
+        // their payload is at most 125 bytes, so they are never streamed
+        if (frame.opcode >= WS_CLOSE) {
+            if (frame.complete) deliverSingle(frame, onMessage);
+            return;
+        }
+
+        bool kept = true;
+        if (frame.opcode != WS_CONTINUATION) {
+            // A new data frame abandons any unfinished message (protocol error on the wire)
+            if (frame.fin && frame.complete) {
+                inMessage_ = false;
+                deliverSingle(frame, onMessage);
+                return;
+            }
+            buffer_.clear();
+            opcode_ = frame.opcode;
+            frames_ = 0;
+            truncated_ = false;
+            inMessage_ = true;
+        } else if (!inMessage_) {
+            // Picked up mid-message; the first fragments are gone
+            kept = false;
+        }
+
+        if (!frame.complete) {
+            frame_ = StreamedFrame{ frame.payloadLength, frame.payload.size, {}, frame.masked, frame.fin, kept };
+            std::memcpy(frame_.maskingKey, frame.maskingKey, sizeof(frame_.maskingKey));
+            inFrame_ = true;
+            if (kept) append(frame.payload, frame.masked, frame.maskingKey, 0);
+            return;
+        }
+        if (!kept) return;
+
+        append(frame.payload, frame.masked, frame.maskingKey, 0);
+        frames_++;
+        if (frame.fin) deliverMessage(onMessage);
+    }
+
+    // Next piece of the streamed frame, remaining payload bytes after it
+    template<typename MessageHandler>
+    void onPayload(ByteView piece, uint64_t remaining, MessageHandler&& onMessage) {
+        if (!inFrame_) return;
+        if (remaining > frame_.length || piece.size > frame_.length - remaining) {
+            // Does not fit the frame it claims to continue
+            frame_.kept = false;
+            inFrame_ = false;
+            inMessage_ = false;
+            return;
+        }
+
+        const uint64_t offset = frame_.length - remaining - piece.size;
+        if (offset != frame_.received) truncated_ = true;      // A gap took part of the payload
+        if (frame_.kept) append(piece, frame_.masked, frame_.maskingKey, offset);
+        frame_.received = offset + piece.size;
+        if (remaining == 0) endFrame(onMessage);
+    }
+
+    bool inMessage() const { return inMessage_; }
+};
+
+// Sink adapter for ApplicationStreamHandler (or Http2HeaderTracker) that turns WebSocket
+// frames into messages and forwards everything to Sink, which additionally receives
+//
+//   void onWebSocketMessage(const StreamContext&, const WebSocketMessage&)
+template<typename Sink>
+class WebSocketMessageTracker {
+private:
+    struct Connection {
+        WebSocketMessageAssembler directions[2];
+
+        explicit Connection(size_t maxMessageSize)
+            : directions{ WebSocketMessageAssembler(maxMessageSize), WebSocketMessageAssembler(maxMessageSize) } {}
+    };
+
+    Sink& sink_;
+    size_t maxMessageSize_;
+    std::unordered_map<FlowKey, Connection, FlowKeyHash> connections_;
+
+public:
+    explicit WebSocketMessageTracker(Sink& sink, size_t maxMessageSize = 16u << 20)
+        : sink_(sink)
+        , maxMessageSize_(maxMessageSize) {}
+
+    void onWebSocketFrame(const StreamContext& ctx, const WebSocketFrame& frame) {
+        sink_.onWebSocketFrame(ctx, frame);
+
+        auto it = connections_.find(ctx.key);
+        if (it == connections_.end()) {
+            it = connections_.emplace(ctx.key, Connection(maxMessageSize_)).first;
+        }
+        it->second.directions[ctx.direction & 1].onFrame(frame, [&](const WebSocketMessage& message) {
+            sink_.onWebSocketMessage(ctx, message);
+        });
+    }
+
+    void onWebSocketPayload(const StreamContext& ctx, ByteView piece, uint64_t remaining) {
+        sink_.onWebSocketPayload(ctx, piece, remaining);
+
+        auto it = connections_.find(ctx.key);
+        if (it == connections_.end()) return;
+        it->second.directions[ctx.direction & 1].onPayload(piece, remaining, [&](const WebSocketMessage& message) {
+            sink_.onWebSocketMessage(ctx, message);
+        });
+    }
+
+    template<typename Endpoint>
+    void onHttp1Transaction(const StreamContext& ctx, const Endpoint& endpoint, uint64_t latencyNs, uint16_t status) {
+        sink_.onHttp1Transaction(ctx, endpoint, latencyNs, status);
+    }
+
+    void onHttp2Frame(const StreamContext& ctx, const HTTP2Frame& frame) {
+        sink_.onHttp2Frame(ctx, frame);
+    }
+
+    template<typename Message>
+    void onHttp1Message(const StreamContext& ctx, Message& message) {
+        sink_.onHttp1Message(ctx, message);
+    }
+
+    template<typename Headers>
+    void onHttp2Headers(const StreamContext& ctx, const Headers& headers) {
+        sink_.onHttp2Headers(ctx, headers);
+    }
+
+    void onStreamClosed(const FlowKey& key) {
+        connections_.erase(key);
+        sink_.onStreamClosed(key);
+    }
+
+    size_t connectionCount() const { return connections_.size(); }
+};
+
+} // namespace PacketAnalyzer2026::Protocols
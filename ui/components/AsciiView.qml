@@ -6,8 +6,8 @@ Rectangle {
     id: asciiView
     color: "#0d0d0d"
     
-    property var hexDumpLines: []
-    property string selectedPacketData: ""
+    // Row model with offset/ascii roles, normally the C++ HexDumpModel
+    property var dumpModel: typeof HexDumpModel !== 'undefined' ? HexDumpModel : null
     
     Column {
         anchors.fill: parent
@@ -39,11 +39,16 @@ Rectangle {
             }
         }
         
-        // ASCII content
-        ScrollView {
+        // ASCII lines, formatted by the model only while visible
+        ListView {
+            id: asciiList
             width: parent.width
-            height: parent.height - 35
+            height: parent.height - 35 - decodedPanel.height
             clip: true
+            spacing: 2
+            topMargin: 10
+            leftMargin: 10
+            model: dumpModel
             
             ScrollBar.vertical: ScrollBar {
                 policy: ScrollBar.AsNeeded
@@ -55,137 +60,97 @@ Rectangle {
                 }
             }
             
-            Column {
-                width: parent.width
-                padding: 10
-                spacing: 2
+            delegate: Rectangle {
+                width: asciiList.width - 20
+                height: 20
+                color: asciiLineHover.containsMouse ? "#1a1a1a" : "transparent"
+                radius: 3
                 
-                // ASCII lines from hex dump
-                Repeater {
-                    model: hexDumpLines
+                Row {
+                    anchors.fill: parent
+                    spacing: 10
+                    
+                    // Offset
+                    Text {
+                        text: model.offset
+                        color: "#999999"
+                        font.pixelSize: 11
+                        font.family: "Consolas, Monaco, 'Courier New', monospace"
+                        width: 40
+                        anchors.verticalCenter: parent.verticalCenter
+                    }
                     
-                    Rectangle {
-                        width: parent.width - 20
-                        height: 20
-                        color: asciiLineHover.containsMouse ? "#1a1a1a" : "transparent"
-                        radius: 3
-                        
-                        Row {
-                            anchors.fill: parent
-                            spacing: 10
-                            
-                            // Offset
-                            Text {
-                                text: modelData.offset
-                                color: "#999999"
-                                font.pixelSize: 11
-                                font.family: "Consolas, Monaco, 'Courier New', monospace"
-                                width: 40
-                                anchors.verticalCenter: parent.verticalCenter
-                            }
-                            
-                            // ASCII interpretation
-                            Text {
-                                text: modelData.ascii
-                                color: "#ffffff"
-                                font.pixelSize: 11
-                                font.family: "Consolas, Monaco, 'Courier New', monospace"
-                                anchors.verticalCenter: parent.verticalCenter
-                                
-                                // Highlight readable characters
-                                Component.onCompleted: {
-                                    // Color readable ASCII green, non-readable gray
-                                    var readable = /^[!-~\s]*$/.test(modelData.ascii)
-                                    color = readable ? "#00ff88" : "#666666"
-                                }
-                            }
-                        }
-                        
-                        MouseArea {
-                            id: asciiLineHover
-                            anchors.fill: parent
-                            hoverEnabled: true
-                            cursorShape: Qt.PointingHandCursor
-                        }
-                        
-                        Behavior on color { ColorAnimation { duration: 100 } }
+                    // ASCII interpretation, non-printable bytes already shown as '.'
+                    Text {
+                        text: model.ascii
+                        color: model.ascii.indexOf(".") === -1 ? "#00ff88" : "#ffffff"
+                        font.pixelSize: 11
+                        font.family: "Consolas, Monaco, 'Courier New', monospace"
+                        anchors.verticalCenter: parent.verticalCenter
                     }
                 }
                 
-                // Decoded content section
-                Rectangle {
-                    width: parent.width - 20
-                    height: Math.max(60, decodedContent.implicitHeight + 20)
-                    color: "#1a1a1a"
-                    radius: 8
-                    border.color: "#404040"
-                    border.width: 1
-                    visible: selectedPacketData.length > 0
+                MouseArea {
+                    id: asciiLineHover
+                    anchors.fill: parent
+                    hoverEnabled: true
+                    cursorShape: Qt.PointingHandCursor
+                }
+                
+                Behavior on color { ColorAnimation { duration: 100 } }
+            }
+        }
+        
+        // Decoded content section
+        Rectangle {
+            id: decodedPanel
+            width: parent.width - 20
+            x: 10
+            height: visible ? 140 : 0
+            color: "#1a1a1a"
+            radius: 8
+            border.color: "#404040"
+            border.width: 1
+            visible: dumpModel !== null && dumpModel.count > 0
+            
+            Column {
+                anchors.fill: parent
+                anchors.margins: 10
+                spacing: 8
+                
+                Text {
+                    text: "🔍 Decoded Content:"
+                    color: "#66d9ff"
+                    font.pixelSize: 12
+                    font.weight: Font.Bold
+                }
+                
+                ScrollView {
+                    width: parent.width
+                    height: parent.height - 30
+                    clip: true
                     
-                    Column {
-                        anchors.fill: parent
-                        anchors.margins: 10
-                        spacing: 8
-                        
-                        Text {
-                            text: "🔍 Decoded Content:"
-                            color: "#66d9ff"
-                            font.pixelSize: 12
-                            font.weight: Font.Bold
-                        }
-                        
-                        ScrollView {
-                            width: parent.width
-                            height: parent.height - 30
-                            clip: true
-                            
-                            Text {
-                                id: decodedContent
-                                width: parent.width - 10
-                                text: extractReadableText(selectedPacketData)
-                                color: "#00ff88"
-                                font.pixelSize: 11
-                                font.family: "Consolas, Monaco, 'Courier New', monospace"
-                                wrapMode: Text.Wrap
-                            }
-                        }
+                    Text {
+                        id: decodedContent
+                        width: parent.width - 10
+                        text: extractReadableText()
+                        color: "#00ff88"
+                        font.pixelSize: 11
+                        font.family: "Consolas, Monaco, 'Courier New', monospace"
+                        wrapMode: Text.Wrap
                     }
                 }
             }
         }
     }
     
-    // Function to extract readable text from packet data
-    function extractReadableText(data) {
-        if (!data || data.length === 0) {
+    // Printable runs of the selected packet, extracted natively by the dump model
+    function extractReadableText() {
+        if (!dumpModel || dumpModel.count === 0) {
             return "No packet selected"
         }
         
-        // Extract common readable patterns
-        var patterns = [
-            "Host: ",
-            "User-Agent: ",
-            "GET ",
-            "POST ",
-            "HTTP/",
-            "Content-Type: ",
-            "google.com",
-            "cloudflare.com",
-            "mozilla.org"
-        ]
-        
-        var result = ""
-        for (var i = 0; i < patterns.length; i++) {
-            if (data.indexOf(patterns[i]) !== -1) {
-                result += patterns[i] + "\n"
-            }
-        }
-        
-        return result || "Binary data - no readable text found"
-    }
-    
-    // Update ASCII view when packet selection changes
-    function updatePacketData(packetData) {
-        selectedPacketData = packetData || ""
+        var text = dumpModel.readableText(4, 4096)
+        return text.length > 0 ? text : "Binary data - no readable text found"
     }
 }
\ No newline at end of file
@@ -2,53 +2,68 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 
-ScrollView {
-    property var packet: null
+Rectangle {
+    // Row model with offset/hex/ascii roles, normally the C++ HexDumpModel
+    property var dumpModel: typeof HexDumpModel !== 'undefined' ? HexDumpModel : null
     
-    clip: true
+    color: "#1a1a1a"
     
-    Rectangle {
-        width: parent.width
-        height: Math.max(parent.height, textArea.contentHeight + 20)
-        color: "#1a1a1a"
+    Text {
+        id: header
+        anchors.left: parent.left
+        anchors.top: parent.top
+        anchors.margins: 10
+        text: "Offset  00 01 02 03 04 05 06 07  08 09 0A 0B 0C 0D 0E 0F  ASCII"
+        color: "#999999"
+        font.family: "Consolas, Monaco, monospace"
+        font.pixelSize: 11
+    }
+    
+    // Only the lines in view are formatted, so large payloads open as fast as small ones
+    ListView {
+        anchors.fill: parent
+        anchors.margins: 10
+        anchors.topMargin: header.height + 16
+        clip: true
+        model: dumpModel
+        ScrollBar.vertical: ScrollBar {}
         
-        TextArea {
-            id: textArea
-            anchors.fill: parent
-            anchors.margins: 10
+        delegate: Item {
+            width: lineText.implicitWidth
+            height: lineText.implicitHeight
             
-            text: generateHexDump()
-            color: "#00ff88"
-            font.family: "Consolas, Monaco, monospace"
-            font.pixelSize: 11
-            selectByMouse: true
-            readOnly: true
+            // Bytes of the field selected in the protocol tree
+            Rectangle {
+                visible: model.highlightStart >= 0
+                x: lineText.x + glyph.advanceWidth * (model.offset.length + 4 + model.highlightStart * 3 + (model.highlightStart >= 8 ? 1 : 0))
+                width: glyph.advanceWidth * ((model.highlightEnd - model.highlightStart) * 3 - 1 +
+                                             (model.highlightStart < 8 && model.highlightEnd > 8 ? 1 : 0))
+                height: parent.height
+                color: "#ffc10740"
+                radius: 2
+            }
             
-            background: Rectangle {
-                color: "transparent"
+            Text {
+                id: lineText
+                text: model.offset + "    " + model.hex + "  " + model.ascii
+                color: "#00ff88"
+                font: glyph.font
             }
         }
     }
     
-    function generateHexDump() {
-        if (!packet) {
-            return "No packet selected for hex dump analysis."
-        }
-        
-        // Generate real hex dump from packet data
-        var hexDump = "Offset  00 01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F  ASCII\n"
-        hexDump += "------  -----------------------------------------------  ----------------\n"
-        
-        // Use real packet data if available from C++ backend
-        if (packet && packet.rawData) {
-            // Real packet hex dump from PacketCaptureEngine
-            hexDump += packet.rawData
-        } else {
-            // Minimal placeholder when no real packet data
-            hexDump += "0000    No real packet data available                              \n"
-            hexDump += "        Select a captured packet to view hex dump                   \n"
-        }
-        
-        return hexDump
+    TextMetrics {
+        id: glyph
+        font.family: "Consolas, Monaco, monospace"
+        font.pixelSize: 11
+        text: "0"
+    }
+    
+    Text {
+        anchors.centerIn: parent
+        visible: !dumpModel || dumpModel.count === 0
+        text: "No packet selected for hex dump analysis."
+        color: "#666666"
+        font.pixelSize: 11
     }
-}
\ No newline at end of file
+}
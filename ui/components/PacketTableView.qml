@@ -5,7 +5,9 @@ import QtQuick.Controls 2.15
 ListView {
     id: listView
     
-    property alias model: listView.model
+    // Stored capture session, paged from the database as rows scroll into view; normally the
+    // C++ SessionPacketModel
+    model: typeof SessionPacketModel !== 'undefined' ? SessionPacketModel : null
     
     clip: true
     
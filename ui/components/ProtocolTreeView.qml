@@ -1,104 +1,98 @@
 // ProtocolTreeView.qml - Protocol tree view component
-import QtQuick 2.15
-import QtQuick.Controls 2.15
+import QtQuick
+import QtQuick.Controls
 
-ScrollView {
-    property var packet: null
+Rectangle {
+    // Tree model with label/offset/length roles, normally the C++ ProtocolTreeModel
+    property var treeModel: typeof ProtocolTreeModel !== 'undefined' ? ProtocolTreeModel : null
+    // Receives the selected field's bytes, normally the C++ HexDumpModel
+    property var hexModel: typeof HexDumpModel !== 'undefined' ? HexDumpModel : null
     
-    clip: true
+    color: "#1a1a1a"
     
-    Rectangle {
-        width: parent.width
-        height: Math.max(parent.height, column.height)
-        color: "#1a1a1a"
+    Text {
+        id: title
+        anchors.left: parent.left
+        anchors.top: parent.top
+        anchors.margins: 10
+        text: treeModel && treeModel.fieldCount > 0
+              ? "📋 Protocol Analysis - Packet #" + treeModel.packetNumber
+              : "📋 No packet selected"
+        color: "white"
+        font.bold: true
+        font.pixelSize: 14
+    }
+    
+    // Layers start collapsed; fields are only instantiated when their layer is expanded
+    TreeView {
+        id: treeView
+        anchors.fill: parent
+        anchors.margins: 10
+        anchors.topMargin: title.height + 20
+        clip: true
+        model: treeModel
+        selectionModel: ItemSelectionModel { model: treeView.model }
+        ScrollBar.vertical: ScrollBar {}
         
-        Column {
-            id: column
-            anchors.fill: parent
-            anchors.margins: 10
-            spacing: 5
+        delegate: Item {
+            id: fieldItem
+            implicitWidth: treeView.width
+            implicitHeight: 22
             
-            Text {
-                text: packet ? "📋 Protocol Analysis" : "📋 No packet selected"
-                color: "white"
-                font.bold: true
-                font.pixelSize: 14
-            }
+            required property TreeView treeView
+            required property bool isTreeNode
+            required property bool expanded
+            required property int hasChildren
+            required property int depth
+            required property int row
+            required property bool current
+            required property string label
+            required property int offset
+            required property int length
+            required property bool isLayer
             
             Rectangle {
-                width: parent.width
-                height: 1
-                color: "#333333"
-            }
-            
-            // Ethernet frame
-            Text {
-                text: "🔗 Ethernet II"
-                color: "#88ccff"
-                font.bold: true
-                font.pixelSize: 12
+                anchors.fill: parent
+                color: fieldItem.current ? "#00ff8830" : fieldHover.containsMouse ? "#2a2a2a" : "transparent"
+                radius: 4
             }
             
             Text {
-                text: packet ? `   Source: ${packet.sourceIP}` : "   Source: N/A"
-                color: "#cccccc"
-                font.pixelSize: 11
-                leftPadding: 20
+                id: indicator
+                x: fieldItem.depth * 16
+                anchors.verticalCenter: parent.verticalCenter
+                visible: fieldItem.hasChildren
+                text: fieldItem.expanded ? "▼" : "▶"
+                color: "#00ff88"
+                font.pixelSize: 10
             }
             
             Text {
-                text: packet ? `   Destination: ${packet.destIP}` : "   Destination: N/A"
-                color: "#cccccc"
+                x: indicator.x + 16
+                anchors.verticalCenter: parent.verticalCenter
+                text: fieldItem.label
+                color: fieldItem.isLayer ? "#88ccff" : "#cccccc"
+                font.bold: fieldItem.isLayer
                 font.pixelSize: 11
-                leftPadding: 20
-            }
-            
-            // IP layer
-            Text {
-                text: "🌐 Internet Protocol Version 4 (IPv4)"
-                color: "#88ff88"
-                font.bold: true
-                font.pixelSize: 12
+                font.family: "Consolas, Monaco, monospace"
             }
             
-            Text {
-                text: packet ? `   Protocol: ${packet.protocol}` : "   Protocol: N/A"
-                color: "#cccccc"
-                font.pixelSize: 11
-                leftPadding: 20
-            }
-            
-            Text {
-                text: packet ? `   Length: ${packet.size} bytes` : "   Length: N/A"
-                color: "#cccccc"
-                font.pixelSize: 11
-                leftPadding: 20
-            }
-            
-            // Transport layer
-            Text {
-                text: packet && packet.protocol === "TCP" ? "🚛 Transmission Control Protocol (TCP)" :
-                      packet && packet.protocol === "UDP" ? "📦 User Datagram Protocol (UDP)" :
-                      "🔄 Transport Layer"
-                color: "#ffcc88"
-                font.bold: true
-                font.pixelSize: 12
-            }
-            
-            Text {
-                text: packet && packet.flags ? `   Flags: ${packet.flags}` : "   Flags: N/A"
-                color: "#cccccc"
-                font.pixelSize: 11
-                leftPadding: 20
-            }
-            
-            // Application layer
-            Text {
-                text: packet && packet.info ? `📱 Application: ${packet.info}` : "📱 Application Layer"
-                color: "#ff88cc"
-                font.bold: true
-                font.pixelSize: 12
+            MouseArea {
+                id: fieldHover
+                anchors.fill: parent
+                hoverEnabled: true
+                cursorShape: Qt.PointingHandCursor
+                onClicked: {
+                    var index = treeView.index(fieldItem.row, 0)
+                    treeView.selectionModel.setCurrentIndex(index, ItemSelectionModel.ClearAndSelect)
+                    if (fieldItem.hasChildren) {
+                        treeView.toggleExpanded(fieldItem.row)
+                    }
+                    if (hexModel) {
+                        hexModel.setHighlight(fieldItem.offset, fieldItem.length)
+                    }
+                }
             }
         }
     }
-}
\ No newline at end of file
+}